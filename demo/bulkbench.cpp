@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/*
+
+ This compares the throughput of inserting rows one at a time with
+ tntdb::Connection::prepareBulkLoad, which uses COPY in PostgreSQL.
+
+ */
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cxxtools/log.h>
+#include <cxxtools/arg.h>
+#include <tntdb/connect.h>
+#include <tntdb/connection.h>
+#include <tntdb/statement.h>
+#include <tntdb/value.h>
+#include <tntdb/error.h>
+
+typedef std::chrono::steady_clock Clock;
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    cxxtools::Arg<unsigned> rows(argc, argv, 'n', 100000);
+
+    log_init();
+
+    std::string database = argc > 1 ? argv[1] : "sqlite:bulkbench.db";
+    tntdb::Connection conn = tntdb::connect(database);
+
+    try
+    {
+      conn.execute("drop table bulkbench");
+    }
+    catch (const tntdb::Error&)
+    {
+    }
+
+    conn.execute("create table bulkbench (id integer not null, name varchar(64), value double precision)");
+
+    std::vector<std::string> columns;
+    columns.push_back("id");
+    columns.push_back("name");
+    columns.push_back("value");
+
+    std::cout << "method\trows\ttime(ms)\trows/s" << std::endl;
+
+    for (unsigned method = 0; method < 2; ++method)
+    {
+      conn.execute("delete from bulkbench");
+
+      Clock::time_point start = Clock::now();
+
+      tntdb::Statement ins = method == 0
+        ? conn.prepare("insert into bulkbench (id, name, value) values (:id, :name, :value)")
+        : conn.prepareBulkLoad("bulkbench", columns);
+
+      for (unsigned n = 0; n < rows; ++n)
+        ins.set("id", n)
+           .set("name", "row")
+           .set("value", n * 0.5)
+           .execute();
+      ins.flush();
+
+      double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+      unsigned count = conn.selectValue("select count(*) from bulkbench").getUnsigned();
+
+      std::cout << (method == 0 ? "insert" : "bulkload") << '\t'
+                << count << '\t'
+                << ms << '\t'
+                << count / ms * 1000 << std::endl;
+    }
+
+    conn.execute("drop table bulkbench");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+  }
+}
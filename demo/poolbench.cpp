@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/*
+
+ This measures the latency of checking out and returning connections of a
+ tntdb::ConnectionPool with a varying number of threads.
+
+ */
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cxxtools/log.h>
+#include <cxxtools/arg.h>
+#include <tntdb/connectionpool.h>
+#include <tntdb/connection.h>
+
+typedef std::chrono::steady_clock Clock;
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    cxxtools::Arg<unsigned> iterations(argc, argv, 'n', 10000);
+    cxxtools::Arg<unsigned> shards(argc, argv, 's', 0);
+    cxxtools::Arg<unsigned> maxActive(argc, argv, 'a', 0);
+
+    log_init();
+
+    std::string database = argc > 1 ? argv[1] : "sqlite:poolbench.db";
+
+    std::cout << "threads\tcheckouts\tavg(us)\tp99(us)\tmax(us)\tconnections\twaits" << std::endl;
+
+    static const unsigned threadCounts[] = { 1, 8, 64, 256 };
+    for (unsigned threadCount : threadCounts)
+    {
+      tntdb::ConnectionPool pool(database, std::string(), std::string(), 0, shards);
+      pool.setMaxActive(maxActive);
+      std::vector<std::vector<double>> latencies(threadCount);
+      std::vector<std::thread> threads;
+
+      for (unsigned t = 0; t < threadCount; ++t)
+        threads.emplace_back([&pool, &latencies, &iterations, t] () {
+          std::vector<double>& l = latencies[t];
+          l.reserve(iterations);
+          for (unsigned n = 0; n < iterations; ++n)
+          {
+            Clock::time_point start = Clock::now();
+            tntdb::Connection conn = pool.connect();
+            conn.close();
+            l.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+          }
+        });
+
+      for (auto& thread : threads)
+        thread.join();
+
+      std::vector<double> all;
+      for (auto& l : latencies)
+        all.insert(all.end(), l.begin(), l.end());
+      std::sort(all.begin(), all.end());
+
+      double sum = 0;
+      for (double v : all)
+        sum += v;
+
+      std::cout << threadCount << '\t'
+                << all.size() << '\t'
+                << sum / all.size() << '\t'
+                << all[all.size() * 99 / 100] << '\t'
+                << all.back() << '\t'
+                << pool.getCurrentSize() << '\t'
+                << pool.getWaitStatistics().waits << std::endl;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+  }
+}
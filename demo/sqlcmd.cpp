@@ -34,7 +34,6 @@
 #include <cxxtools/arg.h>
 
 #include <tntdb/connect.h>
-#include <tntdb/transaction.h>
 #include <tntdb/value.h>
 #include <tntdb/row.h>
 #include <tntdb/result.h>
@@ -108,10 +107,9 @@ int main(int argc, char* argv[])
     }
     else if (cursor)
     {
-      // postgresql needs a active transaction for cursors
-      tntdb::Transaction trans(conn);
-
+      // a streaming cursor needs no transaction in postgresql
       tntdb::Statement stmt = conn.prepare(cmd);
+      stmt.setStreaming();
       std::for_each(stmt.begin(), stmt.end(), RowPrinter());
     }
     else
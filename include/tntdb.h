@@ -30,6 +30,7 @@
 #define TNTDB_H
 
 #include <tntdb/blob.h>
+#include <tntdb/columnindex.h>
 #include <tntdb/connect.h>
 #include <tntdb/connection.h>
 #include <tntdb/connectionpool.h>
@@ -38,6 +39,7 @@
 #include <tntdb/decimal.h>
 #include <tntdb/error.h>
 #include <tntdb/librarymanager.h>
+#include <tntdb/param.h>
 #include <tntdb/result.h>
 #include <tntdb/row.h>
 #include <tntdb/statement.h>
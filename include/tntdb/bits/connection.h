@@ -33,6 +33,9 @@
 #include <tntdb/bits/statement.h>
 #include <string>
 #include <memory>
+#include <vector>
+#include <functional>
+#include <iosfwd>
 
 namespace tntdb
 {
@@ -135,6 +138,47 @@ public:
      */
     Statement prepareWithLimit(const std::string& query, const std::string& limit, const std::string& offset = std::string());
 
+    /** Create a Statement, which loads rows into a table
+
+        The columns are the host variables of the statement. Each execute
+        adds a row and flush finishes the load and returns the number of
+        rows loaded since the last flush. Drivers use their fastest way to
+        insert many rows, e.g. COPY in PostgreSQL or LOAD DATA LOCAL INFILE
+        in MySQL, when it is enabled with the option `local_infile=1` and
+        the server allows it. Otherwise an insert statement with delayed
+        execution is used, which sends the rows in multi row inserts where
+        possible.
+
+        The rows are flushed automatically after `maxNumDelay` rows and when
+        the statement is destroyed. The connection should not be used for
+        other statements until the load is flushed.
+     */
+    Statement prepareBulkLoad(const std::string& table, const std::vector<std::string>& columns);
+
+    /** Export the result of a query to a stream
+
+        The rows are written in the text format of PostgreSQL COPY: the
+        values are separated by tabs, each row ends with a newline, null
+        is written as `\N` and backslash, tab, newline and carriage return
+        are escaped with a backslash. The rows are streamed, so that the
+        memory usage does not depend on the size of the result. PostgreSQL
+        uses `COPY (query) TO STDOUT`; other drivers read the rows with a
+        cursor.
+
+        Returns the number of exported rows.
+     */
+    size_type copyOut(const std::string& query, std::ostream& out);
+
+    /** Export the result of a query to a callback
+
+        Like copyOut, but each row is passed to the callback. The row may
+        be a view of a buffer of the driver, so it must not be used after
+        the callback returned.
+
+        Returns the number of exported rows.
+     */
+    size_type copyOutRows(const std::string& query, const std::function<void (const Row&)>& callback);
+
     /// Check whether the connection is alive
     bool ping()                        { return _conn->ping(); }
 
@@ -142,6 +186,35 @@ public:
     long lastInsertId(const std::string& name = std::string())
       { return _conn->lastInsertId(name); }
 
+    /** Start pipeline mode
+
+        In pipeline mode statements are sent to the server without waiting
+        for their results. Prepares, executions and also the commit of a
+        transaction are queued and the results are collected at the next
+        sync point, so that a sequence of statements needs just one round
+        trip. `execute` returns 0 for queued statements.
+
+        A select needs its result, so it syncs the pipeline.
+
+        Drivers, which do not support pipelining, execute the statements
+        immediately as without pipeline mode.
+     */
+    void beginPipeline()               { _conn->beginPipeline(); }
+
+    /** Wait for the results of all queued statements
+
+        Returns the number of rows affected by the queued statements. When
+        a statement failed, the error of that statement is thrown. The
+        following statements up to the sync point are not executed then.
+        Outside of an explicit transaction the statements between two sync
+        points are executed in one implicit transaction, which is rolled
+        back on error.
+     */
+    size_type syncPipeline()           { return _conn->syncPipeline(); }
+
+    /// Sync the pipeline and leave pipeline mode
+    void endPipeline()                 { _conn->endPipeline(); }
+
     /// Check if a connection is established (<b>true if not</b>)
     bool operator!() const             { return !_conn; }
 
@@ -31,6 +31,7 @@
 
 #include <tntdb/iface/irow.h>
 #include <tntdb/bits/value.h>
+#include <tntdb/columnindex.h>
 #include <tntdb/blob.h>
 #include <memory>
 
@@ -75,6 +76,12 @@ public:
     /// Returns the value-object by name.
     Value operator[] (const std::string& field_name) const
       { return _row->getValueByName(field_name); }
+    /// Returns the value-object of the column referenced by the index.
+    Value getValue(const ColumnIndex& idx) const
+      { return _row->getValueByNumber(idx.resolve(*_row)); }
+    /// Returns the value-object of the column referenced by the index.
+    Value operator[] (const ColumnIndex& idx) const
+      { return _row->getValueByNumber(idx.resolve(*_row)); }
     /// Returns the name of the field_num's column
     std::string getName(size_type field_num) const
       { return _row->getColumnName(field_num); }
@@ -85,6 +92,9 @@ public:
     /// Return true, if the specified value is null.
     bool isNull(const std::string& field_name) const
       { return getValue(field_name).isNull(); }
+    /// Return true, if the specified value is null.
+    bool isNull(const ColumnIndex& idx) const
+      { return getValue(idx).isNull(); }
 
     //@{
     /**
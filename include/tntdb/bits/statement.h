@@ -30,6 +30,8 @@
 #define TNTDB_BITS_STATEMENT_H
 
 #include <tntdb/iface/istatement.h>
+#include <tntdb/param.h>
+#include <tntdb/blob.h>
 #include <tntdb/serialization.h>
 #include <tntdb/date.h>
 #include <tntdb/time.h>
@@ -161,14 +163,46 @@ public:
       { data == 0 ? _stmt->setNull(col)
                   : _stmt->setString(col, data); return *this; }
 
+    /// Set the host variable with the given name to a string value, which the statement may take over
+    Statement& setString(const std::string& col, std::string&& data)
+      { _stmt->takeString(col, std::move(data)); return *this; }
+
     /// Set the host variable with the given name to a unicode string value
     Statement& setUString(const std::string& col, const cxxtools::String& data)
       { _stmt->setUString(col, data); return *this; }
 
+    /** Set the host variable with the given name to a string value without copying it
+
+        The driver may reference the data instead of copying it. The data
+        must stay valid and unchanged until the host variable is set to
+        another value or the statement is destroyed. Drivers, which can't
+        reference the data, copy it.
+     */
+    Statement& setStringRef(const std::string& col, const char* data, std::size_t length)
+      { _stmt->setStringRef(col, data, length); return *this; }
+
+    /// Set the host variable with the given name to a string value without copying it
+    Statement& setStringRef(const std::string& col, const std::string& data)
+      { _stmt->setStringRef(col, data.data(), data.size()); return *this; }
+
+    // A temporary does not live long enough to be referenced.
+    Statement& setStringRef(const std::string& col, std::string&& data) = delete;
+
     /// Set the host variable with the given name to a blob value
     Statement& setBlob(const std::string& col, const Blob& data)
       { _stmt->setBlob(col, data); return *this; }
 
+    /// Set the host variable with the given name to a blob value without copying it (see setStringRef)
+    Statement& setBlobRef(const std::string& col, const char* data, std::size_t length)
+      { _stmt->setBlobRef(col, data, length); return *this; }
+
+    /// Set the host variable with the given name to a blob value without copying it (see setStringRef)
+    Statement& setBlobRef(const std::string& col, const Blob& data)
+      { _stmt->setBlobRef(col, data.data(), data.size()); return *this; }
+
+    // A temporary does not live long enough to be referenced.
+    Statement& setBlobRef(const std::string& col, Blob&& data) = delete;
+
     /// Set the host variable with the given name to a date value
     Statement& setDate(const std::string& col, const Date& data)
       { data.isNull() ? _stmt->setNull(col)
@@ -193,6 +227,10 @@ public:
     template <typename T>
     Statement& set(const std::string& col, const T& data);
 
+    /// Set the host variable with the given name to a string value, which the statement may take over
+    Statement& set(const std::string& col, std::string&& data)
+      { return setString(col, std::move(data)); }
+
     /** Set multiple numbered parameters to the values specified by the iterator range
 
         The method expects, that the statement has columns with the specified column name
@@ -240,6 +278,187 @@ public:
         return *this;
     }
 
+    /** Resolve the host variable with the given name
+
+        The returned handle is passed to the setters instead of the name, so
+        that the name is not looked up on every call. It is valid only for
+        this statement. Throws HostvarNotFound, if the statement has no host
+        variable with that name.
+     */
+    Param param(const std::string& col) const;
+
+    /// Set the host variable to NULL
+    Statement& setNull(const Param& p)
+      { p.isResolved() ? _stmt->setNullAt(p.getIndex())
+                       : _stmt->setNull(p.getName()); return *this; }
+
+    /// Set the host variable to a boolean value
+    Statement& setBool(const Param& p, bool data)
+      { p.isResolved() ? _stmt->setBoolAt(p.getIndex(), data)
+                       : _stmt->setBool(p.getName(), data); return *this; }
+
+    /// Set the host variable to a short value
+    Statement& setShort(const Param& p, short data)
+      { p.isResolved() ? _stmt->setShortAt(p.getIndex(), data)
+                       : _stmt->setShort(p.getName(), data); return *this; }
+
+    /// Set the host variable to an int value
+    Statement& setInt(const Param& p, int data)
+      { p.isResolved() ? _stmt->setIntAt(p.getIndex(), data)
+                       : _stmt->setInt(p.getName(), data); return *this; }
+
+    /// Set the host variable to a long value
+    Statement& setLong(const Param& p, long data)
+      { p.isResolved() ? _stmt->setLongAt(p.getIndex(), data)
+                       : _stmt->setLong(p.getName(), data); return *this; }
+
+    /// Set the host variable to an unsigned short value
+    Statement& setUnsignedShort(const Param& p, unsigned short data)
+      { p.isResolved() ? _stmt->setUnsignedShortAt(p.getIndex(), data)
+                       : _stmt->setUnsignedShort(p.getName(), data); return *this; }
+
+    /// Set the host variable to an unsigned value
+    Statement& setUnsigned(const Param& p, unsigned data)
+      { p.isResolved() ? _stmt->setUnsignedAt(p.getIndex(), data)
+                       : _stmt->setUnsigned(p.getName(), data); return *this; }
+
+    /// Set the host variable to an unsigned long value
+    Statement& setUnsignedLong(const Param& p, unsigned long data)
+      { p.isResolved() ? _stmt->setUnsignedLongAt(p.getIndex(), data)
+                       : _stmt->setUnsignedLong(p.getName(), data); return *this; }
+
+    /// Set the host variable to a int32_t value
+    Statement& setInt32(const Param& p, int32_t data)
+      { p.isResolved() ? _stmt->setInt32At(p.getIndex(), data)
+                       : _stmt->setInt32(p.getName(), data); return *this; }
+
+    /// Set the host variable to a uint32_t value
+    Statement& setUnsigned32(const Param& p, uint32_t data)
+      { p.isResolved() ? _stmt->setUnsigned32At(p.getIndex(), data)
+                       : _stmt->setUnsigned32(p.getName(), data); return *this; }
+
+    /// Set the host variable to a int64_t value
+    Statement& setInt64(const Param& p, int64_t data)
+      { p.isResolved() ? _stmt->setInt64At(p.getIndex(), data)
+                       : _stmt->setInt64(p.getName(), data); return *this; }
+
+    /// Set the host variable to a uint64_t value
+    Statement& setUnsigned64(const Param& p, uint64_t data)
+      { p.isResolved() ? _stmt->setUnsigned64At(p.getIndex(), data)
+                       : _stmt->setUnsigned64(p.getName(), data); return *this; }
+
+    /// Set the host variable to a Decimal
+    Statement& setDecimal(const Param& p, const Decimal& data)
+      { p.isResolved() ? _stmt->setDecimalAt(p.getIndex(), data)
+                       : _stmt->setDecimal(p.getName(), data); return *this; }
+
+    /// Set the host variable to a float value
+    Statement& setFloat(const Param& p, float data)
+      { p.isResolved() ? _stmt->setFloatAt(p.getIndex(), data)
+                       : _stmt->setFloat(p.getName(), data); return *this; }
+
+    /// Set the host variable to a double value
+    Statement& setDouble(const Param& p, double data)
+      { p.isResolved() ? _stmt->setDoubleAt(p.getIndex(), data)
+                       : _stmt->setDouble(p.getName(), data); return *this; }
+
+    /// Set the host variable to a char value
+    Statement& setChar(const Param& p, char data)
+      { p.isResolved() ? _stmt->setCharAt(p.getIndex(), data)
+                       : _stmt->setChar(p.getName(), data); return *this; }
+
+    /// Set the host variable to a string value
+    Statement& setString(const Param& p, const std::string& data)
+      { p.isResolved() ? _stmt->setStringAt(p.getIndex(), data)
+                       : _stmt->setString(p.getName(), data); return *this; }
+
+    /// Set the host variable to a string value or null
+    Statement& setString(const Param& p, const char* data)
+      { data == 0 ? setNull(p) : setString(p, std::string(data)); return *this; }
+
+    /// Set the host variable to a string value, which the statement may take over
+    Statement& setString(const Param& p, std::string&& data)
+      { p.isResolved() ? _stmt->takeStringAt(p.getIndex(), std::move(data))
+                       : _stmt->takeString(p.getName(), std::move(data)); return *this; }
+
+    /// Set the host variable to a string value without copying it (see setStringRef)
+    Statement& setStringRef(const Param& p, const char* data, std::size_t length)
+      { p.isResolved() ? _stmt->setStringRefAt(p.getIndex(), data, length)
+                       : _stmt->setStringRef(p.getName(), data, length); return *this; }
+
+    /// Set the host variable to a string value without copying it (see setStringRef)
+    Statement& setStringRef(const Param& p, const std::string& data)
+      { return setStringRef(p, data.data(), data.size()); }
+
+    Statement& setStringRef(const Param& p, std::string&& data) = delete;
+
+    /// Set the host variable to a unicode string value
+    Statement& setUString(const Param& p, const cxxtools::String& data)
+      { p.isResolved() ? _stmt->setUStringAt(p.getIndex(), data)
+                       : _stmt->setUString(p.getName(), data); return *this; }
+
+    /// Set the host variable to a blob value
+    Statement& setBlob(const Param& p, const Blob& data)
+      { p.isResolved() ? _stmt->setBlobAt(p.getIndex(), data)
+                       : _stmt->setBlob(p.getName(), data); return *this; }
+
+    /// Set the host variable to a blob value without copying it (see setStringRef)
+    Statement& setBlobRef(const Param& p, const char* data, std::size_t length)
+      { p.isResolved() ? _stmt->setBlobRefAt(p.getIndex(), data, length)
+                       : _stmt->setBlobRef(p.getName(), data, length); return *this; }
+
+    /// Set the host variable to a blob value without copying it (see setStringRef)
+    Statement& setBlobRef(const Param& p, const Blob& data)
+      { return setBlobRef(p, data.data(), data.size()); }
+
+    Statement& setBlobRef(const Param& p, Blob&& data) = delete;
+
+    /// Set the host variable to a date value
+    Statement& setDate(const Param& p, const Date& data)
+      { if (data.isNull())
+            setNull(p);
+        else
+            p.isResolved() ? _stmt->setDateAt(p.getIndex(), data)
+                           : _stmt->setDate(p.getName(), data);
+        return *this; }
+
+    /// Set the host variable to a time value
+    Statement& setTime(const Param& p, const Time& data)
+      { if (data.isNull())
+            setNull(p);
+        else
+            p.isResolved() ? _stmt->setTimeAt(p.getIndex(), data)
+                           : _stmt->setTime(p.getName(), data);
+        return *this; }
+
+    /// Set the host variable to a datetime value
+    Statement& setDatetime(const Param& p, const Datetime& data)
+      { if (data.isNull())
+            setNull(p);
+        else
+            p.isResolved() ? _stmt->setDatetimeAt(p.getIndex(), data)
+                           : _stmt->setDatetime(p.getName(), data);
+        return *this; }
+
+    /// Set the host variable to the passed value using the operator<< like set by name
+    template <typename T>
+    Statement& set(const Param& p, const T& data);
+
+    /// Set the host variable to a string value, which the statement may take over
+    Statement& set(const Param& p, std::string&& data)
+      { return setString(p, std::move(data)); }
+
+    /// Set the host variable to the passed value or null
+    template <typename T>
+    Statement& setIf(const Param& p, bool notNull, const T& data)
+    {
+        if (notNull)
+            set(p, data);
+        else
+            setNull(p);
+        return *this;
+    }
+
     /// Statement execution methods
     /// @{
     /** Execute the query without returning the result
@@ -294,9 +513,18 @@ public:
 
     /** Sets a buffer for delayed execution of statements.
 
-        When the number if greater than 0 and the connection is in a
-        transaction, the execute method may delay the actual execution until
-        the buffer is full or flush is called.
+        When the number is greater than 0, the execute method may delay the
+        actual execution until the buffer is full or flush is called. The
+        drivers use this to send the pending statements in one batch. Since
+        the execution is delayed, execute returns 0 for delayed statements
+        and errors are reported by the call which executes the batch.
+        Pending statements are flushed when the statement is destroyed.
+        When the batch fails, its pending statements are discarded.
+
+        The sqlite driver executes delayed statements immediately in a
+        transaction, which is committed by the flush. Until then all other
+        statements executed on the connection run in that transaction too,
+        and a failing delayed statement rolls it back.
 
         The default is 0.
      */
@@ -307,6 +535,42 @@ public:
     /// Returns number of affected rows.
     size_type flush();
 
+    /** Enables streaming of results.
+
+        By default select reads the whole result set into memory. When
+        streaming is enabled, select returns a result, which fetches the
+        rows on demand from the running statement, so that the memory usage
+        does not depend on the number of rows. Reading the rows in forward
+        order is cheap. Going back or asking for the size may execute the
+        statement again. The result becomes invalid when the statement is
+        used again.
+
+        PostgreSQL streams cursors only: the rows of begin() are read
+        in single row mode from the running query instead of a server side
+        cursor, so that no transaction is needed. The connection can't be
+        used for other statements until all rows are read or the cursor is
+        released.
+
+        MySQL executes a streaming select with a read only server side
+        cursor and fetches setFetchSize() rows at a time. The connection
+        stays usable for other statements.
+
+        Drivers, which do not support streaming, ignore the setting.
+     */
+    void setStreaming(bool sw = true);
+    /// Returns true, if streaming of results is enabled.
+    bool isStreaming() const;
+
+    /** Sets the number of rows, which select fetches from the server at once.
+
+        MySQL reads streaming results with a server side cursor and fetches
+        this many rows per round trip. Drivers, which do not fetch in
+        blocks, ignore the setting.
+     */
+    void setFetchSize(unsigned n);
+    /// Returns the fetch size or 0, if the driver does not use one.
+    unsigned getFetchSize() const;
+
     /// @{
     /// Get the actual implementation object
     const IStatement* getImpl() const { return &*_stmt; }
@@ -314,67 +578,70 @@ public:
     /// @}
 };
 
-/// Helper class to hold a Statement and a column name
+/// Helper class to hold a Statement and a column name or resolved parameter
 class Hostvar
 {
 private:
     Statement& _stmt;
     const std::string& _name;
+    const Param* _param;
 
 public:
     Hostvar(Statement& stmt, const std::string& name)
       : _stmt(stmt),
-        _name(name)
+        _name(name),
+        _param(0)
+        { }
+    Hostvar(Statement& stmt, const Param& param)
+      : _stmt(stmt),
+        _name(param.getName()),
+        _param(&param)
         { }
     Statement& getStatement()    { return _stmt; }
     const std::string& getName() { return _name; }
 
     void setNull()
-      { _stmt.setNull(_name); }
+      { _param ? _stmt.setNull(*_param) : _stmt.setNull(_name); }
     void setBool(bool data)
-      { _stmt.setBool(_name, data); }
+      { _param ? _stmt.setBool(*_param, data) : _stmt.setBool(_name, data); }
     void setInt(int data)
-      { _stmt.setInt(_name, data); }
+      { _param ? _stmt.setInt(*_param, data) : _stmt.setInt(_name, data); }
     void setLong(long data)
-      { _stmt.setLong(_name, data); }
+      { _param ? _stmt.setLong(*_param, data) : _stmt.setLong(_name, data); }
     void setUnsigned(unsigned data)
-      { _stmt.setUnsigned(_name, data); }
+      { _param ? _stmt.setUnsigned(*_param, data) : _stmt.setUnsigned(_name, data); }
     void setUnsignedLong(unsigned long data)
-      { _stmt.setUnsignedLong(_name, data); }
+      { _param ? _stmt.setUnsignedLong(*_param, data) : _stmt.setUnsignedLong(_name, data); }
     void setInt32(int32_t data)
-      { _stmt.setInt32(_name, data); }
+      { _param ? _stmt.setInt32(*_param, data) : _stmt.setInt32(_name, data); }
     void setUnsigned32(uint32_t data)
-      { _stmt.setUnsigned32(_name, data); }
+      { _param ? _stmt.setUnsigned32(*_param, data) : _stmt.setUnsigned32(_name, data); }
     void setInt64(int64_t data)
-      { _stmt.setInt64(_name, data); }
+      { _param ? _stmt.setInt64(*_param, data) : _stmt.setInt64(_name, data); }
     void setUnsigned64(uint64_t data)
-      { _stmt.setUnsigned64(_name, data); }
+      { _param ? _stmt.setUnsigned64(*_param, data) : _stmt.setUnsigned64(_name, data); }
     void setDecimal(const Decimal& data)
-      { _stmt.setDecimal(_name, data); }
+      { _param ? _stmt.setDecimal(*_param, data) : _stmt.setDecimal(_name, data); }
     void setFloat(float data)
-      { _stmt.setFloat(_name, data); }
+      { _param ? _stmt.setFloat(*_param, data) : _stmt.setFloat(_name, data); }
     void setDouble(double data)
-      { _stmt.setDouble(_name, data); }
+      { _param ? _stmt.setDouble(*_param, data) : _stmt.setDouble(_name, data); }
     void setChar(char data)
-      { _stmt.setChar(_name, data); }
+      { _param ? _stmt.setChar(*_param, data) : _stmt.setChar(_name, data); }
     void setString(const std::string& data)
-      { _stmt.setString(_name, data); }
+      { _param ? _stmt.setString(*_param, data) : _stmt.setString(_name, data); }
     void setString(const char* data)
-      { data == 0 ? _stmt.setNull(_name)
-                  : _stmt.setString(_name, data); }
+      { _param ? _stmt.setString(*_param, data) : _stmt.setString(_name, data); }
     void setUString(const cxxtools::String& data)
-      { _stmt.setUString(_name, data); }
+      { _param ? _stmt.setUString(*_param, data) : _stmt.setUString(_name, data); }
     void setBlob(const Blob& data)
-      { _stmt.setBlob(_name, data); }
+      { _param ? _stmt.setBlob(*_param, data) : _stmt.setBlob(_name, data); }
     void setDate(const Date& data)
-      { data.isNull() ? _stmt.setNull(_name)
-                      : _stmt.setDate(_name, data); }
+      { _param ? _stmt.setDate(*_param, data) : _stmt.setDate(_name, data); }
     void setTime(const Time& data)
-      { data.isNull() ? _stmt.setNull(_name)
-                      : _stmt.setTime(_name, data); }
+      { _param ? _stmt.setTime(*_param, data) : _stmt.setTime(_name, data); }
     void setDatetime(const Datetime& data)
-      { data.isNull() ? _stmt.setNull(_name)
-                      : _stmt.setDatetime(_name, data); }
+      { _param ? _stmt.setDatetime(*_param, data) : _stmt.setDatetime(_name, data); }
 
     template <typename T>
     void set(const T& data);
@@ -486,6 +753,14 @@ Statement& Statement::set(const std::string& name, const T& data)
   return *this;
 }
 
+template <typename T>
+Statement& Statement::set(const Param& p, const T& data)
+{
+  Hostvar h(*this, p);
+  h << data;
+  return *this;
+}
+
 template <typename Iterator>
 Statement& Statement::set(const std::string& col, Iterator it1, Iterator it2)
 {
@@ -35,9 +35,11 @@
 #include <tntdb/datetime.h>
 #include <tntdb/decimal.h>
 #include <tntdb/blob.h>
+#include <tntdb/error.h>
 #include <memory>
 #if __cplusplus >= 201703L
 #include <optional>
+#include <string_view>
 #endif
 
 
@@ -117,6 +119,29 @@ public:
     /// Returns the value as a blob.
     void getBlob(Blob& blob) const
       { _value->getBlob(blob); }
+    /** Returns the string data of the value without copying it.
+
+        The length of the data is stored in \a length. The data is owned by
+        the driver and valid as long as the row of the value. Rows read
+        with a cursor are valid until the cursor moves on. A TypeError is
+        thrown, when the driver has the value in another representation,
+        e.g. integers in binary format. getString converts these.
+     */
+    const char* getStringData(std::size_t& length) const
+      { if (!_value) throw NullValue(); return _value->getStringData(length); }
+    /// Returns the blob data of the value without copying it (see getStringData).
+    const char* getBlobData(std::size_t& length) const
+      { if (!_value) throw NullValue(); return _value->getBlobData(length); }
+#if __cplusplus >= 201703L
+    /// Returns a view of the string data of the value (see getStringData).
+    std::string_view getStringView() const
+      { std::size_t length; const char* data = getStringData(length);
+        return std::string_view(data, length); }
+    /// Returns a view of the blob data of the value (see getStringData).
+    std::string_view getBlobView() const
+      { std::size_t length; const char* data = getBlobData(length);
+        return std::string_view(data, length); }
+#endif
     /// returns the value as a Date.
     Date getDate() const                { return _value->getDate(); }
     /// returns the value as a Time.
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_COLUMNINDEX_H
+#define TNTDB_COLUMNINDEX_H
+
+#include <string>
+#include <stdint.h>
+
+namespace tntdb
+{
+class IRow;
+
+/**
+ * A ColumnIndex accesses a column of a row by name without looking up the
+ * name on every access.
+ *
+ * The column number is resolved on first use and cached. It is reused for
+ * all rows sharing the same column layout, which is normally the case for
+ * all rows of a result. Drivers, which can't tell, whether rows share the
+ * layout, look up the name each time.
+ *
+ * Example:
+ * \code
+ *   tntdb::ColumnIndex name("name");
+ *   for (tntdb::Result::const_iterator it = result.begin(); it != result.end(); ++it)
+ *     std::cout << (*it)[name].getString() << std::endl;
+ * \endcode
+ *
+ * The cache is not synchronized, so a ColumnIndex should not be used by
+ * multiple threads concurrently.
+ */
+class ColumnIndex
+{
+    std::string _name;
+    mutable uint64_t _schemaId;
+    mutable unsigned _fieldNum;
+
+public:
+    explicit ColumnIndex(const std::string& name)
+      : _name(name),
+        _schemaId(0),
+        _fieldNum(0)
+      { }
+
+    explicit ColumnIndex(const char* name)
+      : _name(name),
+        _schemaId(0),
+        _fieldNum(0)
+      { }
+
+    /// Returns the name of the column.
+    const std::string& getName() const   { return _name; }
+
+    /// Returns the number of the column in the passed row.
+    /// Throws tntdb::FieldNotFound, if the row has no such column.
+    unsigned resolve(const IRow& row) const;
+};
+}
+
+#endif // TNTDB_COLUMNINDEX_H
@@ -31,6 +31,7 @@
 
 #include <string>
 #include <tntdb/connection.h>
+#include <tntdb/connectionpool.h>
 
 namespace tntdb
 {
@@ -112,6 +113,50 @@ void setMaxPoolSize(unsigned max);
 
 /// Get the current setting for maximum pool size (see setMaxPoolSize())
 unsigned getMaxPoolSize();
+
+/** Set the maximum number of open cached connections per database
+
+    When the limit is reached, connectCached waits until a connection is
+    released. 0 means unlimited.
+ */
+void setPoolMaxActive(unsigned n);
+
+/// Set the time in milliseconds connectCached waits for a connection before PoolTimeout is thrown; 0 means forever
+void setPoolCheckoutTimeout(unsigned ms);
+
+/// Set the number of idle connections the maintenance thread keeps open per database
+void setPoolMinIdle(unsigned n);
+
+/// Set the maximum age of cached connections in milliseconds; 0 means unlimited
+void setPoolMaxLifetime(unsigned ms);
+
+/// Set the time in milliseconds after which idle cached connections are closed; 0 means never
+void setPoolIdleTimeout(unsigned ms);
+
+/** Start a background thread, which maintains the cached connections
+
+    Every `intervalMs` milliseconds the thread closes connections exceeding
+    the maximum lifetime or idle timeout and opens new connections until
+    the minimum number of idle connections is reached.
+ */
+void startPoolMaintenance(unsigned intervalMs = 1000);
+
+/// Stop the background thread started with startPoolMaintenance()
+void stopPoolMaintenance();
+
+/** Set when cached connections are checked before they are returned by connectCached
+
+    See ConnectionPool::ValidationPolicy. The interval is used by
+    ConnectionPool::validateIdle.
+ */
+void setPoolValidationPolicy(ConnectionPool::ValidationPolicy policy, unsigned intervalMs = 0);
+
+/** Check all cached connections and drop the dead ones
+
+    This is used with ConnectionPool::validateBackground and should be called
+    periodically. Returns the number of connections dropped.
+ */
+unsigned validateCached();
 }
 
 #endif // TNTDB_CONNECT_H
@@ -30,48 +30,242 @@
 #define TNTDB_CONNECTIONPOOL_H
 
 #include <map>
+#include <deque>
 #include <string>
 #include <vector>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
 
 namespace tntdb
 {
 class Connection;
 class IConnection;
+class StatementCache;
 
+/** A pool of idle connections to one database
+
+    The idle connections are distributed over a number of shards, each with
+    its own mutex. A thread takes and returns connections from and to the
+    shard selected by its thread id and looks into the other shards only
+    when its own shard is empty. No lock is held while a connection is
+    checked or a new connection is established.
+
+    Optionally the number of open connections is limited by `maxActive`.
+    When the limit is reached, connect() waits in a FIFO queue until a
+    connection is released. Released connections are handed off directly
+    to the thread waiting longest.
+ */
 class ConnectionPool
 {
     friend class PoolConnection;
 
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /** Specifies when a pooled connection is checked with ping() before it is handed out
+
+        Connections found dead are dropped.
+     */
+    enum ValidationPolicy
+    {
+        validateAlways,      ///< on every checkout (default)
+        validateNever,       ///< never
+        validateIdle,        ///< when it was idle longer than the validation interval
+        validateAfterError,  ///< when an error occurred during its last use
+        validateBackground   ///< only in validate(), which is called periodically
+    };
+
+    /** Statistics of checkouts while `maxActive` is set
+
+        The histogram counts the checkouts, which had to wait, by waiting
+        time. Bucket n contains the waits shorter than bucketLimits[n]
+        milliseconds; the last bucket contains the longer ones.
+     */
+    struct WaitStatistics
+    {
+        static const unsigned buckets = 13;
+        static const unsigned bucketLimits[buckets - 1];
+
+        unsigned long checkouts;
+        unsigned long waits;
+        unsigned long timeouts;
+        unsigned long histogram[buckets];
+
+        WaitStatistics()
+          : checkouts(0),
+            waits(0),
+            timeouts(0),
+            histogram()
+          { }
+    };
+
+private:
+    struct IdleConnection
+    {
+        std::shared_ptr<IConnection> connection;
+        // The cached statements reference the connection, so the cache is
+        // declared after it to be destroyed first.
+        std::shared_ptr<StatementCache> statementCache;
+        Clock::time_point created;
+        Clock::time_point lastUsed;
+        // Set, when an error was seen. It is shared with the statements of
+        // the connection, which may be cached beyond one checkout.
+        std::shared_ptr<bool> suspect;
+
+        IdleConnection()
+          { }
+        IdleConnection(const std::shared_ptr<IConnection>& connection_, const std::shared_ptr<StatementCache>& statementCache_,
+                       Clock::time_point created_, Clock::time_point lastUsed_, const std::shared_ptr<bool>& suspect_)
+          : connection(connection_),
+            statementCache(statementCache_),
+            created(created_),
+            lastUsed(lastUsed_),
+            suspect(suspect_)
+          { }
+
+        void reset()
+        {
+            statementCache.reset();
+            connection.reset();
+            suspect.reset();
+        }
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::vector<IdleConnection> connections;
+    };
+
+    struct Waiter
+    {
+        std::condition_variable condition;
+        IdleConnection conn;  // handed off connection; empty when a new one may be opened
+        bool ready;
+
+        Waiter()
+          : ready(false)
+          { }
+    };
+
     std::string _url;
     std::string _username;
     std::string _password;
-    mutable std::mutex _mutex;
 
-    std::vector<std::shared_ptr<IConnection>> _connectionPool;
-    unsigned _maxSpare;
-    void put(std::shared_ptr<IConnection>& conn);
+    std::vector<std::unique_ptr<Shard>> _shards;
+    std::atomic<unsigned> _currentSize;
+    std::atomic<unsigned> _maxSpare;
+    std::atomic<ValidationPolicy> _validationPolicy;
+    std::atomic<unsigned> _validationInterval;
+    std::atomic<unsigned long> _checkoutValidations;
+    std::atomic<unsigned> _minIdle;
+    std::atomic<unsigned> _maxLifetime;
+    std::atomic<unsigned> _idleTimeout;
+
+    // checked out connections including those currently being opened
+    std::atomic<unsigned> _activeCount;
+    std::atomic<unsigned> _maxActive;
+    std::atomic<unsigned> _checkoutTimeout;
+    std::mutex _waitMutex;
+    std::deque<Waiter*> _waiters;
+    WaitStatistics _waitStatistics;
+
+    std::size_t shardIndex() const;
+    bool take(IdleConnection& conn);
+    bool checkout(IdleConnection& conn);
+    bool reserve();
+    bool handOff(IdleConnection& conn);
+    void store(IdleConnection& conn);
+    bool needsValidation(const IdleConnection& conn, Clock::time_point now) const;
+    bool expired(Clock::time_point created, Clock::time_point now) const;
+    void put(std::shared_ptr<IConnection>& conn, std::shared_ptr<StatementCache>& statementCache, Clock::time_point created, const std::shared_ptr<bool>& suspect);
+    void discard();
+    // Gives a connection, which counts as active, to the oldest waiting
+    // thread or back to the pool; an empty connection just frees its slot.
+    void release(IdleConnection& conn);
+    // Lets waiting threads open new connections while slots are free.
+    void wakeWaiters();
 
     ConnectionPool(const ConnectionPool&) = delete;
     ConnectionPool& operator=(const ConnectionPool&) = delete;
 
 public:
-    explicit ConnectionPool(const std::string& url, const std::string& username, const std::string& password, unsigned maxSpare = 0)
-        : _url(url),
-          _username(username),
-          _password(password),
-          _maxSpare(maxSpare)
-        { }
+    /** Creates a pool for the given database url.
 
+        The number of shards defaults to the number of hardware threads.
+     */
+    explicit ConnectionPool(const std::string& url, const std::string& username, const std::string& password, unsigned maxSpare = 0, unsigned shards = 0);
+
+    /** Returns a connection from the pool or opens a new one.
+
+        When `maxActive` connections are open, this waits for a connection to
+        be released and throws PoolTimeout after the checkout timeout.
+     */
     Connection connect();
 
     /// Release unused connections; keep the given number of connections
     void drop(unsigned keep = 0);
 
+    /** Checks all idle connections with ping() and drops the dead ones.
+
+        Returns the number of connections dropped.
+     */
+    unsigned validate();
+
+    /** Retires and refills idle connections.
+
+        Connections older than the maximum lifetime are closed. Connections
+        idle longer than the idle timeout are closed as long as more than
+        `minIdle` connections are left. With validateBackground the
+        remaining connections are validated. Finally new connections are
+        opened until `minIdle` connections are available.
+
+        This is called periodically by the maintenance thread of
+        ConnectionPools. Returns the number of connections closed.
+     */
+    unsigned maintain();
+
     unsigned getMaxSpare() const    { return _maxSpare; }
     void setMaxSpare(unsigned m);
-    unsigned getCurrentSize() const { return _connectionPool.size(); }
+    unsigned getCurrentSize() const { return _currentSize; }
+    unsigned getShardCount() const  { return _shards.size(); }
+
+    /// Returns the number of checked out connections
+    unsigned getActiveCount() const { return _activeCount; }
+
+    /// Returns the maximum number of open connections; 0 means unlimited
+    unsigned getMaxActive() const   { return _maxActive; }
+    void setMaxActive(unsigned n);
+
+    /// Returns the time in milliseconds connect() waits for a connection; 0 means forever
+    unsigned getCheckoutTimeout() const     { return _checkoutTimeout; }
+    void setCheckoutTimeout(unsigned ms)    { _checkoutTimeout = ms; }
+
+    WaitStatistics getWaitStatistics();
+    void resetWaitStatistics();
+
+    ValidationPolicy getValidationPolicy() const   { return _validationPolicy; }
+    /// Returns the idle time in milliseconds used by validateIdle
+    unsigned getValidationInterval() const         { return _validationInterval; }
+    void setValidationPolicy(ValidationPolicy policy, unsigned intervalMs = 0);
+    /// Returns the number of connections checked with ping() in connect()
+    unsigned long getCheckoutValidations() const   { return _checkoutValidations; }
+
+    /// Returns the number of idle connections maintain() keeps open
+    unsigned getMinIdle() const                    { return _minIdle; }
+    void setMinIdle(unsigned n)                    { _minIdle = n; }
+
+    /// Returns the maximum age of a connection in milliseconds; 0 means unlimited
+    unsigned getMaxLifetime() const                { return _maxLifetime; }
+    void setMaxLifetime(unsigned ms)               { _maxLifetime = ms; }
+
+    /// Returns the time in milliseconds after which maintain() closes idle connections; 0 means never
+    unsigned getIdleTimeout() const                { return _idleTimeout; }
+    void setIdleTimeout(unsigned ms)               { _idleTimeout = ms; }
 };
 
 class ConnectionPools
@@ -110,18 +304,46 @@ public:
     };
 
     typedef ConnectionPool PoolType;
-    typedef std::map<ConnectionParameter, std::unique_ptr<PoolType>> PoolsType;
+    typedef std::map<ConnectionParameter, std::shared_ptr<PoolType>> PoolsType;
 
 private:
     PoolsType _pools;
     unsigned _maxcount;
+    PoolType::ValidationPolicy _validationPolicy;
+    unsigned _validationInterval;
+    unsigned _minIdle;
+    unsigned _maxLifetime;
+    unsigned _idleTimeout;
+    unsigned _maxActive;
+    unsigned _checkoutTimeout;
     mutable std::mutex _mutex;
 
+    std::thread _maintenanceThread;
+    std::condition_variable _maintenanceCondition;
+    unsigned _maintenanceInterval;
+    bool _maintenanceRequested;
+    bool _maintenanceStop;
+
+    std::vector<std::shared_ptr<PoolType>> pools() const;
+    void runMaintenance();
+
 public:
     explicit ConnectionPools(unsigned maxcount = 0)
-      : _maxcount(maxcount)
+      : _maxcount(maxcount),
+        _validationPolicy(PoolType::validateAlways),
+        _validationInterval(0),
+        _minIdle(0),
+        _maxLifetime(0),
+        _idleTimeout(0),
+        _maxActive(0),
+        _checkoutTimeout(0),
+        _maintenanceInterval(0),
+        _maintenanceRequested(false),
+        _maintenanceStop(false)
       { }
 
+    ~ConnectionPools();
+
     Connection connect(const std::string& url, const std::string& username, const std::string& password);
 
     /// Release unused connections per pool; keep the given number of connections
@@ -136,6 +358,41 @@ public:
         { return _maxcount; }
 
     void setMaxSpare(unsigned m);
+
+    /// Sets the maximum number of open connections per pool; 0 means unlimited
+    void setMaxActive(unsigned n);
+
+    /// Sets the time in milliseconds connect() waits for a connection; 0 means forever
+    void setCheckoutTimeout(unsigned ms);
+
+    /// Sets the number of idle connections the maintenance thread keeps open per pool
+    void setMinIdle(unsigned n);
+
+    /// Sets the maximum age of connections in milliseconds; 0 means unlimited
+    void setMaxLifetime(unsigned ms);
+
+    /// Sets the time in milliseconds after which idle connections are closed; 0 means never
+    void setIdleTimeout(unsigned ms);
+
+    /** Starts a thread, which calls maintain() every `intervalMs` milliseconds.
+
+        The thread is also woken up, when a pool falls below its minimum
+        number of idle connections, so that it is refilled asynchronously.
+     */
+    void startMaintenance(unsigned intervalMs = 1000);
+
+    /// Stops the maintenance thread; this is done in the destructor too
+    void stopMaintenance();
+
+    /// Runs ConnectionPool::maintain() on all pools; returns the number of closed connections
+    unsigned maintain();
+
+    /// Sets the validation policy of all current and future pools
+    void setValidationPolicy(PoolType::ValidationPolicy policy, unsigned intervalMs = 0);
+
+    /// Validates the idle connections of all pools; returns the number of dropped connections
+    unsigned validate();
+
     unsigned getCurrentSize(const std::string& url, const std::string& username, const std::string& password) const;
     unsigned getCurrentSize() const;
 };
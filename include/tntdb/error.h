@@ -100,6 +100,13 @@ public:
 
     const std::string& getHostvar() const { return _hostvar; }
 };
+
+/// Exception thrown when no pooled connection becomes available within the checkout timeout
+class PoolTimeout : public Error
+{
+public:
+    PoolTimeout();
+};
 }
 
 #endif // TNTDB_ERROR_H
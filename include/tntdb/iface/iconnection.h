@@ -31,6 +31,10 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <functional>
+#include <iosfwd>
+#include <chrono>
 
 namespace tntdb
 {
@@ -38,6 +42,7 @@ class Result;
 class Row;
 class Value;
 class Statement;
+class StatementCache;
 
 class IConnection
 {
@@ -65,6 +70,25 @@ public:
     virtual long lastInsertId(const std::string& name) = 0;
     virtual void lockTable(const std::string& tablename, bool exclusive) = 0;
 
+    // Pipelining is optional. The default implementation executes all
+    // statements immediately.
+    virtual void beginPipeline();
+    virtual size_type syncPipeline();
+    virtual void endPipeline();
+
+    // The default bulk load is a prepared insert with delayed execution.
+    virtual Statement prepareBulkLoad(const std::string& table, const std::vector<std::string>& columns);
+
+    // Export of query results. The default implementation reads the rows
+    // with a cursor and writes them in the text format of PostgreSQL COPY.
+    virtual size_type copyOut(const std::string& query, std::ostream& out);
+    virtual size_type copyOutRows(const std::string& query, const std::function<void (const Row&)>& callback);
+
+    // Returns a statement cache, which lives as long as the connection, or
+    // 0, when the connection has none. Pooled connections keep their cache
+    // across checkouts; the limits are applied, when the cache is created.
+    virtual StatementCache* getStatementCache(unsigned maxSize, std::chrono::milliseconds maxAge);
+
     // helper function, which replaces '%u' with username and '%p' with password in url
     static std::string url(const std::string& url, const std::string& username, const std::string& password);
 };
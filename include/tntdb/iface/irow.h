@@ -34,6 +34,7 @@
 namespace tntdb
 {
 class Value;
+class ResultSchema;
 
 /// common interface for row-types
 class IRow
@@ -52,6 +53,14 @@ public:
     virtual Value getValueByNumber(size_type field_num) const = 0;
     virtual Value getValueByName(const std::string& field_name) const = 0;
     virtual std::string getColumnName(size_type field_num) const = 0;
+
+    /// Returns the number of the column with the passed name.
+    /// The default implementation compares the names of all columns.
+    virtual size_type getFieldNumber(const std::string& field_name) const;
+
+    /// Returns the schema shared by all rows of a result or a null pointer,
+    /// if the row has no shared schema.
+    virtual const ResultSchema* getSchema() const;
 };
 }
 
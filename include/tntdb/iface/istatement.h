@@ -32,6 +32,7 @@
 #include <cxxtools/string.h>
 #include <string>
 #include <memory>
+#include <cstddef>
 #include <stdint.h>
 
 namespace tntdb
@@ -58,6 +59,9 @@ protected:
 public:
     typedef unsigned size_type;
 
+    /// Returned by paramIndex, when the driver binds host variables by name only.
+    static const size_type noParam = static_cast<size_type>(-1);
+
     virtual void clear() = 0;
 
     virtual void setNull(const std::string& col) = 0;
@@ -83,6 +87,46 @@ public:
     virtual void setDatetime(const std::string& col, const Datetime& data) = 0;
     virtual void setUString(const std::string& col, const cxxtools::String& data);
 
+    // Host variables resolved to a number. paramIndex throws
+    // HostvarNotFound for unknown names. The default returns noParam and the
+    // setters by number are not used then.
+    virtual size_type paramIndex(const std::string& col);
+    virtual void setNullAt(size_type idx);
+    virtual void setBoolAt(size_type idx, bool data);
+    virtual void setShortAt(size_type idx, short data);
+    virtual void setIntAt(size_type idx, int data);
+    virtual void setLongAt(size_type idx, long data);
+    virtual void setUnsignedShortAt(size_type idx, unsigned short data);
+    virtual void setUnsignedAt(size_type idx, unsigned data);
+    virtual void setUnsignedLongAt(size_type idx, unsigned long data);
+    virtual void setInt32At(size_type idx, int32_t data);
+    virtual void setUnsigned32At(size_type idx, uint32_t data);
+    virtual void setInt64At(size_type idx, int64_t data);
+    virtual void setUnsigned64At(size_type idx, uint64_t data);
+    virtual void setDecimalAt(size_type idx, const Decimal& data);
+    virtual void setFloatAt(size_type idx, float data);
+    virtual void setDoubleAt(size_type idx, double data);
+    virtual void setCharAt(size_type idx, char data);
+    virtual void setStringAt(size_type idx, const std::string& data);
+    virtual void setBlobAt(size_type idx, const Blob& data);
+    virtual void setDateAt(size_type idx, const Date& data);
+    virtual void setTimeAt(size_type idx, const Time& data);
+    virtual void setDatetimeAt(size_type idx, const Datetime& data);
+    virtual void setUStringAt(size_type idx, const cxxtools::String& data);
+
+    // String and blob data, which is referenced instead of copied. The data
+    // must stay valid and unchanged until the host variable is set again or
+    // the statement is destroyed. The defaults copy the data.
+    virtual void setStringRef(const std::string& col, const char* data, std::size_t length);
+    virtual void setBlobRef(const std::string& col, const char* data, std::size_t length);
+    virtual void setStringRefAt(size_type idx, const char* data, std::size_t length);
+    virtual void setBlobRefAt(size_type idx, const char* data, std::size_t length);
+
+    // A string value, which the statement may take over instead of copying
+    // it. The defaults copy the data.
+    virtual void takeString(const std::string& col, std::string&& data);
+    virtual void takeStringAt(size_type idx, std::string&& data);
+
     virtual size_type execute() = 0;
     virtual Result select() = 0;
     virtual Row selectRow() = 0;
@@ -92,6 +136,11 @@ public:
     virtual void maxNumDelay(size_type n);
     virtual size_type numDelayed() const;
     virtual size_type flush();
+
+    virtual void setStreaming(bool sw);
+    virtual bool isStreaming() const;
+    virtual void setFetchSize(unsigned n);
+    virtual unsigned getFetchSize() const;
 };
 }
 
@@ -32,6 +32,7 @@
 #include <cxxtools/refcounted.h>
 #include <cxxtools/string.h>
 #include <string>
+#include <cstddef>
 #include <stdint.h>
 
 namespace tntdb
@@ -75,6 +76,13 @@ public:
     virtual Time getTime() const = 0;
     virtual Datetime getDatetime() const = 0;
     virtual void getUString(cxxtools::String& ret) const;
+
+    // Return the data of the value without copying it and store its length.
+    // The data is owned by the driver. Throws NullValue for null values and
+    // TypeError, when the value has no such representation without
+    // conversion, which is the default.
+    virtual const char* getStringData(std::size_t& length) const;
+    virtual const char* getBlobData(std::size_t& length) const;
 };
 }
 
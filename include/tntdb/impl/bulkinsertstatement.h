@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_IMPL_BULKINSERTSTATEMENT_H
+#define TNTDB_IMPL_BULKINSERTSTATEMENT_H
+
+#include <tntdb/impl/forwardstatement.h>
+#include <map>
+#include <vector>
+
+namespace tntdb
+{
+/// Insert statement used by the generic IConnection::prepareBulkLoad.
+///
+/// The host variables are named c0, c1, ..., since column names need not
+/// be valid host variable names. The setters map the column names to them.
+class BulkInsertStatement : public ForwardStatement
+{
+    std::map<std::string, std::string> _hostvars;
+
+    const std::string& hostvar(const std::string& col) const;
+
+public:
+    BulkInsertStatement(const Statement& stmt, const std::vector<std::string>& columns);
+
+    virtual void setNull(const std::string& col);
+    virtual void setBool(const std::string& col, bool data);
+    virtual void setShort(const std::string& col, short data);
+    virtual void setInt(const std::string& col, int data);
+    virtual void setLong(const std::string& col, long data);
+    virtual void setUnsignedShort(const std::string& col, unsigned short data);
+    virtual void setUnsigned(const std::string& col, unsigned data);
+    virtual void setUnsignedLong(const std::string& col, unsigned long data);
+    virtual void setInt32(const std::string& col, int32_t data);
+    virtual void setUnsigned32(const std::string& col, uint32_t data);
+    virtual void setInt64(const std::string& col, int64_t data);
+    virtual void setUnsigned64(const std::string& col, uint64_t data);
+    virtual void setDecimal(const std::string& col, const Decimal& data);
+    virtual void setFloat(const std::string& col, float data);
+    virtual void setDouble(const std::string& col, double data);
+    virtual void setChar(const std::string& col, char data);
+    virtual void setString(const std::string& col, const std::string& data);
+    virtual void setBlob(const std::string& col, const Blob& data);
+    virtual void setDate(const std::string& col, const Date& data);
+    virtual void setTime(const std::string& col, const Time& data);
+    virtual void setDatetime(const std::string& col, const Datetime& data);
+    virtual void setUString(const std::string& col, const cxxtools::String& data);
+
+    virtual size_type paramIndex(const std::string& col);
+
+    virtual void setStringRef(const std::string& col, const char* data, std::size_t length);
+    virtual void setBlobRef(const std::string& col, const char* data, std::size_t length);
+
+    virtual void takeString(const std::string& col, std::string&& data);
+};
+}
+
+#endif // TNTDB_IMPL_BULKINSERTSTATEMENT_H
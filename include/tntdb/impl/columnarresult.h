@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_IMPL_COLUMNARRESULT_H
+#define TNTDB_IMPL_COLUMNARRESULT_H
+
+#include <tntdb/iface/iresult.h>
+#include <tntdb/iface/irow.h>
+#include <tntdb/iface/ivalue.h>
+#include <tntdb/impl/resultschema.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tntdb
+{
+class ValueImpl;
+
+/** Materialized result, which stores the values column by column
+
+    The values of each column are stored in one buffer with the end offsets
+    of the values and a null bitmap, and the column names in a schema shared
+    by all rows. Rows and values returned by this result are views, which
+    reference the result, so the cells are not copied. The values are stored
+    in the textual representation and converted by a ValueImpl, which takes
+    a copy of the text of the one value.
+ */
+class ColumnarResult : public IResult, public std::enable_shared_from_this<ColumnarResult>
+{
+    struct Column
+    {
+        std::string data;
+        std::vector<std::string::size_type> ends;
+        std::vector<bool> nulls;
+    };
+
+    std::shared_ptr<const ResultSchema> _schema;
+    std::vector<Column> _columns;
+
+public:
+    explicit ColumnarResult(const std::shared_ptr<const ResultSchema>& schema);
+
+    // methods from IResult
+    virtual Row getRow(size_type tup_num) const;
+    virtual size_type size() const;
+    virtual size_type getFieldCount() const;
+
+    // specific methods
+
+    /// Appends a value to the passed column.
+    /// A row is complete, when a value is added to each column.
+    void add(size_type field_num, const char* data, std::string::size_type length);
+    /// Appends a null value to the passed column.
+    void addNull(size_type field_num);
+
+    const ResultSchema& getSchema() const    { return *_schema; }
+
+    bool isNull(size_type tup_num, size_type field_num) const
+        { return _columns[field_num].nulls[tup_num]; }
+    /// Returns a pointer to the value and its length.
+    const char* getData(size_type tup_num, size_type field_num, std::string::size_type& length) const;
+};
+
+/// Row of a ColumnarResult
+class ColumnarRow : public IRow
+{
+    std::shared_ptr<const ColumnarResult> _result;
+    size_type _tupNum;
+
+public:
+    ColumnarRow(const std::shared_ptr<const ColumnarResult>& result, size_type tupNum)
+      : _result(result),
+        _tupNum(tupNum)
+    { }
+
+    // methods from IRow
+    virtual size_type size() const;
+    virtual Value getValueByNumber(size_type field_num) const;
+    virtual Value getValueByName(const std::string& field_name) const;
+    virtual std::string getColumnName(size_type field_num) const;
+    virtual size_type getFieldNumber(const std::string& field_name) const;
+    virtual const ResultSchema* getSchema() const;
+};
+
+/// Value of a ColumnarResult
+class ColumnarValue : public IValue
+{
+    std::shared_ptr<const ColumnarResult> _result;
+    unsigned _tupNum;
+    unsigned _fieldNum;
+
+    std::string str() const;
+    template <typename T>
+    T convert(T (ValueImpl::*getter)() const) const;
+
+public:
+    ColumnarValue(const std::shared_ptr<const ColumnarResult>& result, unsigned tupNum, unsigned fieldNum)
+      : _result(result),
+        _tupNum(tupNum),
+        _fieldNum(fieldNum)
+    { }
+
+    virtual bool isNull() const;
+    virtual bool getBool() const;
+    virtual short getShort() const;
+    virtual int getInt() const;
+    virtual long getLong() const;
+    virtual unsigned short getUnsignedShort() const;
+    virtual unsigned getUnsigned() const;
+    virtual unsigned long getUnsignedLong() const;
+    virtual int32_t getInt32() const;
+    virtual uint32_t getUnsigned32() const;
+    virtual int64_t getInt64() const;
+    virtual uint64_t getUnsigned64() const;
+    virtual Decimal getDecimal() const;
+    virtual float getFloat() const;
+    virtual double getDouble() const;
+    virtual char getChar() const;
+    virtual void getString(std::string& ret) const;
+    virtual void getBlob(Blob& ret) const;
+    virtual Date getDate() const;
+    virtual Time getTime() const;
+    virtual Datetime getDatetime() const;
+    virtual const char* getStringData(std::size_t& length) const;
+    virtual const char* getBlobData(std::size_t& length) const;
+};
+}
+
+#endif // TNTDB_IMPL_COLUMNARRESULT_H
@@ -39,11 +39,18 @@ class PoolConnection : public IConnection
     ConnectionPool& _connectionPool;
 
     std::shared_ptr<IConnection> _connection;
+    std::shared_ptr<StatementCache> _statementCache;
+    ConnectionPool::Clock::time_point _created;
     bool _inTransaction;
+    bool _inPipeline;
     bool _drop;
+    std::shared_ptr<bool> _suspect;  // an error was seen, so the connection is validated on next use
+
+    Statement wrap(const Statement& stmt);
 
 public:
-    explicit PoolConnection(std::shared_ptr<IConnection>&& connection, ConnectionPool& connectionPool);
+    PoolConnection(std::shared_ptr<IConnection>&& connection, std::shared_ptr<StatementCache>&& statementCache,
+                   std::shared_ptr<bool>&& suspect, ConnectionPool::Clock::time_point created, ConnectionPool& connectionPool);
     ~PoolConnection();
 
     virtual void beginTransaction();
@@ -59,6 +66,13 @@ public:
     virtual bool ping();
     virtual long lastInsertId(const std::string& name);
     virtual void lockTable(const std::string& tablename, bool exclusive);
+    virtual void beginPipeline();
+    virtual size_type syncPipeline();
+    virtual void endPipeline();
+    virtual Statement prepareBulkLoad(const std::string& table, const std::vector<std::string>& columns);
+    virtual size_type copyOut(const std::string& query, std::ostream& out);
+    virtual size_type copyOutRows(const std::string& query, const std::function<void (const Row&)>& callback);
+    virtual StatementCache* getStatementCache(unsigned maxSize, std::chrono::milliseconds maxAge);
 };
 }
 
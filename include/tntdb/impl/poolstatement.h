@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_IMPL_POOLSTATEMENT_H
+#define TNTDB_IMPL_POOLSTATEMENT_H
+
+#include <tntdb/impl/forwardstatement.h>
+#include <tntdb/error.h>
+#include <memory>
+
+namespace tntdb
+{
+/// Calls f and marks the connection as suspect, when it fails with an
+/// error other than NotFound.
+template <typename F>
+auto trackErrors(bool& suspect, F f) -> decltype(f())
+{
+    try
+    {
+        return f();
+    }
+    catch (const NotFound&)
+    {
+        throw;
+    }
+    catch (const Error&)
+    {
+        suspect = true;
+        throw;
+    }
+}
+
+/// Statement of a pooled connection.
+///
+/// The suspect flag belongs to the physical connection and not to a single
+/// checkout, since cached statements are reused by later checkouts.
+/// Errors, which occur while fetching from a cursor, are not seen here.
+class PoolStatement : public ForwardStatement
+{
+    std::shared_ptr<bool> _suspect;
+
+public:
+    PoolStatement(const Statement& stmt, const std::shared_ptr<bool>& suspect)
+      : ForwardStatement(stmt),
+        _suspect(suspect)
+      { }
+
+    virtual size_type execute();
+    virtual Result select();
+    virtual Row selectRow();
+    virtual Value selectValue();
+    virtual std::shared_ptr<ICursor> createCursor(unsigned fetchsize);
+    virtual void maxNumDelay(size_type n);
+    virtual size_type flush();
+};
+}
+
+#endif // TNTDB_IMPL_POOLSTATEMENT_H
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_IMPL_RESULTSCHEMA_H
+#define TNTDB_IMPL_RESULTSCHEMA_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+namespace tntdb
+{
+/** Column names of a result
+
+    A schema is created once per result and shared by all rows, so that
+    the rows do not need to store the names themselves. The names are
+    indexed by a hash, so that looking up a column by name does not depend
+    on the number of columns.
+
+    Each schema gets a process wide unique id, which is used by ColumnIndex
+    to detect, whether a cached column number is still valid.
+ */
+class ResultSchema
+{
+public:
+    typedef unsigned size_type;
+
+private:
+    std::vector<std::string> _names;
+    std::unordered_map<std::string, size_type> _index;
+    uint64_t _id;
+
+    static uint64_t nextId();
+
+public:
+    ResultSchema()
+      : _id(nextId())
+    { }
+
+    explicit ResultSchema(const std::vector<std::string>& names);
+
+    /// Adds a column; when a name is used twice, the first column is found by name.
+    void add(const std::string& name);
+    void reserve(size_type n);
+
+    size_type size() const              { return _names.size(); }
+    const std::string& getName(size_type field_num) const
+                                        { return _names.at(field_num); }
+
+    /// Returns the number of the column with the passed name.
+    /// Throws FieldNotFound, if there is no such column.
+    size_type getFieldNumber(const std::string& field_name) const;
+
+    uint64_t getId() const              { return _id; }
+};
+}
+
+#endif // TNTDB_IMPL_RESULTSCHEMA_H
@@ -30,6 +30,8 @@
 #define TNTDB_IMPL_VALUE_H
 
 #include <tntdb/iface/ivalue.h>
+#include <string>
+#include <utility>
 
 namespace tntdb
 {
@@ -48,6 +50,11 @@ namespace tntdb
           data(d)
       { }
 
+      ValueImpl(std::string&& d)
+        : null(false),
+          data(std::move(d))
+      { }
+
       virtual bool isNull() const;
       virtual bool getBool() const;
       virtual short getShort() const;
@@ -69,6 +76,8 @@ namespace tntdb
       virtual Date getDate() const;
       virtual Time getTime() const;
       virtual Datetime getDatetime() const;
+      virtual const char* getStringData(std::size_t& length) const;
+      virtual const char* getBlobData(std::size_t& length) const;
   };
 }
 
@@ -56,6 +56,8 @@ namespace mysql
     void setInt64(MYSQL_BIND& value, int64_t data);
     void setUnsigned64(MYSQL_BIND& value, uint64_t data);
     void setDecimal(MYSQL_BIND& value, unsigned long& length, const Decimal& data);
+    /// Sets a decimal value from its string representation
+    void setDecimal(MYSQL_BIND& value, unsigned long& length, const std::string& data);
     void setFloat(MYSQL_BIND& value, float data);
     void setDouble(MYSQL_BIND& value, double data);
     void setChar(MYSQL_BIND& value, unsigned long& length, char data);
@@ -85,6 +87,8 @@ namespace mysql
     char           getChar(const MYSQL_BIND& value);
     void           getString(const MYSQL_BIND& value, std::string& ret);
     void           getBlob(const MYSQL_BIND& value, Blob& ret);
+    const char*    getStringData(const MYSQL_BIND& value, std::size_t& length);
+    const char*    getBlobData(const MYSQL_BIND& value, std::size_t& length);
     Date           getDate(const MYSQL_BIND& value);
     Time           getTime(const MYSQL_BIND& value);
     Datetime       getDatetime(const MYSQL_BIND& value);
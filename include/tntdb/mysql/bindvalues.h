@@ -32,27 +32,62 @@
 #include <mysql.h>
 #include <string>
 #include <tntdb/decimal.h>
+#include <tntdb/blob.h>
 #include <tntdb/mysql/bindutils.h>
+#include <string.h>
 
 namespace tntdb
 {
 namespace mysql
 {
+/** Bind buffers of the parameters or result columns of a statement
+
+    The buffers of all values are slots of one block, which is allocated
+    with the values, so setting values does not allocate, as long as they
+    fit into their slot. A value, which needs more room, gets a buffer of
+    its own, which is kept for later values. Resizing to fewer values keeps
+    the buffers.
+ */
 class BindValues
 {
+    static const unsigned long slotSize = 64;
+
     unsigned valuesSize;
+    unsigned valuesCapacity;
     MYSQL_BIND* values;
+    char* arena;
     struct BindAttributes
     {
         unsigned long length;
         my_bool isNull;
         std::string name;
+        // the own buffer, while the value references data of the caller
+        void* ownBuffer;
+        unsigned long ownBufferLength;
+        bool isRef;
         BindAttributes()
             : length(0),
-              isNull(true)
+              isNull(true),
+              ownBuffer(0),
+              ownBufferLength(0),
+              isRef(false)
             { }
     }* bindAttributes;
 
+    // restores the own buffer of value n after it referenced data of the caller
+    void own(unsigned n)
+      { if (bindAttributes[n].isRef) releaseRef(n); }
+    void releaseRef(unsigned n);
+    void releaseAll();
+    void init(unsigned n);
+
+    char* slot(unsigned n) const
+      { return arena + n * slotSize; }
+    // makes room for size bytes in the buffer of value n
+    void fit(unsigned n, unsigned long size)
+      { if (size > slotSize && values[n].buffer == slot(n)) detach(n); }
+    void detach(unsigned n);
+
     BindValues(const BindValues&) = delete;
     BindValues& operator=(const BindValues&) = delete;
 
@@ -65,50 +100,54 @@ public:
     void setSize(unsigned n);
     unsigned getSize() const            { return valuesSize; }
 
-    void setNull(unsigned n)
-      { mysql::setNull(values[n]); }
+    void setNull(unsigned n);
     void setBool(unsigned n, bool data)
-      { mysql::setBool(values[n], data); }
+      { own(n); mysql::setBool(values[n], data); }
     void setShort(unsigned n, short data)
-      { mysql::setShort(values[n], data); }
+      { own(n); mysql::setShort(values[n], data); }
     void setInt(unsigned n, int data)
-      { mysql::setInt(values[n], data); }
+      { own(n); mysql::setInt(values[n], data); }
     void setLong(unsigned n, int data)
-      { mysql::setLong(values[n], data); }
+      { own(n); mysql::setLong(values[n], data); }
     void setUnsignedShort(unsigned n, unsigned short data)
-      { mysql::setUnsignedShort(values[n], data); }
+      { own(n); mysql::setUnsignedShort(values[n], data); }
     void setUnsigned(unsigned n, unsigned data)
-      { mysql::setUnsigned(values[n], data); }
+      { own(n); mysql::setUnsigned(values[n], data); }
     void setUnsignedLong(unsigned n, unsigned data)
-      { mysql::setUnsignedLong(values[n], data); }
+      { own(n); mysql::setUnsignedLong(values[n], data); }
     void setInt32(unsigned n, int32_t data)
-      { mysql::setInt32(values[n], data); }
+      { own(n); mysql::setInt32(values[n], data); }
     void setUnsigned32(unsigned n, uint32_t data)
-      { mysql::setUnsigned32(values[n], data); }
+      { own(n); mysql::setUnsigned32(values[n], data); }
     void setInt64(unsigned n, int64_t data)
-      { mysql::setInt64(values[n], data); }
+      { own(n); mysql::setInt64(values[n], data); }
     void setUnsigned64(unsigned n, uint64_t data)
-      { mysql::setUnsigned64(values[n], data); }
-    void setDecimal(unsigned n, const Decimal& data)
-      { mysql::setDecimal(values[n], bindAttributes[n].length, data); }
+      { own(n); mysql::setUnsigned64(values[n], data); }
+    void setDecimal(unsigned n, const Decimal& data);
     void setFloat(unsigned n, float data)
-      { mysql::setFloat(values[n], data); }
+      { own(n); mysql::setFloat(values[n], data); }
     void setDouble(unsigned n, double data)
-      { mysql::setDouble(values[n], data); }
+      { own(n); mysql::setDouble(values[n], data); }
     void setChar(unsigned n, char data)
-      { mysql::setChar(values[n], bindAttributes[n].length, data); }
+      { own(n); mysql::setChar(values[n], bindAttributes[n].length, data); }
     void setString(unsigned n, const char* data)
-      { mysql::setString(values[n], bindAttributes[n].length, data); }
+      { own(n); fit(n, ::strlen(data) + 1); mysql::setString(values[n], bindAttributes[n].length, data); }
     void setString(unsigned n, const std::string& data)
-      { mysql::setString(values[n], bindAttributes[n].length, data); }
+      { own(n); fit(n, data.size()); mysql::setString(values[n], bindAttributes[n].length, data); }
     void setBlob(unsigned n, const Blob& data)
-      { mysql::setBlob(values[n], bindAttributes[n].length, data); }
+      { own(n); fit(n, data.size()); mysql::setBlob(values[n], bindAttributes[n].length, data); }
     void setDate(unsigned n, const Date& data)
-      { mysql::setDate(values[n], data); }
+      { own(n); mysql::setDate(values[n], data); }
     void setTime(unsigned n, const Time& data)
-      { mysql::setTime(values[n], data); }
+      { own(n); mysql::setTime(values[n], data); }
     void setDatetime(unsigned n, const Datetime& data)
-      { mysql::setDatetime(values[n], data); }
+      { own(n); mysql::setDatetime(values[n], data); }
+
+    /// References the data of the caller instead of copying it
+    void setRef(unsigned n, const char* data, unsigned long length);
+
+    /// Copies the value and type of a bound variable to position n
+    void setValue(unsigned n, const MYSQL_BIND& value);
 
     bool isNull(unsigned n) const
       { return mysql::isNull(values[n]); }
@@ -142,7 +181,8 @@ public:
     const std::string& getName(unsigned n) const
       { return bindAttributes[n].name; }
 
-    void initOutBuffer(unsigned n, MYSQL_FIELD& f);
+    /// Prepares value n for fetching a column with a buffer of the passed size
+    void initOutBuffer(unsigned n, const MYSQL_FIELD& f, unsigned long size);
     void clear();
 };
 }
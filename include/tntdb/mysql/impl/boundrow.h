@@ -30,7 +30,9 @@
 #define TNTDB_MYSQL_IMPL_BOUNDROW_H
 
 #include <tntdb/iface/irow.h>
+#include <tntdb/impl/resultschema.h>
 #include <tntdb/mysql/bindvalues.h>
+#include <memory>
 
 namespace tntdb
 {
@@ -38,6 +40,8 @@ namespace mysql
 {
 class BoundRow : public IRow, public BindValues
 {
+    std::shared_ptr<const ResultSchema> _schema;
+
 public:
     explicit BoundRow(unsigned n)
       : BindValues(n)
@@ -47,6 +51,11 @@ public:
     Value getValueByNumber(size_type field_num) const;
     Value getValueByName(const std::string& field_name) const;
     std::string getColumnName(size_type field_num) const;
+    size_type getFieldNumber(const std::string& field_name) const;
+    const ResultSchema* getSchema() const   { return _schema.get(); }
+
+    void setSchema(const std::shared_ptr<const ResultSchema>& schema)
+      { _schema = schema; }
 };
 }
 }
@@ -31,6 +31,8 @@
 
 #include <tntdb/iface/iconnection.h>
 #include <mysql.h>
+#include <string>
+#include <vector>
 
 namespace tntdb
 {
@@ -58,6 +60,11 @@ namespace tntdb
  Here the username is "web" and the password is "foo'bar". Note that the backslash
  itself must be doubled in C++ code since the compiler processes the backspace first.
 
+ The option `local_infile=1` enables LOAD DATA LOCAL INFILE, which
+ Connection::prepareBulkLoad then uses, when the server allows it. Only the
+ data of the bulk loader is sent; requests of the server for other files are
+ refused. Without the option bulk loads use multi row inserts.
+
  */
 
 namespace mysql
@@ -71,6 +78,19 @@ class Connection : public IConnection
     bool initialized;
     unsigned transactionActive;
     std::string lockTablesQuery;
+    // server settings; read on first use
+    unsigned long maxAllowedPacket;
+    bool localInfileEnabled;  // option local_infile of the connection string
+    int localInfile;
+
+    // data of the active LOAD DATA LOCAL INFILE statement
+    const std::string* infileData;
+    std::string::size_type infilePos;
+
+    static int infileInit(void** ptr, const char* filename, void* userdata);
+    static int infileRead(void* ptr, char* buf, unsigned int length);
+    static void infileEnd(void* ptr);
+    static int infileError(void* ptr, char* msg, unsigned int length);
 
     void open(const char* app, const char* host,
       const char* user, const char* passwd,
@@ -101,6 +121,16 @@ public:
     bool ping();
     long lastInsertId(const std::string& name);
     void lockTable(const std::string& tablename, bool exclusive);
+    tntdb::Statement prepareBulkLoad(const std::string& table, const std::vector<std::string>& columns);
+
+    /// Returns the maximum size of a packet, which the server accepts.
+    unsigned long getMaxAllowedPacket();
+    /// Returns true, when LOAD DATA LOCAL INFILE is enabled by the option
+    /// local_infile and accepted by the server.
+    bool hasLocalInfile();
+    /// Executes a LOAD DATA LOCAL INFILE statement, which reads the passed
+    /// data instead of a file. Returns the number of loaded rows.
+    size_type loadData(const std::string& query, const std::string& data);
 };
 }
 }
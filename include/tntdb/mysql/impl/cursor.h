@@ -42,12 +42,12 @@ class Statement;
 
 class Cursor : public ICursor
 {
+    std::shared_ptr<Statement> _statement;
     std::shared_ptr<BoundRow> _row;
-    MYSQL_FIELD* _fields;
     MYSQL_STMT* _stmt;
 
 public:
-    Cursor(Statement& statement, unsigned fetchsize);
+    Cursor(const std::shared_ptr<Statement>& statement, unsigned fetchsize);
     ~Cursor();
 
     // method for ICursor
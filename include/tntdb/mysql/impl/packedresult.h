@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_MYSQL_IMPL_PACKEDRESULT_H
+#define TNTDB_MYSQL_IMPL_PACKEDRESULT_H
+
+#include <tntdb/iface/iresult.h>
+#include <tntdb/iface/irow.h>
+#include <tntdb/iface/ivalue.h>
+#include <tntdb/impl/resultschema.h>
+#include <mysql.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tntdb
+{
+namespace mysql
+{
+/** Materialized result of a prepared statement
+
+    The rows are fetched into one reusable bind buffer and the values are
+    packed column by column in their binary representation, so each value
+    takes exactly its size instead of a bind buffer sized from the column
+    metadata. Like ColumnarResult each column keeps one buffer with the end
+    offsets of the values and a null bitmap; rows and values are views,
+    which reference the result.
+ */
+class PackedResult : public IResult, public std::enable_shared_from_this<PackedResult>
+{
+    struct Column
+    {
+        enum_field_types type;
+        bool isUnsigned;
+        std::string data;
+        std::vector<unsigned long> ends;
+        std::vector<bool> nulls;
+
+        Column()
+          : type(MYSQL_TYPE_NULL),
+            isUnsigned(false)
+          { }
+    };
+
+    std::shared_ptr<const ResultSchema> _schema;
+    std::vector<Column> _columns;
+    size_type _size;
+
+public:
+    explicit PackedResult(const std::shared_ptr<const ResultSchema>& schema);
+
+    // methods from IResult
+    virtual Row getRow(size_type tup_num) const;
+    virtual size_type size() const;
+    virtual size_type getFieldCount() const;
+
+    // specific methods
+
+    /// Appends a row, which is copied from the fetched output buffers.
+    void addRow(const MYSQL_BIND* bind);
+
+    const ResultSchema& getSchema() const    { return *_schema; }
+
+    bool isNull(size_type tup_num, size_type field_num) const
+        { return _columns[field_num].nulls[tup_num]; }
+    enum_field_types getType(size_type field_num) const
+        { return _columns[field_num].type; }
+    bool isUnsigned(size_type field_num) const
+        { return _columns[field_num].isUnsigned; }
+    /// Returns a pointer to the value and its length.
+    const char* getData(size_type tup_num, size_type field_num, unsigned long& length) const;
+};
+
+/// Row of a PackedResult
+class PackedRow : public IRow
+{
+    std::shared_ptr<const PackedResult> _result;
+    size_type _tupNum;
+
+public:
+    PackedRow(const std::shared_ptr<const PackedResult>& result, size_type tupNum)
+      : _result(result),
+        _tupNum(tupNum)
+    { }
+
+    // methods from IRow
+    virtual size_type size() const;
+    virtual Value getValueByNumber(size_type field_num) const;
+    virtual Value getValueByName(const std::string& field_name) const;
+    virtual std::string getColumnName(size_type field_num) const;
+    virtual size_type getFieldNumber(const std::string& field_name) const;
+    virtual const ResultSchema* getSchema() const;
+};
+
+/// Value of a PackedResult
+///
+/// The value is read through a MYSQL_BIND, which references the packed data.
+/// Fixed size values are copied to an aligned buffer first.
+class PackedValue : public IValue
+{
+    std::shared_ptr<const PackedResult> _result;
+    MYSQL_BIND _bind;
+    unsigned long _length;
+    my_bool _isNull;
+    union
+    {
+        MYSQL_TIME time;
+        long long ll;
+        double d;
+    } _fixed;
+
+public:
+    PackedValue(const std::shared_ptr<const PackedResult>& result, unsigned tupNum, unsigned fieldNum);
+
+    virtual bool isNull() const;
+    virtual bool getBool() const;
+    virtual short getShort() const;
+    virtual int getInt() const;
+    virtual long getLong() const;
+    virtual unsigned short getUnsignedShort() const;
+    virtual unsigned getUnsigned() const;
+    virtual unsigned long getUnsignedLong() const;
+    virtual int32_t getInt32() const;
+    virtual uint32_t getUnsigned32() const;
+    virtual int64_t getInt64() const;
+    virtual uint64_t getUnsigned64() const;
+    virtual Decimal getDecimal() const;
+    virtual float getFloat() const;
+    virtual double getDouble() const;
+    virtual char getChar() const;
+    virtual void getString(std::string& ret) const;
+    virtual void getBlob(Blob& ret) const;
+    virtual const char* getStringData(std::size_t& length) const;
+    virtual const char* getBlobData(std::size_t& length) const;
+    virtual Date getDate() const;
+    virtual Time getTime() const;
+    virtual Datetime getDatetime() const;
+};
+}
+}
+
+#endif // TNTDB_MYSQL_IMPL_PACKEDRESULT_H
@@ -30,6 +30,7 @@
 #define TNTDB_MYSQL_IMPL_RESULT_H
 
 #include <tntdb/iface/iresult.h>
+#include <tntdb/impl/resultschema.h>
 #include <mysql.h>
 #include <memory>
 
@@ -43,12 +44,14 @@ class Result : public IResult
     MYSQL* mysql;
     MYSQL_RES* result;
     size_type field_count;
+    ResultSchema schema;
 
 public:
     Result(MYSQL* m, MYSQL_RES* r);
     ~Result();
 
     MYSQL_RES* getMysqlRes() const  { return result; }
+    const ResultSchema& getSchema() const  { return schema; }
     std::shared_ptr<ResultRow> getMysqlRow(size_type tup_num) const;
 
     Row getRow(size_type tup_num) const;
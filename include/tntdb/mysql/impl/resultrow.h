@@ -31,6 +31,7 @@
 
 #include <tntdb/bits/result.h>
 #include <tntdb/iface/irow.h>
+#include <tntdb/impl/resultschema.h>
 #include <mysql.h>
 
 namespace tntdb
@@ -48,10 +49,11 @@ class ResultRow : public IRow
     unsigned _field_count;
     unsigned long* _lengths;
     MYSQL_FIELD* _fields;
+    const ResultSchema* _schema;
 
 public:
     ResultRow(std::shared_ptr<Result> resultref, MYSQL_ROW row, unsigned field_count);
-    ResultRow(MYSQL_RES* res, MYSQL_ROW row, unsigned field_count);
+    ResultRow(MYSQL_RES* res, MYSQL_ROW row, unsigned field_count, const ResultSchema* schema = 0);
 
     static std::shared_ptr<RowValue> getMysqlValue(std::shared_ptr<ResultRow> result, size_type field_num);
 
@@ -59,6 +61,8 @@ public:
     Value getValueByNumber(size_type field_num) const;
     Value getValueByName(const std::string& field_name) const;
     std::string getColumnName(size_type field_num) const;
+    size_type getFieldNumber(const std::string& field_name) const;
+    const ResultSchema* getSchema() const   { return _schema; }
 };
 }
 }
@@ -83,6 +83,8 @@ public:
     virtual char getChar() const;
     virtual void getString(std::string& ret) const;
     virtual void getBlob(Blob& ret) const;
+    virtual const char* getStringData(std::size_t& length) const;
+    virtual const char* getBlobData(std::size_t& length) const;
     virtual Date getDate() const;
     virtual Time getTime() const;
     virtual Datetime getDatetime() const;
@@ -35,26 +35,69 @@
 #include <tntdb/mysql/impl/boundrow.h>
 #include <tntdb/mysql/impl/connection.h>
 #include <map>
+#include <vector>
 #include <memory>
 
 namespace tntdb
 {
 namespace mysql
 {
-class Statement : public IStatement
+class Statement : public IStatement, public std::enable_shared_from_this<Statement>
 {
-    typedef std::multimap<std::string, unsigned> hostvarMapType;
+    friend class StreamResult;
+
+    // host variable name to parameter number
+    typedef std::map<std::string, unsigned> hostvarMapType;
 
     Connection& conn;
     std::string query;
     BindValues inVars;
     hostvarMapType hostvarMap;
+    // positions of the placeholders of each parameter number
+    std::vector<std::vector<unsigned> > paramPositions;
     MYSQL* mysql;
     MYSQL_STMT* stmt;
     MYSQL_FIELD* fields;
     unsigned field_count;
+    std::shared_ptr<const ResultSchema> schema;
     std::shared_ptr<BoundRow> rowPtr;
 
+    // The longest value fetched so far of each column. The output buffers
+    // are sized by it, so that they neither waste memory nor truncate
+    // values, which need a second fetch, in later executions.
+    std::vector<unsigned long> columnWidths;
+
+    bool streaming;
+    unsigned fetchSize;
+    // incremented on each execution of stmt; a streaming result is valid
+    // as long as the generation does not change
+    unsigned generation;
+
+    // Delayed executions. The values of each execution are copied to
+    // delayedVars one row after another.
+    size_type maxDelay;
+    size_type delayedRows;
+    // size of the delayed values in an execute packet
+    unsigned long delayedBytes;
+    BindValues delayedVars;
+
+    // For "INSERT ... VALUES (...)" the delayed rows are sent in one
+    // multi row insert, which is flushed early when the values reach
+    // max_allowed_packet. insertRow is empty for other statements.
+    std::string insertPrefix;
+    std::string insertRow;
+    std::string insertSuffix;
+    MYSQL_STMT* batchStmt;
+
+    // Prepared handles of finished cursors. They are reset and reused by
+    // the next cursors instead of preparing the query again.
+    std::vector<MYSQL_STMT*> cursorStmts;
+
+    MYSQL_STMT* prepareStmt();
+
+    MYSQL_STMT* prepareBatch(unsigned rows);
+    size_type executeBatch(MYSQL_STMT* stmt, MYSQL_BIND* bind);
+
     std::shared_ptr<BoundRow> getRow();
     std::shared_ptr<BoundRow> fetchRow();
     std::shared_ptr<BoundRow> selectBoundRow();
@@ -89,22 +132,71 @@ public:
     void setTime(const std::string& col, const Time& data);
     void setDatetime(const std::string& col, const Datetime& data);
 
+    size_type paramIndex(const std::string& col);
+    void setNullAt(size_type hv);
+    void setBoolAt(size_type hv, bool data);
+    void setShortAt(size_type hv, short data);
+    void setIntAt(size_type hv, int data);
+    void setLongAt(size_type hv, long data);
+    void setUnsignedShortAt(size_type hv, unsigned short data);
+    void setUnsignedAt(size_type hv, unsigned data);
+    void setUnsignedLongAt(size_type hv, unsigned long data);
+    void setInt32At(size_type hv, int32_t data);
+    void setUnsigned32At(size_type hv, uint32_t data);
+    void setInt64At(size_type hv, int64_t data);
+    void setUnsigned64At(size_type hv, uint64_t data);
+    void setDecimalAt(size_type hv, const Decimal& data);
+    void setFloatAt(size_type hv, float data);
+    void setDoubleAt(size_type hv, double data);
+    void setCharAt(size_type hv, char data);
+    void setStringAt(size_type hv, const std::string& data);
+    void setBlobAt(size_type hv, const Blob& data);
+    void setDateAt(size_type hv, const Date& data);
+    void setTimeAt(size_type hv, const Time& data);
+    void setDatetimeAt(size_type hv, const Datetime& data);
+
+    void setStringRef(const std::string& col, const char* data, std::size_t length);
+    void setBlobRef(const std::string& col, const char* data, std::size_t length);
+    void setStringRefAt(size_type hv, const char* data, std::size_t length);
+    void setBlobRefAt(size_type hv, const char* data, std::size_t length);
+
     size_type execute();
     tntdb::Result select();
     tntdb::Row selectRow();
     tntdb::Value selectValue();
     std::shared_ptr<ICursor> createCursor(unsigned fetchsize);
 
+    void maxNumDelay(size_type n);
+    size_type numDelayed() const;
+    size_type flush();
+
+    void setStreaming(bool sw);
+    bool isStreaming() const;
+    void setFetchSize(unsigned n);
+    unsigned getFetchSize() const;
+
     // specfic methods
 
-    // creates stmt handle - caller is responsible for removal
-    MYSQL_STMT* createStmt();
+    // returns a prepared stmt handle for a cursor, which is passed back
+    // with releaseStmt when the cursor is done
+    MYSQL_STMT* acquireStmt();
+    void releaseStmt(MYSQL_STMT* stmt);
     // creates stmt handle - handle is managed by this
     MYSQL_STMT* getStmt();
     void execute(MYSQL_STMT* stmt, unsigned fetchsize);
 
     MYSQL_FIELD* getFields();
     unsigned getFieldCount();
+
+    // sizes the output buffers of a row by the column widths seen so far
+    void initOutBuffers(BoundRow& row);
+    // fetches the truncated columns of the current row again with larger
+    // buffers; the row has to be bound again before the next fetch
+    void fetchTruncated(MYSQL_STMT* stmt, BoundRow& row);
+    // records the lengths of the values of a fetched row
+    void updateColumnWidths(const BoundRow& row);
+    const std::shared_ptr<const ResultSchema>& getSchema()
+        { getFields(); return schema; }
 };
 }
 }
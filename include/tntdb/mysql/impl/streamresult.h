@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_MYSQL_IMPL_STREAMRESULT_H
+#define TNTDB_MYSQL_IMPL_STREAMRESULT_H
+
+#include <tntdb/iface/iresult.h>
+#include <tntdb/iface/irow.h>
+#include <tntdb/impl/resultschema.h>
+#include <tntdb/mysql/bindvalues.h>
+#include <memory>
+#include <string>
+
+namespace tntdb
+{
+class Value;
+
+namespace mysql
+{
+class Statement;
+class BoundRow;
+
+/** Result of a streaming select
+
+    The statement is executed with a read only server side cursor and the
+    rows are fetched on demand, fetch size rows per round trip, so only the
+    current row is held in memory. The fetch buffer is reused unless values
+    of the current row are still referenced. A row is a handle, which moves
+    the cursor to its position when accessed. Accessing an earlier row
+    executes the statement again with the host variables of the first
+    execution.
+ */
+class StreamResult : public IResult, public std::enable_shared_from_this<StreamResult>
+{
+    std::shared_ptr<Statement> _statement;
+    BindValues _params;
+    unsigned _fetchSize;
+    mutable unsigned _generation;
+    std::shared_ptr<const ResultSchema> _schema;
+    mutable std::shared_ptr<BoundRow> _row;
+
+    // number of rows fetched since the last execution; the current row is _pos - 1
+    mutable size_type _pos;
+    mutable bool _eof;
+    mutable bool _sizeKnown;
+    mutable size_type _size;
+
+    MYSQL_STMT* getStmt() const;
+    void execute() const;
+    void bindRow() const;
+    bool fetch() const;
+
+public:
+    explicit StreamResult(const std::shared_ptr<Statement>& statement);
+    ~StreamResult();
+
+    // methods from IResult
+    virtual Row getRow(size_type tup_num) const;
+    virtual size_type size() const;
+    virtual size_type getFieldCount() const;
+
+    // specific methods
+    void moveTo(size_type tup_num) const;
+    Value getValue(size_type tup_num, size_type field_num) const;
+    const ResultSchema& getSchema() const    { return *_schema; }
+};
+
+/// Row of a streaming select
+class StreamRow : public IRow
+{
+    std::shared_ptr<const StreamResult> _result;
+    size_type _tupNum;
+
+public:
+    StreamRow(const std::shared_ptr<const StreamResult>& result, size_type tupNum)
+      : _result(result),
+        _tupNum(tupNum)
+      { }
+
+    // methods from IRow
+    virtual size_type size() const;
+    virtual Value getValueByNumber(size_type field_num) const;
+    virtual Value getValueByName(const std::string& field_name) const;
+    virtual std::string getColumnName(size_type field_num) const;
+    virtual size_type getFieldNumber(const std::string& field_name) const;
+    virtual const ResultSchema* getSchema() const;
+};
+}
+}
+
+#endif // TNTDB_MYSQL_IMPL_STREAMRESULT_H
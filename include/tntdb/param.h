@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_PARAM_H
+#define TNTDB_PARAM_H
+
+#include <tntdb/iface/istatement.h>
+#include <string>
+
+namespace tntdb
+{
+/**
+ * A Param is a host variable of a statement, which is resolved to the
+ * number the driver binds it with.
+ *
+ * Setting a host variable by name looks up the name on every call. A Param
+ * is resolved once with tntdb::Statement::param and passed to the setters
+ * instead of the name. It is valid only for the statement it was resolved
+ * from. Drivers, which bind by name only, look up the name each time.
+ *
+ * Example:
+ * \code
+ *   tntdb::Statement ins = conn.prepare("insert into tab1(a, b) values(:a, :b)");
+ *   tntdb::Param a = ins.param("a");
+ *   tntdb::Param b = ins.param("b");
+ *   for (unsigned n = 0; n < 1000; ++n)
+ *     ins.set(a, n).set(b, "value").execute();
+ * \endcode
+ */
+class Param
+{
+    std::string _name;
+    IStatement::size_type _index;
+
+public:
+    Param()
+      : _index(IStatement::noParam)
+      { }
+
+    Param(const std::string& name, IStatement::size_type index)
+      : _name(name),
+        _index(index)
+      { }
+
+    /// Returns the name of the host variable.
+    const std::string& getName() const      { return _name; }
+
+    /// Returns the number of the host variable or IStatement::noParam.
+    IStatement::size_type getIndex() const  { return _index; }
+
+    /// Returns true, if the driver binds the host variable by number.
+    bool isResolved() const                 { return _index != IStatement::noParam; }
+};
+}
+
+#endif // TNTDB_PARAM_H
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_POSTGRESQL_IMPL_BINARYFORMAT_H
+#define TNTDB_POSTGRESQL_IMPL_BINARYFORMAT_H
+
+#include <tntdb/decimal.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <libpq-fe.h>
+#include <string>
+#include <stdint.h>
+
+namespace tntdb
+{
+namespace postgresql
+{
+/// Type oids of the builtin types, which are handled in binary format.
+enum TypeOid
+{
+    BOOLOID = 16,
+    BYTEAOID = 17,
+    CHAROID = 18,
+    NAMEOID = 19,
+    INT8OID = 20,
+    INT2OID = 21,
+    INT4OID = 23,
+    TEXTOID = 25,
+    OIDOID = 26,
+    JSONOID = 114,
+    XMLOID = 142,
+    FLOAT4OID = 700,
+    FLOAT8OID = 701,
+    UNKNOWNOID = 705,
+    BPCHAROID = 1042,
+    VARCHAROID = 1043,
+    DATEOID = 1082,
+    TIMEOID = 1083,
+    TIMESTAMPOID = 1114,
+    TIMESTAMPTZOID = 1184,
+    NUMERICOID = 1700,
+    UUIDOID = 2950,
+    JSONBOID = 3802
+};
+
+/// Returns true for types, which binary representation is the text itself.
+bool isTextType(Oid type);
+
+// Text representations of values, which are sent with format 0.
+
+std::string encodeText(bool data);
+std::string encodeText(int16_t data);
+std::string encodeText(int32_t data);
+std::string encodeText(int64_t data);
+std::string encodeText(float data);
+std::string encodeText(double data);
+std::string encodeText(const Decimal& data);
+std::string encodeText(const Date& data);
+std::string encodeText(const Time& data);
+std::string encodeText(const Datetime& data);
+
+// Encoders return the binary representation of a value, which is sent as
+// a parameter with format 1.
+
+std::string encodeBinary(bool data);
+std::string encodeBinary(int16_t data);
+std::string encodeBinary(int32_t data);
+std::string encodeBinary(int64_t data);
+std::string encodeBinary(float data);
+std::string encodeBinary(double data);
+std::string encodeBinary(const Decimal& data);
+std::string encodeBinary(const Date& data);
+std::string encodeBinary(const Time& data);
+std::string encodeBinary(const Datetime& data);
+
+// Decoders read a value received in binary format. A TypeError is thrown
+// when the length does not match the type.
+
+bool decodeBool(const char* data, int len);
+int64_t decodeInteger(Oid type, const char* data, int len);
+double decodeFloat(Oid type, const char* data, int len);
+std::string decodeNumeric(const char* data, int len);
+Date decodeDate(const char* data, int len);
+Time decodeTime(const char* data, int len);
+/// Values of timestamp with time zone are returned in UTC and not in the
+/// session time zone like in text format.
+Datetime decodeTimestamp(const char* data, int len);
+
+/// Returns the text representation of a value received in binary format.
+std::string decodeString(Oid type, const char* data, int len);
+
+}
+}
+
+#endif // TNTDB_POSTGRESQL_IMPL_BINARYFORMAT_H
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_POSTGRESQL_IMPL_BULKLOADER_H
+#define TNTDB_POSTGRESQL_IMPL_BULKLOADER_H
+
+#include <tntdb/iface/istatement.h>
+#include <libpq-fe.h>
+#include <string>
+#include <vector>
+
+namespace tntdb
+{
+namespace postgresql
+{
+class Connection;
+
+/**
+ * Loads rows into a table with COPY FROM STDIN.
+ *
+ * The values of a row are set like parameters of a statement with the
+ * column names as host variables. Each execute adds the row to the COPY
+ * data, which is sent to the server in blocks. The COPY is finished with
+ * flush, which returns the number of loaded rows.
+ *
+ * In binary format the column types are read from the catalog and the
+ * values are converted to them on the client.
+ *
+ * The connection is busy while a COPY is active, so no other statements
+ * may be executed on it until flush is called.
+ */
+class BulkLoader : public IStatement
+{
+    struct Field
+    {
+        bool isNull;
+        std::string value;
+
+        Field()
+          : isNull(true)
+          { }
+    };
+
+    Connection* _conn;
+    std::string _table;
+    std::vector<std::string> _columns;
+    std::vector<Oid> _types;
+    std::vector<Field> _fields;
+    bool _binary;
+
+    std::string _copySql;
+    bool _copyActive;
+    std::string _buffer;
+    size_type _rows;
+    size_type _maxRows;
+
+    unsigned columnIndex(const std::string& col) const;
+    void readTypes();
+    PGconn* getPGConn();
+
+    void setValue(unsigned idx, const std::string& data);
+    void setText(unsigned idx, const std::string& data);
+    void setInteger(unsigned idx, int64_t data);
+    void setFloating(unsigned idx, double data, bool isFloat);
+    void setNumeric(unsigned idx, const Decimal& data);
+    void setBytes(unsigned idx, const std::string& data);
+    void typeError(unsigned idx, const char* what) const;
+
+    void beginCopy();
+    void putData(bool force);
+    void appendRow();
+
+public:
+    BulkLoader(Connection* conn, const std::string& table, const std::vector<std::string>& columns, bool binary);
+    ~BulkLoader();
+
+    // methods of IStatement
+
+    void clear();
+    void setNull(const std::string& col);
+    void setBool(const std::string& col, bool data);
+    void setShort(const std::string& col, short data);
+    void setInt(const std::string& col, int data);
+    void setLong(const std::string& col, long data);
+    void setUnsignedShort(const std::string& col, unsigned short data);
+    void setUnsigned(const std::string& col, unsigned data);
+    void setUnsignedLong(const std::string& col, unsigned long data);
+    void setInt32(const std::string& col, int32_t data);
+    void setUnsigned32(const std::string& col, uint32_t data);
+    void setInt64(const std::string& col, int64_t data);
+    void setUnsigned64(const std::string& col, uint64_t data);
+    void setDecimal(const std::string& col, const Decimal& data);
+    void setFloat(const std::string& col, float data);
+    void setDouble(const std::string& col, double data);
+    void setChar(const std::string& col, char data);
+    void setString(const std::string& col, const std::string& data);
+    void setBlob(const std::string& col, const Blob& data);
+    void setDate(const std::string& col, const Date& data);
+    void setTime(const std::string& col, const Time& data);
+    void setDatetime(const std::string& col, const Datetime& data);
+
+    size_type paramIndex(const std::string& col);
+    void setNullAt(size_type idx);
+    void setBoolAt(size_type idx, bool data);
+    void setShortAt(size_type idx, short data);
+    void setIntAt(size_type idx, int data);
+    void setLongAt(size_type idx, long data);
+    void setUnsignedShortAt(size_type idx, unsigned short data);
+    void setUnsignedAt(size_type idx, unsigned data);
+    void setUnsignedLongAt(size_type idx, unsigned long data);
+    void setInt32At(size_type idx, int32_t data);
+    void setUnsigned32At(size_type idx, uint32_t data);
+    void setInt64At(size_type idx, int64_t data);
+    void setUnsigned64At(size_type idx, uint64_t data);
+    void setDecimalAt(size_type idx, const Decimal& data);
+    void setFloatAt(size_type idx, float data);
+    void setDoubleAt(size_type idx, double data);
+    void setCharAt(size_type idx, char data);
+    void setStringAt(size_type idx, const std::string& data);
+    void setBlobAt(size_type idx, const Blob& data);
+    void setDateAt(size_type idx, const Date& data);
+    void setTimeAt(size_type idx, const Time& data);
+    void setDatetimeAt(size_type idx, const Datetime& data);
+
+    size_type execute();
+    tntdb::Result select();
+    tntdb::Row selectRow();
+    tntdb::Value selectValue();
+    std::shared_ptr<ICursor> createCursor(unsigned fetchsize);
+
+    /// Sets the number of rows, after which the COPY is finished; 0 is unlimited.
+    void maxNumDelay(size_type n);
+    size_type numDelayed() const;
+    size_type flush();
+};
+}
+}
+
+#endif // TNTDB_POSTGRESQL_IMPL_BULKLOADER_H
@@ -52,6 +52,25 @@ A typical connection with a PostgreSQL driver looks like that:
  tntdb::Connection conn = tntdb::connect("postgresql:host=localhost port=5432 dbname=mydb user=foo password=bar");
 @endcode
 
+The additional option `binary=1` is handled by tntdb and not passed to libpq.
+It makes prepared statements use the binary wire format of PostgreSQL for
+parameters and results. This saves the conversion of numbers, date and time
+values to and from text. Parameters are then sent with the type of the setter
+used, so that the server may need an explicit cast, where it had accepted an
+untyped text value before. Result columns of types, which have no binary
+decoder, throw a tntdb::TypeError, when read.
+
+@note Columns of type `timestamp with time zone` are read in UTC in binary
+format. In text format the server sends them in the time zone of the session
+(the `TimeZone` setting), and tntdb::Datetime has no time zone, so the same
+column gives different values with and without `binary=1`, unless the session
+time zone is UTC. Convert such columns in the query, e.g. with
+`col at time zone 'Europe/Berlin'`, to get the same value in both formats.
+
+The option `prepare_threshold=n` sets the number of executions, after which a
+statement is prepared as a named statement on the server. Before that it is
+executed as the unnamed statement. The default is 2.
+
 */
 
 namespace postgresql
@@ -67,7 +86,18 @@ class Connection : public IConnection
     unsigned transactionActive;
     unsigned stmtCounter;
     std::vector<std::string> stmtsToDeallocate;
+    bool binaryFormat;
+    unsigned prepareThreshold;
+
+    // queries sent in pipeline mode, which results are not read yet
+    std::vector<std::string> pipeline;
+    bool pipelineMode;
+    size_type pipelineCount;
+
     std::shared_ptr<Result> pgselect(const std::string& query);
+    void checkPipeline();
+    size_type copyData(const std::string& query, const std::function<void (const char*, int)>& onRow);
+    void abortCopyOut();
 
 public:
     Connection(const std::string& url, const std::string& username, const std::string& password);
@@ -86,11 +116,52 @@ public:
     bool ping();
     long lastInsertId(const std::string& name);
     void lockTable(const std::string& tablename, bool exclusive);
+    void beginPipeline();
+    size_type syncPipeline();
+    void endPipeline();
+    tntdb::Statement prepareBulkLoad(const std::string& table, const std::vector<std::string>& columns);
+    size_type copyOut(const std::string& query, std::ostream& out);
+    size_type copyOutRows(const std::string& query, const std::function<void (const Row&)>& callback);
 
     PGconn* getPGConn() const      { return conn; }
     unsigned getNextStmtNumber()   { return ++stmtCounter; }
     void deallocateStatement(const std::string& stmtName);
     void deallocateStatements();
+
+    /** Enables the binary wire format for statements prepared afterwards.
+
+        Numbers, date and time values and blobs are then sent as parameters
+        and read from results without converting them to text. It is enabled
+        with the option `binary=1` in the dburl too.
+     */
+    void setBinaryFormat(bool sw)   { binaryFormat = sw; }
+    bool getBinaryFormat() const    { return binaryFormat; }
+
+    /** Sets the number of executions, after which a statement is prepared.
+
+        Before a statement is executed as the unnamed statement, which
+        needs no PREPARE and DEALLOCATE. The default is 2, so that
+        statements, which are executed just once, need one round trip. 1
+        prepares all statements on first execution and 0 never prepares
+        them. It is set with the option `prepare_threshold` in the dburl
+        too.
+     */
+    void setPrepareThreshold(unsigned n)  { prepareThreshold = n; }
+    unsigned getPrepareThreshold() const  { return prepareThreshold; }
+
+    // Methods for pipeline mode. The queries are sent and queued for the
+    // next sync point, where processPipeline reads the results. When
+    // `last` is passed, the result of the last query is returned there.
+    bool inPipeline() const         { return pipelineMode; }
+    void sendQuery(const std::string& query, int nParams, const Oid* paramTypes,
+        const char* const* paramValues, const int* paramLengths, const int* paramFormats, int resultFormat);
+    void sendPrepare(const std::string& stmtName, const std::string& query, int nParams, const Oid* paramTypes);
+    void sendQueryPrepared(const std::string& stmtName, const std::string& query, int nParams,
+        const char* const* paramValues, const int* paramLengths, const int* paramFormats, int resultFormat);
+    void processPipeline(PGresult** last = 0);
+    // Reads and discards the pending results after a failure in pipeline
+    // mode, so that the pipeline mode can be left.
+    void discardPipeline();
 };
 
 /// @cond internal
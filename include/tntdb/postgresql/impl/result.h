@@ -31,6 +31,7 @@
 
 #include <tntdb/iface/iresult.h>
 #include <tntdb/bits/connection.h>
+#include <tntdb/impl/resultschema.h>
 #include <libpq-fe.h>
 
 namespace tntdb
@@ -40,12 +41,17 @@ namespace postgresql
 class Result : public IResult
 {
     PGresult* _result;
+    std::shared_ptr<const ResultSchema> _schema;
 
 public:
     explicit Result(PGresult* result);
+    /// Creates a result, which shares the column names with a previous result of the same query.
+    Result(PGresult* result, const std::shared_ptr<const ResultSchema>& schema);
     ~Result();
 
     PGresult* getPGresult() const  { return _result; }
+    const ResultSchema& getSchema() const  { return *_schema; }
+    const std::shared_ptr<const ResultSchema>& getSharedSchema() const  { return _schema; }
 
     Row getRow(size_type tup_num) const;
     size_type size() const;
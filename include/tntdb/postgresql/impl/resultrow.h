@@ -56,6 +56,8 @@ public:
     Value getValueByNumber(size_type field_num) const;
     Value getValueByName(const std::string& field_name) const;
     std::string getColumnName(size_type field_num) const;
+    size_type getFieldNumber(const std::string& field_name) const;
+    const ResultSchema* getSchema() const;
 
     size_type getRowNumber() const   { return _rownumber; }
     PGresult* getPGresult() const;
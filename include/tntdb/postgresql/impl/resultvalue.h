@@ -47,6 +47,16 @@ class ResultValue : public IValue
     unsigned _rownumber;
     int _tup_num;
 
+    // values of results of statements using the binary format are decoded
+    // depending on the type of the column
+    bool isBinary() const;
+    Oid getType() const;
+    const char* getValue() const;
+    int getLength() const;
+
+    template <typename T> T getInteger() const;
+    template <typename T> T getFloatValue() const;
+
 public:
     ResultValue(const std::shared_ptr<Result>& resultref, const Result& result, unsigned rownumber, int tup_num);
     ResultValue(const Result& result, unsigned rownumber, int tup_num);
@@ -72,6 +82,8 @@ public:
     virtual Date getDate() const;
     virtual Time getTime() const;
     virtual Datetime getDatetime() const;
+    virtual const char* getStringData(std::size_t& length) const;
+    virtual const char* getBlobData(std::size_t& length) const;
 
     std::string getString() const    { std::string ret; getString(ret); return ret; }
 };
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_POSTGRESQL_IMPL_SINGLEROWCURSOR_H
+#define TNTDB_POSTGRESQL_IMPL_SINGLEROWCURSOR_H
+
+#include <tntdb/iface/icursor.h>
+#include <tntdb/postgresql/impl/statement.h>
+#include <tntdb/bits/result.h>
+#include <tntdb/impl/resultschema.h>
+
+namespace tntdb
+{
+namespace postgresql
+{
+/**
+ * Cursor, which streams the rows of a running query.
+ *
+ * The query is sent without waiting for the result and the rows are read in
+ * single row mode or, when libpq supports it and fetchsize is greater than
+ * 1, in chunks of fetchsize rows.
+ * No server side cursor and no transaction is needed, but the connection
+ * is busy until all rows are read or the cursor is destroyed.
+ */
+class SingleRowCursor : public ICursor
+{
+    Statement& _stmt;
+    unsigned _fetchSize;
+    bool _sent;
+    bool _active;   // results are pending on the connection
+
+    std::shared_ptr<const ResultSchema> _schema;
+    tntdb::Result _currentResult;
+    unsigned _currentRow;
+
+    PGconn* getPGConn()            { return _stmt.getPGConn(); }
+    void send();
+    void discard();
+
+public:
+    SingleRowCursor(Statement& statement, unsigned fetchSize);
+    ~SingleRowCursor();
+
+    // method for ICursor
+    Row fetch();
+};
+}
+}
+
+#endif // TNTDB_POSTGRESQL_IMPL_SINGLEROWCURSOR_H
@@ -53,21 +53,31 @@ class Statement : public IStatement
     {
         bool isNull;
         std::string value;
+        // data of the caller, which is sent instead of value
+        const char* ref;
+        unsigned refLength;
 #ifndef HAVE_PQPREPARE
         std::string type;
 #endif
 
     public:
-#ifndef HAVE_PQPREPARE
         valueType()
-          : type("text")
-          { }
+          : isNull(true),
+            ref(0),
+            refLength(0)
+#ifndef HAVE_PQPREPARE
+            , type("text")
 #endif
-        void setNull()            { isNull = true; }
-        void setValue(const std::string& v)
-                                  { value = v; isNull = false; }
-        const char* getValue()    { return isNull ? 0 : value.data(); }
-        unsigned getLength()      { return isNull ? 0 : value.size(); }
+          { }
+        void setNull()            { isNull = true; ref = 0; }
+        void setValue(std::string&& v)
+                                  { value = std::move(v); ref = 0; isNull = false; }
+        void setRef(const char* data, unsigned length)
+                                  { ref = data; refLength = length; isNull = false; }
+        // copies referenced data, so that the caller may release it
+        void keep()               { if (ref) { value.assign(ref, refLength); ref = 0; } }
+        const char* getValue()    { return isNull ? 0 : ref ? ref : value.data(); }
+        unsigned getLength()      { return isNull ? 0 : ref ? refLength : value.size(); }
 #ifndef HAVE_PQPREPARE
         void setType(const std::string& t)   { type = t; }
         const std::string& getType() const   { return type; }
@@ -81,25 +91,53 @@ class Statement : public IStatement
     std::vector<int> paramLengths;
     std::vector<int> paramFormats;
 
+    // In binary format the parameters are sent with their binary
+    // representation and declared types and the results are received in
+    // binary format. The types are fixed, when the statement is prepared.
+    bool binary;
+    std::vector<Oid> paramTypes;
+
+    // parameters of delayed executions
+    struct delayedType
+    {
+        valuesType values;
+        std::vector<int> paramFormats;
+    };
+
+    std::vector<delayedType> delayed;
+    size_type maxDelay;
+
+    // cursors stream the rows of the running query instead of using a
+    // server side cursor
+    bool streaming;
+
+    // number of executions as the unnamed statement
+    unsigned executions;
+
     // helper-methods for setting values
 
     unsigned hostvarId(const std::string& col);
 
-    template <typename T>
-    void setValue(const std::string& col, T data);
+    bool binaryParam(unsigned hv, Oid type) const;
+    void setParam(unsigned hv, std::string v, int format, Oid type = 0);
+    void setParamRef(unsigned hv, const char* data, std::size_t length, int format, Oid type);
+    void setFormat(unsigned hv, int format, Oid type);
 
     template <typename T>
-    void setStringValue(const std::string& col, T data, bool binary = false);
+    void setValue(unsigned hv, T data, Oid type);
 
     template <typename T>
-    void setIsoValue(const std::string& col, T data);
+    void setStringValue(unsigned hv, T data, bool binary = false);
 
 #ifndef HAVE_PQPREPARE
-    void setType(const std::string& col, const std::string& type);
+    void setType(unsigned hv, const std::string& type);
 #endif
 
     void doPrepare();
-    PGresult* execPrepared();
+    bool usePrepared();
+    PGresult* execStatement();
+    void setParams(delayedType& d);
+    size_type execDelayed(std::vector<delayedType>& d);
 
 public:
     Statement(Connection* conn, const std::string& query);
@@ -130,18 +168,59 @@ public:
     void setTime(const std::string& col, const Time& data);
     void setDatetime(const std::string& col, const Datetime& data);
 
+    size_type paramIndex(const std::string& col);
+    void setNullAt(size_type hv);
+    void setBoolAt(size_type hv, bool data);
+    void setShortAt(size_type hv, short data);
+    void setIntAt(size_type hv, int data);
+    void setLongAt(size_type hv, long data);
+    void setUnsignedShortAt(size_type hv, unsigned short data);
+    void setUnsignedAt(size_type hv, unsigned data);
+    void setUnsignedLongAt(size_type hv, unsigned long data);
+    void setInt32At(size_type hv, int32_t data);
+    void setUnsigned32At(size_type hv, uint32_t data);
+    void setInt64At(size_type hv, int64_t data);
+    void setUnsigned64At(size_type hv, uint64_t data);
+    void setDecimalAt(size_type hv, const Decimal& data);
+    void setFloatAt(size_type hv, float data);
+    void setDoubleAt(size_type hv, double data);
+    void setCharAt(size_type hv, char data);
+    void setStringAt(size_type hv, const std::string& data);
+    void setBlobAt(size_type hv, const Blob& data);
+    void setDateAt(size_type hv, const Date& data);
+    void setTimeAt(size_type hv, const Time& data);
+    void setDatetimeAt(size_type hv, const Datetime& data);
+
+    void setStringRef(const std::string& col, const char* data, std::size_t length);
+    void setBlobRef(const std::string& col, const char* data, std::size_t length);
+    void setStringRefAt(size_type hv, const char* data, std::size_t length);
+    void setBlobRefAt(size_type hv, const char* data, std::size_t length);
+    void takeString(const std::string& col, std::string&& data);
+    void takeStringAt(size_type hv, std::string&& data);
+
     size_type execute();
     tntdb::Result select();
     tntdb::Row selectRow();
     tntdb::Value selectValue();
     std::shared_ptr<ICursor> createCursor(unsigned fetchsize);
 
+    void maxNumDelay(size_type n);
+    size_type numDelayed() const;
+    size_type flush();
+
+    void setStreaming(bool sw);
+    bool isStreaming() const;
+
     // specific methods
     const std::string& getQuery() const     { return query; }
+    /// Sends the statement with the current parameters without waiting for the result.
+    void sendStatement();
     unsigned getNParams()                   { return values.size(); }
     const char* const* getParamValues();
     const int* getParamLengths();
     const int* getParamFormats()            { return &paramFormats[0]; }
+    const Oid* getParamTypes()              { return binary ? paramTypes.data() : 0; }
+    bool isBinary() const                   { return binary; }
     PGconn* getPGConn();
     Connection* getConnection()             { return conn; }
 };
@@ -3,7 +3,7 @@
 
 #include <tntdb/connection.h>
 #include <tntdb/statement.h>
-#include <unordered_map>
+#include <tntdb/statementcache.h>
 
 namespace tntdb
 {
@@ -14,6 +14,21 @@ namespace tntdb
    When the very same sql statement is prepared again, the stored handle is
    returned. This can speed up queries, which are executed multiple times.
 
+   The cache is bounded. By default it holds at most
+   StatementCache::defaultMaxSize statements and releases the least
+   recently used ones, when more are prepared. Released statements are
+   finalized on the backend. The limits and hit/miss counters are
+   accessible through getStatementCache().
+
+   Connections from a pool (tntdb::connectCached) keep their cache, when
+   they are returned to the pool, so that the next checkout finds the
+   statements still prepared. Delayed executions are flushed and the
+   delay, streaming, fetch size and host variables of the statements are
+   reset, when the connection is returned. The cache is dropped together with the
+   connection, when the pool closes it. A pooled connection is used by one
+   thread at a time, so the cache needs no locking. Statements taken from
+   the cache must not be used after the connection is returned.
+
    To use it the used connection class can be replaced with this one.
 
    @code
@@ -23,18 +38,24 @@ namespace tntdb
  */
 class PSCConnection : public Connection
 {
-    typedef std::unordered_map<std::string, Statement> CacheType;
-    std::shared_ptr<CacheType> _stmtCache;
+    std::shared_ptr<StatementCache> _stmtCache;
 
 public:
     PSCConnection() = default;
     PSCConnection(const PSCConnection&) = default;
     PSCConnection& operator=(const PSCConnection&) = default;
 
-    PSCConnection(tntdb::Connection conn)
-        : Connection(conn),
-          _stmtCache(std::make_shared<CacheType>())
-    { }
+    /** Wraps a connection and sets the limits of the cache
+
+        When the connection has a cache of its own, like connections from a
+        pool, that cache is used, so that the statements survive the return
+        of the connection to the pool. The limits are applied only, when
+        that cache is created; later wraps keep them, so that they are not
+        changed by each user of the pooled connection.
+     */
+    PSCConnection(tntdb::Connection conn,
+                  unsigned maxSize = StatementCache::defaultMaxSize,
+                  StatementCache::Duration maxAge = StatementCache::Duration(0));
 
     /** Create a new Statement object with the given query and store it in a cache
 
@@ -51,6 +72,10 @@ public:
     /// Clear the Statement cache used from prepare()
     void clearStatementCache()      { _stmtCache->clear(); }
 
+    /// Returns the cache to change its limits or read its statistics
+    StatementCache& getStatementCache()             { return *_stmtCache; }
+    const StatementCache& getStatementCache() const { return *_stmtCache; }
+
 };
 }
 
@@ -63,6 +63,9 @@ public:
     bool ping();
     long lastInsertId(const std::string& name);
     void lockTable(const std::string& tablename, bool exclusive);
+    void beginPipeline();
+    size_type syncPipeline();
+    void endPipeline();
 };
 
 }
@@ -44,6 +44,8 @@ class Statement : public IStatement
     Connection& _conn;
     typedef std::vector<tntdb::Statement> Statements;
     Statements statements;
+    size_type _maxNumDelay;
+    size_type _numDelayed;
 
 public:
     Statement(Connection& conn, const std::string& query, const std::string& limit = std::string(), const std::string& offset = std::string());
@@ -79,6 +81,12 @@ public:
     tntdb::Value selectValue();
     std::shared_ptr<ICursor> createCursor(unsigned fetchsize);
 
+    void maxNumDelay(size_type n);
+    size_type numDelayed() const;
+    size_type flush();
+
+    void setStreaming(bool sw);
+    bool isStreaming() const;
 };
 }
 }
@@ -61,6 +61,8 @@ class Connection : public IConnection
 {
     sqlite3* db;
     unsigned transactionActive;
+    bool implicitTransaction;
+    unsigned implicitRollbacks;
 
 public:
     explicit Connection(const char* conninfo);
@@ -81,6 +83,18 @@ public:
     void lockTable(const std::string& tablename, bool exclusive);
 
     sqlite3* getSqlite3() const  { return db; }
+
+    /// Starts a transaction for delayed statements unless one is active already.
+    /// All statements executed on the connection join it until it is
+    /// committed or rolled back, not just the delayed ones.
+    void beginImplicitTransaction();
+    /// Commits the transaction started with beginImplicitTransaction.
+    void commitImplicitTransaction();
+    /// Rolls back the transaction started with beginImplicitTransaction,
+    /// which discards the pending rows of all delayed statements.
+    void rollbackImplicitTransaction();
+    /// Returns the number of implicit transactions rolled back.
+    unsigned getImplicitRollbacks() const  { return implicitRollbacks; }
 };
 }
 }
@@ -30,7 +30,9 @@
 #define TNTDB_SQLITE_IMPL_CURSOR_H
 
 #include <tntdb/iface/icursor.h>
+#include <tntdb/impl/resultschema.h>
 #include <sqlite3.h>
+#include <memory>
 
 namespace tntdb
 {
@@ -41,6 +43,7 @@ class Statement;
 class Cursor : public ICursor
 {
     Statement* _stmt;
+    std::shared_ptr<const ResultSchema> _schema;
 
 public:
     explicit Cursor(Statement* stmt);
@@ -30,7 +30,10 @@
 #define TNTDB_SQLITE_IMPL_SQLSTATEMENT_H
 
 #include <tntdb/iface/istatement.h>
+#include <tntdb/impl/resultschema.h>
 #include <sqlite3.h>
+#include <memory>
+#include <vector>
 
 namespace tntdb
 {
@@ -38,10 +41,12 @@ namespace sqlite
 {
 class Connection;
 class Cursor;
+class StreamResult;
 
-class Statement : public IStatement
+class Statement : public IStatement, public std::enable_shared_from_this<Statement>
 {
     friend class Cursor;
+    friend class StreamResult;
 
     sqlite3_stmt* _stmt;
     Connection& _conn;
@@ -53,6 +58,28 @@ class Statement : public IStatement
     bool _needReset;
     void reset();
 
+    // strings taken over by takeString, indexed by bind index - 1; sized to
+    // the number of parameters on first use and never resized
+    std::vector<std::string> _strings;
+
+    // reads the column names of the current statement
+    std::shared_ptr<const ResultSchema> readSchema();
+
+    // incremented on each reset; a streaming result is valid as long as
+    // the statement is not reset by another operation
+    unsigned _generation;
+    bool _streaming;
+
+    // delayed statements are executed immediately in an implicit
+    // transaction, which is committed on flush and rolled back, when a
+    // statement fails
+    size_type _maxNumDelay;
+    size_type _numDelayed;
+    size_type _delayedChanges;
+    unsigned _implicitRollbacks;  // of the connection, when the first row was delayed
+
+    void discardRolledBack();
+
 public:
     Statement(Connection& conn, const std::string& query);
     ~Statement();
@@ -82,12 +109,49 @@ public:
     virtual void setTime(const std::string& col, const Time& data);
     virtual void setDatetime(const std::string& col, const Datetime& data);
 
+    virtual size_type paramIndex(const std::string& col);
+    virtual void setNullAt(size_type idx);
+    virtual void setBoolAt(size_type idx, bool data);
+    virtual void setShortAt(size_type idx, short data);
+    virtual void setIntAt(size_type idx, int data);
+    virtual void setLongAt(size_type idx, long data);
+    virtual void setUnsignedShortAt(size_type idx, unsigned short data);
+    virtual void setUnsignedAt(size_type idx, unsigned data);
+    virtual void setUnsignedLongAt(size_type idx, unsigned long data);
+    virtual void setInt32At(size_type idx, int32_t data);
+    virtual void setUnsigned32At(size_type idx, uint32_t data);
+    virtual void setInt64At(size_type idx, int64_t data);
+    virtual void setUnsigned64At(size_type idx, uint64_t data);
+    virtual void setDecimalAt(size_type idx, const Decimal& data);
+    virtual void setFloatAt(size_type idx, float data);
+    virtual void setDoubleAt(size_type idx, double data);
+    virtual void setCharAt(size_type idx, char data);
+    virtual void setStringAt(size_type idx, const std::string& data);
+    virtual void setBlobAt(size_type idx, const Blob& data);
+    virtual void setDateAt(size_type idx, const Date& data);
+    virtual void setTimeAt(size_type idx, const Time& data);
+    virtual void setDatetimeAt(size_type idx, const Datetime& data);
+
+    virtual void setStringRef(const std::string& col, const char* data, std::size_t length);
+    virtual void setBlobRef(const std::string& col, const char* data, std::size_t length);
+    virtual void setStringRefAt(size_type idx, const char* data, std::size_t length);
+    virtual void setBlobRefAt(size_type idx, const char* data, std::size_t length);
+    virtual void takeString(const std::string& col, std::string&& data);
+    virtual void takeStringAt(size_type idx, std::string&& data);
+
     virtual size_type execute();
     virtual tntdb::Result select();
     virtual tntdb::Row selectRow();
     virtual tntdb::Value selectValue();
     virtual std::shared_ptr<ICursor> createCursor(unsigned fetchsize);
 
+    virtual void maxNumDelay(size_type n);
+    virtual size_type numDelayed() const;
+    virtual size_type flush();
+
+    virtual void setStreaming(bool sw);
+    virtual bool isStreaming() const;
+
     // specific methods of sqlite-driver
     sqlite3_stmt* getStmt() const   { return _stmt; }
 };
@@ -30,7 +30,9 @@
 #define TNTDB_SQLITE_IMPL_STMTROW_H
 
 #include <tntdb/iface/irow.h>
+#include <tntdb/impl/resultschema.h>
 #include <tntdb/sqlite/impl/statement.h>
+#include <memory>
 
 namespace tntdb
 {
@@ -40,16 +42,24 @@ namespace tntdb
     class StmtRow : public IRow
     {
         sqlite3_stmt* stmt;
+        std::shared_ptr<const ResultSchema> schema;
 
       public:
         StmtRow(sqlite3_stmt* stmt_)
           : stmt(stmt_)
           { }
 
+        StmtRow(sqlite3_stmt* stmt_, const std::shared_ptr<const ResultSchema>& schema_)
+          : stmt(stmt_),
+            schema(schema_)
+          { }
+
         unsigned size() const;
         Value getValueByNumber(size_type field_num) const;
         Value getValueByName(const std::string& field_name) const;
         std::string getColumnName(size_type field_num) const;
+        size_type getFieldNumber(const std::string& field_name) const;
+        const ResultSchema* getSchema() const   { return schema.get(); }
 
         // specific methods of sqlite-driver
         sqlite3_stmt* getStmt() const   { return stmt; }
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_STATEMENTCACHE_H
+#define TNTDB_STATEMENTCACHE_H
+
+#include <tntdb/bits/statement.h>
+#include <chrono>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace tntdb
+{
+/** A bounded cache of prepared statements
+
+    The cache keeps at most `maxSize` statements. When it is full, the least
+    recently used statement is removed. Statements, which were not used for
+    longer than `maxAge`, are removed too. A removed statement is released
+    here, so the driver finalizes it on the backend as soon as no other
+    copies of the Statement exist.
+
+    A value of 0 for `maxSize` or `maxAge` disables the respective limit.
+ */
+class StatementCache
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::chrono::milliseconds Duration;
+
+    struct Statistics
+    {
+        unsigned long hits;
+        unsigned long misses;
+        unsigned long evictions;
+
+        Statistics()
+          : hits(0),
+            misses(0),
+            evictions(0)
+          { }
+    };
+
+private:
+    struct Entry
+    {
+        std::string key;
+        Statement stmt;
+        Clock::time_point lastUsed;
+        // fetch size after prepare, which reset restores
+        unsigned fetchSize;
+
+        Entry(const std::string& key_, const Statement& stmt_, Clock::time_point lastUsed_)
+          : key(key_),
+            stmt(stmt_),
+            lastUsed(lastUsed_),
+            fetchSize(stmt_.getFetchSize())
+          { }
+    };
+
+    // most recently used entry is at the front
+    typedef std::list<Entry> EntriesType;
+    typedef std::unordered_map<std::string, EntriesType::iterator> IndexType;
+
+    EntriesType _entries;
+    IndexType _index;
+    unsigned _maxSize;
+    Duration _maxAge;
+    Statistics _statistics;
+
+    bool expired(const Entry& entry, Clock::time_point now) const
+      { return _maxAge.count() > 0 && now - entry.lastUsed > _maxAge; }
+
+    void evict(EntriesType::iterator it);
+    void shrink(Clock::time_point now);
+
+public:
+    static const unsigned defaultMaxSize = 100;
+
+    explicit StatementCache(unsigned maxSize = defaultMaxSize, Duration maxAge = Duration(0))
+      : _maxSize(maxSize),
+        _maxAge(maxAge)
+      { }
+
+    /** Returns the statement stored with the given key.
+
+        When the key is not found, an empty Statement is returned.
+     */
+    Statement get(const std::string& key);
+
+    /// Stores the statement with the given key and applies the limits.
+    void put(const std::string& key, const Statement& stmt);
+
+    /// Removes the statement with the given key; returns true if found.
+    bool erase(const std::string& key);
+
+    /// Removes all statements from the cache.
+    void clear();
+
+    /** Resets the statements for the next user of the connection.
+
+        Delayed executions are flushed. Delay, streaming, fetch size and
+        host variables are set back to the state after prepare.
+     */
+    void reset();
+
+    unsigned size() const               { return _entries.size(); }
+
+    unsigned getMaxSize() const         { return _maxSize; }
+    void setMaxSize(unsigned n);
+
+    Duration getMaxAge() const          { return _maxAge; }
+    void setMaxAge(Duration d);
+
+    const Statistics& getStatistics() const  { return _statistics; }
+    void resetStatistics()              { _statistics = Statistics(); }
+};
+}
+
+#endif // TNTDB_STATEMENTCACHE_H
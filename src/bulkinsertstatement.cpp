@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/impl/bulkinsertstatement.h>
+#include <tntdb/blob.h>
+#include <tntdb/decimal.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <cxxtools/convert.h>
+
+namespace tntdb
+{
+BulkInsertStatement::BulkInsertStatement(const Statement& stmt, const std::vector<std::string>& columns)
+    : ForwardStatement(stmt)
+{
+    for (unsigned n = 0; n < columns.size(); ++n)
+        _hostvars[columns[n]] = 'c' + cxxtools::convert<std::string>(n);
+}
+
+// Unknown columns are passed unchanged, so that the driver reports them.
+const std::string& BulkInsertStatement::hostvar(const std::string& col) const
+{
+    std::map<std::string, std::string>::const_iterator it = _hostvars.find(col);
+    return it == _hostvars.end() ? col : it->second;
+}
+
+void BulkInsertStatement::setNull(const std::string& col)
+{
+    _impl->setNull(hostvar(col));
+}
+
+void BulkInsertStatement::setBool(const std::string& col, bool data)
+{
+    _impl->setBool(hostvar(col), data);
+}
+
+void BulkInsertStatement::setShort(const std::string& col, short data)
+{
+    _impl->setShort(hostvar(col), data);
+}
+
+void BulkInsertStatement::setInt(const std::string& col, int data)
+{
+    _impl->setInt(hostvar(col), data);
+}
+
+void BulkInsertStatement::setLong(const std::string& col, long data)
+{
+    _impl->setLong(hostvar(col), data);
+}
+
+void BulkInsertStatement::setUnsignedShort(const std::string& col, unsigned short data)
+{
+    _impl->setUnsignedShort(hostvar(col), data);
+}
+
+void BulkInsertStatement::setUnsigned(const std::string& col, unsigned data)
+{
+    _impl->setUnsigned(hostvar(col), data);
+}
+
+void BulkInsertStatement::setUnsignedLong(const std::string& col, unsigned long data)
+{
+    _impl->setUnsignedLong(hostvar(col), data);
+}
+
+void BulkInsertStatement::setInt32(const std::string& col, int32_t data)
+{
+    _impl->setInt32(hostvar(col), data);
+}
+
+void BulkInsertStatement::setUnsigned32(const std::string& col, uint32_t data)
+{
+    _impl->setUnsigned32(hostvar(col), data);
+}
+
+void BulkInsertStatement::setInt64(const std::string& col, int64_t data)
+{
+    _impl->setInt64(hostvar(col), data);
+}
+
+void BulkInsertStatement::setUnsigned64(const std::string& col, uint64_t data)
+{
+    _impl->setUnsigned64(hostvar(col), data);
+}
+
+void BulkInsertStatement::setDecimal(const std::string& col, const Decimal& data)
+{
+    _impl->setDecimal(hostvar(col), data);
+}
+
+void BulkInsertStatement::setFloat(const std::string& col, float data)
+{
+    _impl->setFloat(hostvar(col), data);
+}
+
+void BulkInsertStatement::setDouble(const std::string& col, double data)
+{
+    _impl->setDouble(hostvar(col), data);
+}
+
+void BulkInsertStatement::setChar(const std::string& col, char data)
+{
+    _impl->setChar(hostvar(col), data);
+}
+
+void BulkInsertStatement::setString(const std::string& col, const std::string& data)
+{
+    _impl->setString(hostvar(col), data);
+}
+
+void BulkInsertStatement::setBlob(const std::string& col, const Blob& data)
+{
+    _impl->setBlob(hostvar(col), data);
+}
+
+void BulkInsertStatement::setDate(const std::string& col, const Date& data)
+{
+    _impl->setDate(hostvar(col), data);
+}
+
+void BulkInsertStatement::setTime(const std::string& col, const Time& data)
+{
+    _impl->setTime(hostvar(col), data);
+}
+
+void BulkInsertStatement::setDatetime(const std::string& col, const Datetime& data)
+{
+    _impl->setDatetime(hostvar(col), data);
+}
+
+void BulkInsertStatement::setUString(const std::string& col, const cxxtools::String& data)
+{
+    _impl->setUString(hostvar(col), data);
+}
+
+BulkInsertStatement::size_type BulkInsertStatement::paramIndex(const std::string& col)
+{
+    return _impl->paramIndex(hostvar(col));
+}
+
+void BulkInsertStatement::setStringRef(const std::string& col, const char* data, std::size_t length)
+{
+    _impl->setStringRef(hostvar(col), data, length);
+}
+
+void BulkInsertStatement::setBlobRef(const std::string& col, const char* data, std::size_t length)
+{
+    _impl->setBlobRef(hostvar(col), data, length);
+}
+
+void BulkInsertStatement::takeString(const std::string& col, std::string&& data)
+{
+    _impl->takeString(hostvar(col), std::move(data));
+}
+}
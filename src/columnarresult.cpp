@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/impl/columnarresult.h>
+#include <tntdb/impl/value.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/blob.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <tntdb/error.h>
+
+namespace tntdb
+{
+ColumnarResult::ColumnarResult(const std::shared_ptr<const ResultSchema>& schema)
+  : _schema(schema),
+    _columns(schema->size())
+{ }
+
+Row ColumnarResult::getRow(size_type tup_num) const
+{
+    return Row(std::make_shared<ColumnarRow>(shared_from_this(), tup_num));
+}
+
+ColumnarResult::size_type ColumnarResult::size() const
+{
+    return _columns.empty() ? 0 : _columns[0].ends.size();
+}
+
+ColumnarResult::size_type ColumnarResult::getFieldCount() const
+{
+    return _columns.size();
+}
+
+void ColumnarResult::add(size_type field_num, const char* data, std::string::size_type length)
+{
+    Column& column = _columns[field_num];
+    column.data.append(data, length);
+    column.ends.push_back(column.data.size());
+    column.nulls.push_back(false);
+}
+
+void ColumnarResult::addNull(size_type field_num)
+{
+    Column& column = _columns[field_num];
+    column.ends.push_back(column.data.size());
+    column.nulls.push_back(true);
+}
+
+const char* ColumnarResult::getData(size_type tup_num, size_type field_num, std::string::size_type& length) const
+{
+    const Column& column = _columns[field_num];
+    std::string::size_type begin = tup_num == 0 ? 0 : column.ends[tup_num - 1];
+    length = column.ends[tup_num] - begin;
+    return column.data.data() + begin;
+}
+
+ColumnarRow::size_type ColumnarRow::size() const
+{
+    return _result->getFieldCount();
+}
+
+Value ColumnarRow::getValueByNumber(size_type field_num) const
+{
+    return Value(std::make_shared<ColumnarValue>(_result, _tupNum, field_num));
+}
+
+Value ColumnarRow::getValueByName(const std::string& field_name) const
+{
+    return getValueByNumber(_result->getSchema().getFieldNumber(field_name));
+}
+
+std::string ColumnarRow::getColumnName(size_type field_num) const
+{
+    return _result->getSchema().getName(field_num);
+}
+
+ColumnarRow::size_type ColumnarRow::getFieldNumber(const std::string& field_name) const
+{
+    return _result->getSchema().getFieldNumber(field_name);
+}
+
+const ResultSchema* ColumnarRow::getSchema() const
+{
+    return &_result->getSchema();
+}
+
+std::string ColumnarValue::str() const
+{
+    std::string::size_type length;
+    const char* data = _result->getData(_tupNum, _fieldNum, length);
+    return std::string(data, length);
+}
+
+bool ColumnarValue::isNull() const
+{
+    return _result->isNull(_tupNum, _fieldNum);
+}
+
+// The text is moved into the temporary ValueImpl, so short values are
+// converted without allocating memory.
+template <typename T>
+T ColumnarValue::convert(T (ValueImpl::*getter)() const) const
+{
+    if (isNull())
+        throw NullValue();
+    return (ValueImpl(str()).*getter)();
+}
+
+bool ColumnarValue::getBool() const
+{
+    return convert(&ValueImpl::getBool);
+}
+
+short ColumnarValue::getShort() const
+{
+    return convert(&ValueImpl::getShort);
+}
+
+int ColumnarValue::getInt() const
+{
+    return convert(&ValueImpl::getInt);
+}
+
+long ColumnarValue::getLong() const
+{
+    return convert(&ValueImpl::getLong);
+}
+
+unsigned short ColumnarValue::getUnsignedShort() const
+{
+    return convert(&ValueImpl::getUnsignedShort);
+}
+
+unsigned ColumnarValue::getUnsigned() const
+{
+    return convert(&ValueImpl::getUnsigned);
+}
+
+unsigned long ColumnarValue::getUnsignedLong() const
+{
+    return convert(&ValueImpl::getUnsignedLong);
+}
+
+int32_t ColumnarValue::getInt32() const
+{
+    return convert(&ValueImpl::getInt32);
+}
+
+uint32_t ColumnarValue::getUnsigned32() const
+{
+    return convert(&ValueImpl::getUnsigned32);
+}
+
+int64_t ColumnarValue::getInt64() const
+{
+    return convert(&ValueImpl::getInt64);
+}
+
+uint64_t ColumnarValue::getUnsigned64() const
+{
+    return convert(&ValueImpl::getUnsigned64);
+}
+
+Decimal ColumnarValue::getDecimal() const
+{
+    return convert(&ValueImpl::getDecimal);
+}
+
+float ColumnarValue::getFloat() const
+{
+    return convert(&ValueImpl::getFloat);
+}
+
+double ColumnarValue::getDouble() const
+{
+    return convert(&ValueImpl::getDouble);
+}
+
+char ColumnarValue::getChar() const
+{
+    return convert(&ValueImpl::getChar);
+}
+
+Date ColumnarValue::getDate() const
+{
+    return convert(&ValueImpl::getDate);
+}
+
+Time ColumnarValue::getTime() const
+{
+    return convert(&ValueImpl::getTime);
+}
+
+Datetime ColumnarValue::getDatetime() const
+{
+    return convert(&ValueImpl::getDatetime);
+}
+
+void ColumnarValue::getString(std::string& ret) const
+{
+    if (isNull())
+        throw NullValue();
+    std::string::size_type length;
+    const char* data = _result->getData(_tupNum, _fieldNum, length);
+    ret.assign(data, length);
+}
+
+void ColumnarValue::getBlob(Blob& ret) const
+{
+    if (isNull())
+        throw NullValue();
+    std::string::size_type length;
+    const char* data = _result->getData(_tupNum, _fieldNum, length);
+    ret.assign(data, length);
+}
+
+const char* ColumnarValue::getStringData(std::size_t& length) const
+{
+    if (isNull())
+        throw NullValue();
+    return _result->getData(_tupNum, _fieldNum, length);
+}
+
+const char* ColumnarValue::getBlobData(std::size_t& length) const
+{
+    return getStringData(length);
+}
+
+}
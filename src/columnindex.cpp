@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2005 Tommi Maekitalo
+ * Copyright (C) 2026 Tommi Maekitalo
  *
  * This library is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
@@ -26,27 +26,25 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-#include <tntdb/mysql/impl/rowcontainer.h>
-#include <tntdb/row.h>
-#include <cxxtools/log.h>
+#include <tntdb/columnindex.h>
+#include <tntdb/iface/irow.h>
+#include <tntdb/impl/resultschema.h>
 
 namespace tntdb
 {
-namespace mysql
+unsigned ColumnIndex::resolve(const IRow& row) const
 {
-Row RowContainer::getRow(size_type tup_num) const
-{
-    return Row(rows[tup_num]);
-}
+    const ResultSchema* schema = row.getSchema();
+    if (schema == 0)
+        return row.getFieldNumber(_name);
 
-RowContainer::size_type RowContainer::size() const
-{
-    return rows.size();
-}
+    if (schema->getId() != _schemaId)
+    {
+        _fieldNum = schema->getFieldNumber(_name);
+        _schemaId = schema->getId();
+    }
 
-RowContainer::size_type RowContainer::getFieldCount() const
-{
-    return rows.empty() ? 0 : (*rows.begin())->size();
-}
+    return _fieldNum;
 }
+
 }
@@ -127,4 +127,49 @@ unsigned getMaxPoolSize()
 {
     return connectionPools.getMaximumSize();
 }
+
+void setPoolMaxActive(unsigned n)
+{
+    connectionPools.setMaxActive(n);
+}
+
+void setPoolCheckoutTimeout(unsigned ms)
+{
+    connectionPools.setCheckoutTimeout(ms);
+}
+
+void setPoolMinIdle(unsigned n)
+{
+    connectionPools.setMinIdle(n);
+}
+
+void setPoolMaxLifetime(unsigned ms)
+{
+    connectionPools.setMaxLifetime(ms);
+}
+
+void setPoolIdleTimeout(unsigned ms)
+{
+    connectionPools.setIdleTimeout(ms);
+}
+
+void startPoolMaintenance(unsigned intervalMs)
+{
+    connectionPools.startMaintenance(intervalMs);
+}
+
+void stopPoolMaintenance()
+{
+    connectionPools.stopMaintenance();
+}
+
+void setPoolValidationPolicy(ConnectionPool::ValidationPolicy policy, unsigned intervalMs)
+{
+    connectionPools.setValidationPolicy(policy, intervalMs);
+}
+
+unsigned validateCached()
+{
+    return connectionPools.validate();
+}
 }
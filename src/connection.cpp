@@ -31,7 +31,10 @@
 #include <tntdb/row.h>
 #include <tntdb/value.h>
 #include <tntdb/statement.h>
+#include <tntdb/impl/bulkinsertstatement.h>
+#include <cxxtools/convert.h>
 #include <cxxtools/log.h>
+#include <ostream>
 
 log_define("tntdb.connection")
 
@@ -100,6 +103,117 @@ Statement Connection::prepareWithLimit(const std::string& query, const std::stri
     return _conn->prepareWithLimit(query, limit, offset);
 }
 
+Statement Connection::prepareBulkLoad(const std::string& table, const std::vector<std::string>& columns)
+{
+    log_trace("Connection::prepareBulkLoad(\"" << table << "\", " << columns.size() << " columns)");
+
+    return _conn->prepareBulkLoad(table, columns);
+}
+
+Connection::size_type Connection::copyOut(const std::string& query, std::ostream& out)
+{
+    log_trace("Connection::copyOut(\"" << query << "\")");
+
+    return _conn->copyOut(query, out);
+}
+
+Connection::size_type Connection::copyOutRows(const std::string& query, const std::function<void (const Row&)>& callback)
+{
+    log_trace("Connection::copyOutRows(\"" << query << "\")");
+
+    return _conn->copyOutRows(query, callback);
+}
+
+void IConnection::beginPipeline()
+{
+}
+
+IConnection::size_type IConnection::syncPipeline()
+{
+    return 0;
+}
+
+void IConnection::endPipeline()
+{
+}
+
+Statement IConnection::prepareBulkLoad(const std::string& table, const std::vector<std::string>& columns)
+{
+    std::string names;
+    std::string values;
+    for (unsigned n = 0; n < columns.size(); ++n)
+    {
+        if (n > 0)
+        {
+            names += ", ";
+            values += ", ";
+        }
+        names += columns[n];
+        values += ":c";
+        values += cxxtools::convert<std::string>(n);
+    }
+
+    Statement stmt(std::make_shared<BulkInsertStatement>(
+        prepare("insert into " + table + " (" + names + ") values (" + values + ')'), columns));
+    stmt.maxNumDelay(1000);
+    return stmt;
+}
+
+IConnection::size_type IConnection::copyOut(const std::string& query, std::ostream& out)
+{
+    std::string line;
+    std::string value;
+    return copyOutRows(query, [&line, &value, &out] (const Row& row) {
+        line.clear();
+        for (Row::size_type n = 0; n < row.size(); ++n)
+        {
+            if (n > 0)
+                line += '\t';
+
+            Value v = row.getValue(n);
+            if (v.isNull())
+            {
+                line += "\\N";
+                continue;
+            }
+
+            v.getString(value);
+            for (std::string::const_iterator it = value.begin(); it != value.end(); ++it)
+            {
+                switch (*it)
+                {
+                    case '\\': line += "\\\\"; break;
+                    case '\t': line += "\\t"; break;
+                    case '\n': line += "\\n"; break;
+                    case '\r': line += "\\r"; break;
+                    default: line += *it;
+                }
+            }
+        }
+
+        line += '\n';
+        out.write(line.data(), line.size());
+    });
+}
+
+IConnection::size_type IConnection::copyOutRows(const std::string& query, const std::function<void (const Row&)>& callback)
+{
+    Statement stmt = prepare(query);
+    size_type count = 0;
+    for (Statement::const_iterator it = stmt.begin(); it != stmt.end(); ++it)
+    {
+        callback(*it);
+        ++count;
+    }
+
+    return count;
+}
+
+StatementCache* IConnection::getStatementCache(unsigned /* maxSize */, std::chrono::milliseconds /* maxAge */)
+{
+    return 0;
+}
+
 std::string IConnection::url(const std::string& url, const std::string& username, const std::string& password)
 {
     enum {
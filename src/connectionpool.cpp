@@ -29,7 +29,12 @@
 #include <tntdb/connectionpool.h>
 #include <tntdb/connect.h>
 #include <tntdb/impl/poolconnection.h>
+#include <tntdb/statementcache.h>
+#include <tntdb/error.h>
 #include <cxxtools/log.h>
+#include <algorithm>
+#include <functional>
+#include <thread>
 
 log_define("tntdb.connectionpool")
 
@@ -38,60 +43,471 @@ namespace tntdb
 ////////////////////////////////////////////////////////////////////////
 // ConnectionPool
 //
+const unsigned ConnectionPool::WaitStatistics::buckets;
+const unsigned ConnectionPool::WaitStatistics::bucketLimits[] =
+    { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000 };
+
+ConnectionPool::ConnectionPool(const std::string& url, const std::string& username, const std::string& password, unsigned maxSpare, unsigned shards)
+    : _url(url),
+      _username(username),
+      _password(password),
+      _currentSize(0),
+      _maxSpare(maxSpare),
+      _validationPolicy(validateAlways),
+      _validationInterval(0),
+      _checkoutValidations(0),
+      _minIdle(0),
+      _maxLifetime(0),
+      _idleTimeout(0),
+      _activeCount(0),
+      _maxActive(0),
+      _checkoutTimeout(0)
+{
+    if (shards == 0)
+        shards = std::max(std::thread::hardware_concurrency(), 1u);
+
+    log_debug("create connection pool with " << shards << " shards");
+
+    _shards.reserve(shards);
+    for (unsigned n = 0; n < shards; ++n)
+        _shards.emplace_back(new Shard());
+}
+
+std::size_t ConnectionPool::shardIndex() const
+{
+    return std::hash<std::thread::id>()(std::this_thread::get_id()) % _shards.size();
+}
+
+bool ConnectionPool::take(IdleConnection& conn)
+{
+    if (_currentSize == 0)
+        return false;
+
+    // look into the shard of the current thread first and steal from the
+    // other shards only when it is empty
+    std::size_t start = shardIndex();
+
+    for (std::size_t n = 0; n < _shards.size(); ++n)
+    {
+        Shard& shard = *_shards[(start + n) % _shards.size()];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.connections.empty())
+        {
+            conn = std::move(shard.connections.back());
+            shard.connections.pop_back();
+            --_currentSize;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ConnectionPool::needsValidation(const IdleConnection& conn, Clock::time_point now) const
+{
+    switch (_validationPolicy.load())
+    {
+        case validateAlways:
+            return true;
+
+        case validateIdle:
+            return now - conn.lastUsed > std::chrono::milliseconds(_validationInterval.load());
+
+        case validateAfterError:
+            return conn.suspect && *conn.suspect;
+
+        default:
+            return false;
+    }
+}
+
+bool ConnectionPool::expired(Clock::time_point created, Clock::time_point now) const
+{
+    unsigned maxLifetime = _maxLifetime;
+    return maxLifetime > 0 && now - created > std::chrono::milliseconds(maxLifetime);
+}
+
+bool ConnectionPool::checkout(IdleConnection& conn)
+{
+    if (_maxActive == 0)
+    {
+        ++_activeCount;
+        return take(conn);
+    }
+
+    std::unique_lock<std::mutex> lock(_waitMutex);
+    ++_waitStatistics.checkouts;
+
+    // threads already waiting are served first
+    if (_waiters.empty())
+    {
+        if (take(conn))
+        {
+            ++_activeCount;
+            return true;
+        }
+
+        unsigned maxActive = _maxActive;
+        if (maxActive == 0 || _activeCount + _currentSize < maxActive)
+        {
+            ++_activeCount;
+            return false;
+        }
+    }
+
+    log_debug("wait for connection; " << _activeCount << " connections active, " << _waiters.size() << " waiting");
+
+    Waiter waiter;
+    _waiters.push_back(&waiter);
+
+    Clock::time_point start = Clock::now();
+    unsigned timeout = _checkoutTimeout;
+    if (timeout > 0)
+        waiter.condition.wait_for(lock, std::chrono::milliseconds(timeout), [&waiter] { return waiter.ready; });
+    else
+        waiter.condition.wait(lock, [&waiter] { return waiter.ready; });
+
+    unsigned long ms = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+    unsigned bucket = 0;
+    while (bucket < WaitStatistics::buckets - 1 && ms >= WaitStatistics::bucketLimits[bucket])
+        ++bucket;
+    ++_waitStatistics.waits;
+    ++_waitStatistics.histogram[bucket];
+
+    if (!waiter.ready)
+    {
+        _waiters.erase(std::find(_waiters.begin(), _waiters.end(), &waiter));
+        ++_waitStatistics.timeouts;
+        log_warn("no connection available after " << ms << " ms");
+        throw PoolTimeout();
+    }
+
+    // the active count was already incremented by the releasing thread
+    conn = std::move(waiter.conn);
+    return static_cast<bool>(conn.connection);
+}
+
+bool ConnectionPool::reserve()
+{
+    if (_maxActive == 0)
+    {
+        ++_activeCount;
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(_waitMutex);
+    unsigned maxActive = _maxActive;
+    if (maxActive > 0 && _activeCount + _currentSize >= maxActive)
+        return false;
+
+    ++_activeCount;
+    return true;
+}
+
+bool ConnectionPool::handOff(IdleConnection& conn)
+{
+    // _waitMutex must be locked here
+    if (_waiters.empty())
+        return false;
+
+    Waiter* waiter = _waiters.front();
+    _waiters.pop_front();
+    waiter->conn = std::move(conn);
+    waiter->ready = true;
+    waiter->condition.notify_one();
+    return true;
+}
+
+void ConnectionPool::store(IdleConnection& conn)
+{
+    unsigned maxSpare = _maxSpare;
+    if (++_currentSize > maxSpare && maxSpare > 0)
+    {
+        --_currentSize;
+        log_debug("don't reuse connection " << conn.connection << " max spare " << maxSpare << " reached");
+        return;
+    }
+
+    Shard& shard = *_shards[shardIndex()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.connections.emplace_back(std::move(conn));
+}
+
 Connection ConnectionPool::connect()
 {
     log_debug("ConnectionPool::connect()");
 
     log_debug("current pool size " << getCurrentSize() << " max " << getMaxSpare());
 
-    std::lock_guard<std::mutex> lock(_mutex);
+    // The connection is checked without holding a lock, so other threads
+    // are not blocked by the round trip of ping().
+    IdleConnection c;
+    if (checkout(c))
+    {
+        do
+        {
+            Clock::time_point now = Clock::now();
+            if (expired(c.created, now))
+            {
+                log_debug("drop connection from pool after max lifetime");
+            }
+            else
+            {
+                if (!needsValidation(c, now))
+                    break;
+
+                ++_checkoutValidations;
+                if (c.connection->ping())
+                    break;
+
+                log_warn("drop dead connection from pool");
+            }
 
-    std::shared_ptr<IConnection> c;
-    while (!_connectionPool.empty()
-        && !_connectionPool.back()->ping())
+            c.reset();
+        } while (take(c));
+    }
+
+    if (!c.connection)
     {
-        log_warn("drop dead connection from pool");
-        _connectionPool.pop_back();
+        try
+        {
+            c.connection = tntdb::connect(_url, _username, _password).getImpl();
+            c.created = Clock::now();
+        }
+        catch (...)
+        {
+            discard();
+            throw;
+        }
     }
 
-    if (_connectionPool.empty())
+    return Connection(std::make_shared<PoolConnection>(std::move(c.connection), std::move(c.statementCache), std::move(c.suspect), c.created, *this));
+}
+
+void ConnectionPool::put(std::shared_ptr<IConnection>& conn, std::shared_ptr<StatementCache>& statementCache, Clock::time_point created, const std::shared_ptr<bool>& suspect)
+{
+    Clock::time_point now = Clock::now();
+    IdleConnection c(conn, statementCache, created, now, suspect);
+    statementCache.reset();
+    conn.reset();
+    if (expired(created, now))
+    {
+        log_debug("don't reuse connection " << c.connection << " after max lifetime");
+        c.reset();
+    }
+
+    release(c);
+}
+
+void ConnectionPool::discard()
+{
+    // the released slot allows the waiting thread to open a new connection
+    IdleConnection c;
+    release(c);
+}
+
+void ConnectionPool::release(IdleConnection& conn)
+{
+    if (_maxActive > 0)
     {
-        c = tntdb::connect(_url, _username, _password).getImpl();
+        std::lock_guard<std::mutex> lock(_waitMutex);
+        if (handOff(conn))
+            return;
+
+        --_activeCount;
+        if (conn.connection)
+            store(conn);
     }
     else
     {
-        c = std::move(_connectionPool.back());
-        _connectionPool.pop_back();
+        --_activeCount;
+        if (conn.connection)
+            store(conn);
     }
-    
-    return Connection(std::make_shared<PoolConnection>(std::move(c), *this));
 }
 
-void ConnectionPool::put(std::shared_ptr<IConnection>& conn)
+void ConnectionPool::wakeWaiters()
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    // _waitMutex must be locked here
+    unsigned maxActive = _maxActive;
+    while (!_waiters.empty() && (maxActive == 0 || _activeCount + _currentSize < maxActive))
+    {
+        ++_activeCount;
+        IdleConnection c;
+        handOff(c);
+    }
+}
 
-    if (_maxSpare == 0 || _connectionPool.size() < _maxSpare)
-        _connectionPool.emplace_back(conn);
-    else
-        log_debug("don't reuse connection " << conn << " max spare " << _maxSpare << " reached");
+void ConnectionPool::setMaxActive(unsigned n)
+{
+    std::lock_guard<std::mutex> lock(_waitMutex);
+    _maxActive = n;
+
+    // a higher limit lets waiting threads open new connections
+    wakeWaiters();
+}
+
+ConnectionPool::WaitStatistics ConnectionPool::getWaitStatistics()
+{
+    std::lock_guard<std::mutex> lock(_waitMutex);
+    return _waitStatistics;
+}
+
+void ConnectionPool::resetWaitStatistics()
+{
+    std::lock_guard<std::mutex> lock(_waitMutex);
+    _waitStatistics = WaitStatistics();
 }
 
 void ConnectionPool::drop(unsigned keep)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    // connections are closed after releasing the locks
+    std::vector<IdleConnection> dropped;
+
+    for (auto& shard: _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        while (!shard->connections.empty() && _currentSize > keep)
+        {
+            dropped.emplace_back(std::move(shard->connections.back()));
+            shard->connections.pop_back();
+            --_currentSize;
+        }
+    }
 
-    if (_connectionPool.size() > keep)
-        _connectionPool.resize(keep);
+    log_debug(dropped.size() << " connections dropped");
 }
 
 void ConnectionPool::setMaxSpare(unsigned m)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-
     _maxSpare = m;
-    if (_connectionPool.size() > _maxSpare)
-        _connectionPool.resize(_maxSpare);
+    if (m > 0)
+        drop(m);
+}
+
+unsigned ConnectionPool::validate()
+{
+    unsigned count = 0;
+
+    for (auto& shard: _shards)
+    {
+        // ping the connections of one shard while they are taken out, so
+        // that no lock is held during the round trips; meanwhile they count
+        // as active, so that maxActive is respected
+        std::vector<IdleConnection> connections;
+
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            connections.swap(shard->connections);
+            _activeCount += connections.size();
+            _currentSize -= connections.size();
+        }
+
+        // valid connections go to waiting threads or back to the pool;
+        // the slots of dead ones let waiting threads open new connections
+        for (auto& c: connections)
+        {
+            if (c.connection->ping())
+            {
+                if (c.suspect)
+                    *c.suspect = false;
+            }
+            else
+            {
+                log_warn("drop dead connection from pool");
+                c.reset();
+                ++count;
+            }
+
+            release(c);
+        }
+    }
+
+    return count;
+}
+
+void ConnectionPool::setValidationPolicy(ValidationPolicy policy, unsigned intervalMs)
+{
+    _validationPolicy = policy;
+    _validationInterval = intervalMs;
+}
+
+unsigned ConnectionPool::maintain()
+{
+    Clock::time_point now = Clock::now();
+    unsigned minIdle = _minIdle;
+    unsigned idleTimeout = _idleTimeout;
+
+    // connections are closed after releasing the locks
+    std::vector<IdleConnection> retired;
+
+    for (auto& shard: _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        auto& connections = shard->connections;
+        for (auto it = connections.begin(); it != connections.end(); )
+        {
+            if (expired(it->created, now)
+                || (idleTimeout > 0
+                    && now - it->lastUsed > std::chrono::milliseconds(idleTimeout)
+                    && _currentSize > minIdle))
+            {
+                retired.emplace_back(std::move(*it));
+                it = connections.erase(it);
+                --_currentSize;
+            }
+            else
+                ++it;
+        }
+    }
+
+    unsigned count = retired.size();
+    retired.clear();
+
+    if (count > 0)
+    {
+        log_debug(count << " connections retired");
+
+        // the freed slots let waiting threads open new connections
+        if (_maxActive > 0)
+        {
+            std::lock_guard<std::mutex> lock(_waitMutex);
+            wakeWaiters();
+        }
+    }
+
+    if (_validationPolicy == validateBackground)
+        count += validate();
+
+    unsigned maxSpare = _maxSpare;
+    if (maxSpare > 0 && minIdle > maxSpare)
+        minIdle = maxSpare;
+
+    unsigned currentSize = _currentSize;
+    if (currentSize < minIdle)
+    {
+        log_debug("open " << (minIdle - currentSize) << " connections to " << _url);
+
+        // the new connections count as active until they are put into
+        // the pool, so that maxActive is respected
+        for (unsigned n = currentSize; n < minIdle && reserve(); ++n)
+        {
+            try
+            {
+                std::shared_ptr<IConnection> conn = tntdb::connect(_url, _username, _password).getImpl();
+                std::shared_ptr<StatementCache> statementCache;
+                put(conn, statementCache, Clock::now(), std::shared_ptr<bool>());
+            }
+            catch (const std::exception& e)
+            {
+                log_warn("failed to open connection to " << _url << ": " << e.what());
+                discard();
+                break;
+            }
+        }
+    }
+
+    return count;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -101,23 +517,42 @@ Connection ConnectionPools::connect(const std::string& url, const std::string& u
 {
     log_debug("ConnectionPools::connect(\"" << url << "\", \"" << username << "\", password)");
 
-    PoolsType::iterator it;
+    std::shared_ptr<PoolType> pool;
 
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        it = _pools.find(ConnectionParameter(url, username, password));
+        PoolsType::iterator it = _pools.find(ConnectionParameter(url, username, password));
         if (it == _pools.end())
         {
             log_debug("create pool for url \"" << url << "\" user \"" << username << "\" with " << _maxcount << " connections");
-            std::unique_ptr<PoolType> pool(new PoolType(url, username, password, _maxcount));
-            it = _pools.emplace(ConnectionParameter(url, username, password), std::move(pool)).first;
+            pool = std::make_shared<PoolType>(url, username, password, _maxcount);
+            pool->setValidationPolicy(_validationPolicy, _validationInterval);
+            pool->setMinIdle(_minIdle);
+            pool->setMaxLifetime(_maxLifetime);
+            pool->setIdleTimeout(_idleTimeout);
+            pool->setMaxActive(_maxActive);
+            pool->setCheckoutTimeout(_checkoutTimeout);
+            _pools.emplace(ConnectionParameter(url, username, password), pool);
         }
         else
+        {
             log_debug("pool for url \"" << url << "\" found");
+            pool = it->second;
+        }
     }
 
-    log_debug("current pool size " << it->second->getCurrentSize());
-    return it->second->connect();
+    log_debug("current pool size " << pool->getCurrentSize());
+    Connection conn = pool->connect();
+
+    // let the maintenance thread refill the pool in the background
+    if (pool->getCurrentSize() < pool->getMinIdle())
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _maintenanceRequested = true;
+        _maintenanceCondition.notify_one();
+    }
+
+    return conn;
 }
 
 void ConnectionPools::drop(unsigned keep)
@@ -178,4 +613,146 @@ void ConnectionPools::setMaxSpare(unsigned m)
     for (auto it = _pools.begin(); it != _pools.end(); ++it)
         it->second->setMaxSpare(m);
 }
+
+void ConnectionPools::setMaxActive(unsigned n)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxActive = n;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        it->second->setMaxActive(n);
+}
+
+void ConnectionPools::setCheckoutTimeout(unsigned ms)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _checkoutTimeout = ms;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        it->second->setCheckoutTimeout(ms);
+}
+
+void ConnectionPools::setValidationPolicy(PoolType::ValidationPolicy policy, unsigned intervalMs)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _validationPolicy = policy;
+    _validationInterval = intervalMs;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        it->second->setValidationPolicy(policy, intervalMs);
+}
+
+std::vector<std::shared_ptr<ConnectionPools::PoolType>> ConnectionPools::pools() const
+{
+    // like in connect() the pools are used without holding the lock, so
+    // that the round trips do not block other threads
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<std::shared_ptr<PoolType>> pools;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        pools.push_back(it->second);
+
+    return pools;
+}
+
+unsigned ConnectionPools::validate()
+{
+    unsigned count = 0;
+    for (auto& pool: pools())
+        count += pool->validate();
+
+    return count;
+}
+
+unsigned ConnectionPools::maintain()
+{
+    unsigned count = 0;
+    for (auto& pool: pools())
+        count += pool->maintain();
+
+    return count;
+}
+
+void ConnectionPools::setMinIdle(unsigned n)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _minIdle = n;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        it->second->setMinIdle(n);
+
+    _maintenanceRequested = true;
+    _maintenanceCondition.notify_one();
+}
+
+void ConnectionPools::setMaxLifetime(unsigned ms)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxLifetime = ms;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        it->second->setMaxLifetime(ms);
+}
+
+void ConnectionPools::setIdleTimeout(unsigned ms)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _idleTimeout = ms;
+    for (auto it = _pools.begin(); it != _pools.end(); ++it)
+        it->second->setIdleTimeout(ms);
+}
+
+void ConnectionPools::runMaintenance()
+{
+    log_debug("maintenance thread started");
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_maintenanceStop)
+    {
+        _maintenanceRequested = false;
+
+        lock.unlock();
+        try
+        {
+            maintain();
+        }
+        catch (const std::exception& e)
+        {
+            log_warn("pool maintenance failed: " << e.what());
+        }
+        lock.lock();
+
+        _maintenanceCondition.wait_for(lock, std::chrono::milliseconds(_maintenanceInterval),
+            [this] { return _maintenanceStop || _maintenanceRequested; });
+    }
+
+    log_debug("maintenance thread stopped");
+}
+
+void ConnectionPools::startMaintenance(unsigned intervalMs)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maintenanceInterval = intervalMs;
+    if (!_maintenanceThread.joinable())
+    {
+        _maintenanceStop = false;
+        _maintenanceThread = std::thread(&ConnectionPools::runMaintenance, this);
+    }
+}
+
+void ConnectionPools::stopMaintenance()
+{
+    std::thread thread;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_maintenanceThread.joinable())
+            return;
+        _maintenanceStop = true;
+        _maintenanceCondition.notify_one();
+        thread.swap(_maintenanceThread);
+    }
+
+    thread.join();
+}
+
+ConnectionPools::~ConnectionPools()
+{
+    stopMaintenance();
+}
 }
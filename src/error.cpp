@@ -67,4 +67,8 @@ namespace tntdb
       _hostvar(hostvar)
   {
   }
+
+  PoolTimeout::PoolTimeout()
+    : Error("timeout waiting for a pooled connection")
+  { }
 }
@@ -0,0 +1,360 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/impl/forwardstatement.h>
+#include <tntdb/result.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/blob.h>
+#include <tntdb/decimal.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+
+namespace tntdb
+{
+void ForwardStatement::clear()
+{
+    _impl->clear();
+}
+
+void ForwardStatement::setNull(const std::string& col)
+{
+    _impl->setNull(col);
+}
+
+void ForwardStatement::setBool(const std::string& col, bool data)
+{
+    _impl->setBool(col, data);
+}
+
+void ForwardStatement::setShort(const std::string& col, short data)
+{
+    _impl->setShort(col, data);
+}
+
+void ForwardStatement::setInt(const std::string& col, int data)
+{
+    _impl->setInt(col, data);
+}
+
+void ForwardStatement::setLong(const std::string& col, long data)
+{
+    _impl->setLong(col, data);
+}
+
+void ForwardStatement::setUnsignedShort(const std::string& col, unsigned short data)
+{
+    _impl->setUnsignedShort(col, data);
+}
+
+void ForwardStatement::setUnsigned(const std::string& col, unsigned data)
+{
+    _impl->setUnsigned(col, data);
+}
+
+void ForwardStatement::setUnsignedLong(const std::string& col, unsigned long data)
+{
+    _impl->setUnsignedLong(col, data);
+}
+
+void ForwardStatement::setInt32(const std::string& col, int32_t data)
+{
+    _impl->setInt32(col, data);
+}
+
+void ForwardStatement::setUnsigned32(const std::string& col, uint32_t data)
+{
+    _impl->setUnsigned32(col, data);
+}
+
+void ForwardStatement::setInt64(const std::string& col, int64_t data)
+{
+    _impl->setInt64(col, data);
+}
+
+void ForwardStatement::setUnsigned64(const std::string& col, uint64_t data)
+{
+    _impl->setUnsigned64(col, data);
+}
+
+void ForwardStatement::setDecimal(const std::string& col, const Decimal& data)
+{
+    _impl->setDecimal(col, data);
+}
+
+void ForwardStatement::setFloat(const std::string& col, float data)
+{
+    _impl->setFloat(col, data);
+}
+
+void ForwardStatement::setDouble(const std::string& col, double data)
+{
+    _impl->setDouble(col, data);
+}
+
+void ForwardStatement::setChar(const std::string& col, char data)
+{
+    _impl->setChar(col, data);
+}
+
+void ForwardStatement::setString(const std::string& col, const std::string& data)
+{
+    _impl->setString(col, data);
+}
+
+void ForwardStatement::setBlob(const std::string& col, const Blob& data)
+{
+    _impl->setBlob(col, data);
+}
+
+void ForwardStatement::setDate(const std::string& col, const Date& data)
+{
+    _impl->setDate(col, data);
+}
+
+void ForwardStatement::setTime(const std::string& col, const Time& data)
+{
+    _impl->setTime(col, data);
+}
+
+void ForwardStatement::setDatetime(const std::string& col, const Datetime& data)
+{
+    _impl->setDatetime(col, data);
+}
+
+void ForwardStatement::setUString(const std::string& col, const cxxtools::String& data)
+{
+    _impl->setUString(col, data);
+}
+
+ForwardStatement::size_type ForwardStatement::paramIndex(const std::string& col)
+{
+    return _impl->paramIndex(col);
+}
+
+void ForwardStatement::setNullAt(size_type idx)
+{
+    _impl->setNullAt(idx);
+}
+
+void ForwardStatement::setBoolAt(size_type idx, bool data)
+{
+    _impl->setBoolAt(idx, data);
+}
+
+void ForwardStatement::setShortAt(size_type idx, short data)
+{
+    _impl->setShortAt(idx, data);
+}
+
+void ForwardStatement::setIntAt(size_type idx, int data)
+{
+    _impl->setIntAt(idx, data);
+}
+
+void ForwardStatement::setLongAt(size_type idx, long data)
+{
+    _impl->setLongAt(idx, data);
+}
+
+void ForwardStatement::setUnsignedShortAt(size_type idx, unsigned short data)
+{
+    _impl->setUnsignedShortAt(idx, data);
+}
+
+void ForwardStatement::setUnsignedAt(size_type idx, unsigned data)
+{
+    _impl->setUnsignedAt(idx, data);
+}
+
+void ForwardStatement::setUnsignedLongAt(size_type idx, unsigned long data)
+{
+    _impl->setUnsignedLongAt(idx, data);
+}
+
+void ForwardStatement::setInt32At(size_type idx, int32_t data)
+{
+    _impl->setInt32At(idx, data);
+}
+
+void ForwardStatement::setUnsigned32At(size_type idx, uint32_t data)
+{
+    _impl->setUnsigned32At(idx, data);
+}
+
+void ForwardStatement::setInt64At(size_type idx, int64_t data)
+{
+    _impl->setInt64At(idx, data);
+}
+
+void ForwardStatement::setUnsigned64At(size_type idx, uint64_t data)
+{
+    _impl->setUnsigned64At(idx, data);
+}
+
+void ForwardStatement::setDecimalAt(size_type idx, const Decimal& data)
+{
+    _impl->setDecimalAt(idx, data);
+}
+
+void ForwardStatement::setFloatAt(size_type idx, float data)
+{
+    _impl->setFloatAt(idx, data);
+}
+
+void ForwardStatement::setDoubleAt(size_type idx, double data)
+{
+    _impl->setDoubleAt(idx, data);
+}
+
+void ForwardStatement::setCharAt(size_type idx, char data)
+{
+    _impl->setCharAt(idx, data);
+}
+
+void ForwardStatement::setStringAt(size_type idx, const std::string& data)
+{
+    _impl->setStringAt(idx, data);
+}
+
+void ForwardStatement::setBlobAt(size_type idx, const Blob& data)
+{
+    _impl->setBlobAt(idx, data);
+}
+
+void ForwardStatement::setDateAt(size_type idx, const Date& data)
+{
+    _impl->setDateAt(idx, data);
+}
+
+void ForwardStatement::setTimeAt(size_type idx, const Time& data)
+{
+    _impl->setTimeAt(idx, data);
+}
+
+void ForwardStatement::setDatetimeAt(size_type idx, const Datetime& data)
+{
+    _impl->setDatetimeAt(idx, data);
+}
+
+void ForwardStatement::setUStringAt(size_type idx, const cxxtools::String& data)
+{
+    _impl->setUStringAt(idx, data);
+}
+
+void ForwardStatement::setStringRef(const std::string& col, const char* data, std::size_t length)
+{
+    _impl->setStringRef(col, data, length);
+}
+
+void ForwardStatement::setBlobRef(const std::string& col, const char* data, std::size_t length)
+{
+    _impl->setBlobRef(col, data, length);
+}
+
+void ForwardStatement::setStringRefAt(size_type idx, const char* data, std::size_t length)
+{
+    _impl->setStringRefAt(idx, data, length);
+}
+
+void ForwardStatement::setBlobRefAt(size_type idx, const char* data, std::size_t length)
+{
+    _impl->setBlobRefAt(idx, data, length);
+}
+
+void ForwardStatement::takeString(const std::string& col, std::string&& data)
+{
+    _impl->takeString(col, std::move(data));
+}
+
+void ForwardStatement::takeStringAt(size_type idx, std::string&& data)
+{
+    _impl->takeStringAt(idx, std::move(data));
+}
+
+ForwardStatement::size_type ForwardStatement::execute()
+{
+    return _impl->execute();
+}
+
+Result ForwardStatement::select()
+{
+    return _impl->select();
+}
+
+Row ForwardStatement::selectRow()
+{
+    return _impl->selectRow();
+}
+
+Value ForwardStatement::selectValue()
+{
+    return _impl->selectValue();
+}
+
+std::shared_ptr<ICursor> ForwardStatement::createCursor(unsigned fetchsize)
+{
+    return _impl->createCursor(fetchsize);
+}
+
+void ForwardStatement::maxNumDelay(size_type n)
+{
+    _impl->maxNumDelay(n);
+}
+
+ForwardStatement::size_type ForwardStatement::numDelayed() const
+{
+    return _impl->numDelayed();
+}
+
+ForwardStatement::size_type ForwardStatement::flush()
+{
+    return _impl->flush();
+}
+
+void ForwardStatement::setStreaming(bool sw)
+{
+    _impl->setStreaming(sw);
+}
+
+bool ForwardStatement::isStreaming() const
+{
+    return _impl->isStreaming();
+}
+
+void ForwardStatement::setFetchSize(unsigned n)
+{
+    _impl->setFetchSize(n);
+}
+
+unsigned ForwardStatement::getFetchSize() const
+{
+    return _impl->getFetchSize();
+}
+}
@@ -318,7 +318,11 @@ void setUnsigned64(MYSQL_BIND& bind, uint64_t data)
 
 void setDecimal(MYSQL_BIND& bind, unsigned long& length, const Decimal& data)
 {
-    std::string d = data.toString();
+    setDecimal(bind, length, data.toString());
+}
+
+void setDecimal(MYSQL_BIND& bind, unsigned long& length, const std::string& d)
+{
     reserve(bind, d.size());
     d.copy(static_cast<char*>(bind.buffer), d.size());
     bind.buffer_type = MYSQL_TYPE_NEWDECIMAL;
@@ -676,6 +680,52 @@ void getBlob(const MYSQL_BIND& bind, Blob& ret)
     }
 }
 
+const char* getStringData(const MYSQL_BIND& bind, std::size_t& length)
+{
+    if (isNull(bind))
+        throw NullValue();
+
+    switch (bind.buffer_type)
+    {
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_VAR_STRING:
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_DECIMAL:
+        case MYSQL_TYPE_NEWDECIMAL:
+            length = *bind.length;
+            return static_cast<const char*>(bind.buffer);
+
+        default:
+            log_debug("no string data without conversion, type=" << bind.buffer_type);
+            throw TypeError("type-error in getStringData");
+    }
+}
+
+const char* getBlobData(const MYSQL_BIND& bind, std::size_t& length)
+{
+    if (isNull(bind))
+        throw NullValue();
+
+    switch (bind.buffer_type)
+    {
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_VAR_STRING:
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+            length = *bind.length;
+            return static_cast<const char*>(bind.buffer);
+
+        default:
+            log_debug("no blob data without conversion, type=" << bind.buffer_type);
+            throw TypeError("type-error in getBlobData");
+    }
+}
+
 Date getDate(const MYSQL_BIND& bind)
 {
     if (isNull(bind))
@@ -39,32 +39,61 @@ namespace tntdb
 {
 namespace mysql
 {
+const unsigned long BindValues::slotSize;
+
 BindValues::BindValues()
   : valuesSize(0),
+    valuesCapacity(0),
     values(0),
+    arena(0),
     bindAttributes(0)
 { }
 
 BindValues::BindValues(unsigned n)
-  : valuesSize(n),
-    values(new MYSQL_BIND[n]),
-    bindAttributes(new BindAttributes[n])
+  : valuesSize(0),
+    valuesCapacity(0),
+    values(0),
+    arena(0),
+    bindAttributes(0)
+{
+    init(n);
+}
+
+BindValues::~BindValues()
 {
+    releaseAll();
+}
+
+void BindValues::init(unsigned n)
+{
+    valuesSize = n;
+    valuesCapacity = n;
+    values = new MYSQL_BIND[n];
+    arena = new char[n * slotSize];
+    bindAttributes = new BindAttributes[n];
+
     ::memset(values, 0, sizeof(MYSQL_BIND) * valuesSize);
     for (unsigned n = 0; n < valuesSize; ++n)
     {
+        values[n].buffer = slot(n);
+        values[n].buffer_length = slotSize;
         values[n].length = &bindAttributes[n].length;
         values[n].is_null = &bindAttributes[n].isNull;
     }
 }
 
-BindValues::~BindValues()
+void BindValues::releaseAll()
 {
     if (values)
-        for (unsigned n = 0; n < valuesSize; ++n)
-            delete[] static_cast<char*>(values[n].buffer);
+        for (unsigned n = 0; n < valuesCapacity; ++n)
+        {
+            own(n);
+            if (values[n].buffer != slot(n))
+                delete[] static_cast<char*>(values[n].buffer);
+        }
 
     delete[] values;
+    delete[] arena;
     delete[] bindAttributes;
 }
 
@@ -73,32 +102,100 @@ void BindValues::setSize(unsigned n)
     if (valuesSize == n)
         return;
 
-    if (values)
+    if (n > valuesCapacity)
     {
-        for (unsigned nn = 0; nn < valuesSize; ++nn)
-            delete[] static_cast<char*>(values[nn].buffer);
-        delete[] values;
-        delete[] bindAttributes;
+        releaseAll();
+        init(n);
+        return;
     }
 
-    valuesSize = n,
-    values = new MYSQL_BIND[n];
-    bindAttributes = new BindAttributes[n];
+    // keep the buffers for the next values
+    for (unsigned k = 0; k < n; ++k)
+    {
+        own(k);
+        void* buffer = values[k].buffer;
+        unsigned long bufferLength = values[k].buffer_length;
+        ::memset(&values[k], 0, sizeof(MYSQL_BIND));
+        values[k].buffer = buffer;
+        values[k].buffer_length = bufferLength;
 
-    ::memset(values, 0, sizeof(MYSQL_BIND) * valuesSize);
-    for (unsigned n = 0; n < valuesSize; ++n)
+        bindAttributes[k].length = 0;
+        bindAttributes[k].isNull = true;
+        bindAttributes[k].name.clear();
+        values[k].length = &bindAttributes[k].length;
+        values[k].is_null = &bindAttributes[k].isNull;
+    }
+
+    valuesSize = n;
+}
+
+void BindValues::detach(unsigned n)
+{
+    // the value moves to a buffer of its own, which is allocated on the
+    // next reserve
+    values[n].buffer = 0;
+    values[n].buffer_length = 0;
+}
+
+void BindValues::setNull(unsigned n)
+{
+    own(n);
+    // unlike mysql::setNull the buffer is kept for the next value
+    values[n].buffer_type = MYSQL_TYPE_NULL;
+    values[n].is_null = 0;
+}
+
+void BindValues::setDecimal(unsigned n, const Decimal& data)
+{
+    own(n);
+    std::string d = data.toString();
+    fit(n, d.size());
+    mysql::setDecimal(values[n], bindAttributes[n].length, d);
+}
+
+void BindValues::releaseRef(unsigned n)
+{
+    values[n].buffer = bindAttributes[n].ownBuffer;
+    values[n].buffer_length = bindAttributes[n].ownBufferLength;
+    bindAttributes[n].ownBuffer = 0;
+    bindAttributes[n].ownBufferLength = 0;
+    bindAttributes[n].isRef = false;
+}
+
+void BindValues::setRef(unsigned n, const char* data, unsigned long length)
+{
+    if (!bindAttributes[n].isRef)
     {
-        values[n].length = &bindAttributes[n].length;
-        values[n].is_null = &bindAttributes[n].isNull;
+        bindAttributes[n].ownBuffer = values[n].buffer;
+        bindAttributes[n].ownBufferLength = values[n].buffer_length;
+        bindAttributes[n].isRef = true;
     }
+
+    values[n].buffer = const_cast<char*>(data);
+    values[n].buffer_length = length;
+    values[n].buffer_type = MYSQL_TYPE_VAR_STRING;
+    values[n].is_null = 0;
+    bindAttributes[n].length = length;
+    values[n].length = &bindAttributes[n].length;
 }
 
-void BindValues::initOutBuffer(unsigned n, MYSQL_FIELD& f)
+void BindValues::initOutBuffer(unsigned n, const MYSQL_FIELD& f, unsigned long size)
 {
-    log_debug("initOutBuffer name=" << f.name << " n=" << n << " length=" << f.length << " type=" << f.type
-      << " max_length=" << f.max_length << " flags=" << f.flags << " unsigned=" << bool(f.flags & UNSIGNED_FLAG));
+    own(n);
 
-    reserve(values[n], std::max(f.length, f.max_length));
+    log_debug("initOutBuffer name=" << f.name << " n=" << n << " size=" << size << " type=" << f.type
+      << " length=" << f.length << " flags=" << f.flags << " unsigned=" << bool(f.flags & UNSIGNED_FLAG));
+
+    // give back buffers, which are much larger than needed
+    if (values[n].buffer != slot(n) && values[n].buffer_length > 2 * std::max(size, slotSize))
+    {
+        delete[] static_cast<char*>(values[n].buffer);
+        values[n].buffer = slot(n);
+        values[n].buffer_length = slotSize;
+    }
+
+    fit(n, size);
+    reserve(values[n], size);
     if (f.type == 0)
         log_debug("no type in metadata for field " << n << "; using MYSQL_TYPE_VAR_STRING");
     values[n].buffer_type = f.type ? f.type : MYSQL_TYPE_VAR_STRING;
@@ -109,6 +206,46 @@ void BindValues::initOutBuffer(unsigned n, MYSQL_FIELD& f)
         bindAttributes[n].name.clear();
 }
 
+void BindValues::setValue(unsigned n, const MYSQL_BIND& value)
+{
+    if (mysql::isNull(value))
+    {
+        setNull(n);
+        return;
+    }
+
+    own(n);
+
+    // the length is only maintained for variable sized types
+    unsigned long size;
+    switch (value.buffer_type)
+    {
+        case MYSQL_TYPE_DECIMAL:
+        case MYSQL_TYPE_NEWDECIMAL:
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_VAR_STRING:
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_BLOB:
+            size = *value.length;
+            break;
+
+        default:
+            size = value.buffer_length;
+    }
+
+    fit(n, size);
+    reserve(values[n], size);
+    ::memcpy(values[n].buffer, value.buffer, size);
+
+    values[n].buffer_type = value.buffer_type;
+    values[n].is_unsigned = value.is_unsigned;
+    values[n].is_null = 0;
+    bindAttributes[n].length = size;
+    values[n].length = &bindAttributes[n].length;
+}
+
 void BindValues::clear()
 {
     for (unsigned n = 0; n < valuesSize; ++n)
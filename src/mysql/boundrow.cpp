@@ -50,6 +50,19 @@ Value BoundRow::getValueByNumber(size_type field_num) const
 
 Value BoundRow::getValueByName(const std::string& field_name) const
 {
+    return getValueByNumber(getFieldNumber(field_name));
+}
+
+std::string BoundRow::getColumnName(size_type field_num) const
+{
+    return getName(field_num);
+}
+
+BoundRow::size_type BoundRow::getFieldNumber(const std::string& field_name) const
+{
+    if (_schema)
+        return _schema->getFieldNumber(field_name);
+
     size_type field_num;
     for (field_num = 0; field_num < size(); ++field_num)
         if (getName(field_num) == field_name)
@@ -58,12 +71,7 @@ Value BoundRow::getValueByName(const std::string& field_name) const
     if (field_num >= size())
         throw FieldNotFound(field_name);
 
-    return getValueByNumber(field_num);
-}
-
-std::string BoundRow::getColumnName(size_type field_num) const
-{
-    return getName(field_num);
+    return field_num;
 }
 
 }
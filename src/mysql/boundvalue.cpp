@@ -133,6 +133,16 @@ void BoundValue::getBlob(Blob& ret) const
     mysql::getBlob(mysql_bind, ret);
 }
 
+const char* BoundValue::getStringData(std::size_t& length) const
+{
+    return mysql::getStringData(mysql_bind, length);
+}
+
+const char* BoundValue::getBlobData(std::size_t& length) const
+{
+    return mysql::getBlobData(mysql_bind, length);
+}
+
 Date BoundValue::getDate() const
 {
     return mysql::getDate(mysql_bind);
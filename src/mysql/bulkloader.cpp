@@ -0,0 +1,454 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/mysql/impl/bulkloader.h>
+#include <tntdb/mysql/impl/connection.h>
+#include <tntdb/bits/result.h>
+#include <tntdb/bits/row.h>
+#include <tntdb/bits/value.h>
+#include <tntdb/blob.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <tntdb/error.h>
+#include <cxxtools/convert.h>
+#include <cxxtools/log.h>
+#include <limits>
+#include <sstream>
+
+log_define("tntdb.mysql.bulkloader")
+
+namespace tntdb
+{
+namespace mysql
+{
+namespace
+{
+    // the buffered rows are loaded, when the buffer reaches this size
+    const std::string::size_type loadBlockSize = 16 * 1024 * 1024;
+
+    // escapes the special characters of the default format of LOAD DATA
+    void appendEscaped(std::string& buffer, const std::string& data)
+    {
+        for (std::string::const_iterator it = data.begin(); it != data.end(); ++it)
+        {
+            switch (*it)
+            {
+                case '\\': buffer += "\\\\"; break;
+                case '\t': buffer += "\\t"; break;
+                case '\n': buffer += "\\n"; break;
+                case '\r': buffer += "\\r"; break;
+                case '\0': buffer += "\\0"; break;
+                default: buffer += *it;
+            }
+        }
+    }
+
+    template <typename T>
+    std::string floatToText(T data)
+    {
+        std::ostringstream v;
+        v.precision(std::numeric_limits<T>::max_digits10);
+        v << data;
+        return v.str();
+    }
+}
+
+BulkLoader::BulkLoader(Connection* conn, const std::string& table, const std::vector<std::string>& columns)
+  : _conn(conn),
+    _table(table),
+    _columns(columns),
+    _fields(columns.size()),
+    _rows(0),
+    _loaded(0),
+    _maxRows(0)
+{
+    // The rows are written in the default format: fields are terminated by
+    // tab, lines by newline and special characters are escaped with
+    // backslash. The data is not converted, so that blobs are loaded as is.
+    _loadSql = "LOAD DATA LOCAL INFILE 'tntdb' INTO TABLE " + table + " CHARACTER SET binary (";
+    for (unsigned n = 0; n < columns.size(); ++n)
+    {
+        if (n > 0)
+            _loadSql += ", ";
+        _loadSql += columns[n];
+    }
+    _loadSql += ')';
+
+    log_debug("bulk loader for \"" << _loadSql << '"');
+}
+
+BulkLoader::~BulkLoader()
+{
+    if (_rows > 0)
+    {
+        try
+        {
+            flush();
+        }
+        catch (const std::exception& e)
+        {
+            log_error("failed to load rows: " << e.what());
+        }
+    }
+}
+
+unsigned BulkLoader::columnIndex(const std::string& col) const
+{
+    for (unsigned n = 0; n < _columns.size(); ++n)
+        if (_columns[n] == col)
+            return n;
+
+    throw HostvarNotFound(col);
+}
+
+void BulkLoader::setValue(unsigned idx, const std::string& data)
+{
+    _fields[idx].isNull = false;
+    _fields[idx].value = data;
+}
+
+void BulkLoader::appendRow()
+{
+    for (std::vector<Field>::const_iterator it = _fields.begin(); it != _fields.end(); ++it)
+    {
+        if (it != _fields.begin())
+            _buffer += '\t';
+        if (it->isNull)
+            _buffer += "\\N";
+        else
+            appendEscaped(_buffer, it->value);
+    }
+    _buffer += '\n';
+}
+
+void BulkLoader::load()
+{
+    if (_buffer.empty())
+        return;
+
+    // the buffered rows are discarded also when the load fails
+    std::string data;
+    data.swap(_buffer);
+    _loaded += _conn->loadData(_loadSql, data);
+    data.clear();
+    _buffer.swap(data);
+}
+
+void BulkLoader::clear()
+{
+    for (std::vector<Field>::iterator it = _fields.begin(); it != _fields.end(); ++it)
+    {
+        it->isNull = true;
+        it->value.clear();
+    }
+}
+
+void BulkLoader::setNull(const std::string& col)
+{
+    setNullAt(columnIndex(col));
+}
+
+void BulkLoader::setBool(const std::string& col, bool data)
+{
+    setBoolAt(columnIndex(col), data);
+}
+
+void BulkLoader::setShort(const std::string& col, short data)
+{
+    setShortAt(columnIndex(col), data);
+}
+
+void BulkLoader::setInt(const std::string& col, int data)
+{
+    setIntAt(columnIndex(col), data);
+}
+
+void BulkLoader::setLong(const std::string& col, long data)
+{
+    setLongAt(columnIndex(col), data);
+}
+
+void BulkLoader::setUnsignedShort(const std::string& col, unsigned short data)
+{
+    setUnsignedShortAt(columnIndex(col), data);
+}
+
+void BulkLoader::setUnsigned(const std::string& col, unsigned data)
+{
+    setUnsignedAt(columnIndex(col), data);
+}
+
+void BulkLoader::setUnsignedLong(const std::string& col, unsigned long data)
+{
+    setUnsignedLongAt(columnIndex(col), data);
+}
+
+void BulkLoader::setInt32(const std::string& col, int32_t data)
+{
+    setInt32At(columnIndex(col), data);
+}
+
+void BulkLoader::setUnsigned32(const std::string& col, uint32_t data)
+{
+    setUnsigned32At(columnIndex(col), data);
+}
+
+void BulkLoader::setInt64(const std::string& col, int64_t data)
+{
+    setInt64At(columnIndex(col), data);
+}
+
+void BulkLoader::setUnsigned64(const std::string& col, uint64_t data)
+{
+    setUnsigned64At(columnIndex(col), data);
+}
+
+void BulkLoader::setDecimal(const std::string& col, const Decimal& data)
+{
+    setDecimalAt(columnIndex(col), data);
+}
+
+void BulkLoader::setFloat(const std::string& col, float data)
+{
+    setFloatAt(columnIndex(col), data);
+}
+
+void BulkLoader::setDouble(const std::string& col, double data)
+{
+    setDoubleAt(columnIndex(col), data);
+}
+
+void BulkLoader::setChar(const std::string& col, char data)
+{
+    setCharAt(columnIndex(col), data);
+}
+
+void BulkLoader::setString(const std::string& col, const std::string& data)
+{
+    setStringAt(columnIndex(col), data);
+}
+
+void BulkLoader::setBlob(const std::string& col, const Blob& data)
+{
+    setBlobAt(columnIndex(col), data);
+}
+
+void BulkLoader::setDate(const std::string& col, const Date& data)
+{
+    setDateAt(columnIndex(col), data);
+}
+
+void BulkLoader::setTime(const std::string& col, const Time& data)
+{
+    setTimeAt(columnIndex(col), data);
+}
+
+void BulkLoader::setDatetime(const std::string& col, const Datetime& data)
+{
+    setDatetimeAt(columnIndex(col), data);
+}
+
+BulkLoader::size_type BulkLoader::paramIndex(const std::string& col)
+{
+    return columnIndex(col);
+}
+
+void BulkLoader::setNullAt(size_type idx)
+{
+    _fields[idx].isNull = true;
+}
+
+void BulkLoader::setBoolAt(size_type idx, bool data)
+{
+    setValue(idx, data ? "1" : "0");
+}
+
+void BulkLoader::setShortAt(size_type idx, short data)
+{
+    setValue(idx, cxxtools::convert<std::string>(data));
+}
+
+void BulkLoader::setIntAt(size_type idx, int data)
+{
+    setValue(idx, cxxtools::convert<std::string>(data));
+}
+
+void BulkLoader::setLongAt(size_type idx, long data)
+{
+    setValue(idx, cxxtools::convert<std::string>(data));
+}
+
+void BulkLoader::setUnsignedShortAt(size_type idx, unsigned short data)
+{
+    setValue(idx, cxxtools::convert<std::string>(data));
+}
+
+void BulkLoader::setUnsignedAt(size_type idx, unsigned data)
+{
+    setValue(idx, cxxtools::convert<std::string>(data));
+}
+
+void BulkLoader::setUnsignedLongAt(size_type idx, unsigned long data)
+{
+    setValue(idx, cxxtools::convert<std::string>(data));
+}
+
+void BulkLoader::setInt32At(size_type idx, int32_t data)
+{
+    setValue(idx, cxxtools::convert<std::string>(data));
+}
+
+void BulkLoader::setUnsigned32At(size_type idx, uint32_t data)
+{
+    setValue(idx, cxxtools::convert<std::string>(data));
+}
+
+void BulkLoader::setInt64At(size_type idx, int64_t data)
+{
+    setValue(idx, cxxtools::convert<std::string>(data));
+}
+
+void BulkLoader::setUnsigned64At(size_type idx, uint64_t data)
+{
+    setValue(idx, cxxtools::convert<std::string>(data));
+}
+
+void BulkLoader::setDecimalAt(size_type idx, const Decimal& data)
+{
+    setValue(idx, data.toString());
+}
+
+void BulkLoader::setFloatAt(size_type idx, float data)
+{
+    setValue(idx, floatToText(data));
+}
+
+void BulkLoader::setDoubleAt(size_type idx, double data)
+{
+    setValue(idx, floatToText(data));
+}
+
+void BulkLoader::setCharAt(size_type idx, char data)
+{
+    setValue(idx, std::string(1, data));
+}
+
+void BulkLoader::setStringAt(size_type idx, const std::string& data)
+{
+    setValue(idx, data);
+}
+
+void BulkLoader::setBlobAt(size_type idx, const Blob& data)
+{
+    setValue(idx, std::string(data.data(), data.size()));
+}
+
+void BulkLoader::setDateAt(size_type idx, const Date& data)
+{
+    setValue(idx, data.getIso());
+}
+
+void BulkLoader::setTimeAt(size_type idx, const Time& data)
+{
+    setValue(idx, data.getIso());
+}
+
+void BulkLoader::setDatetimeAt(size_type idx, const Datetime& data)
+{
+    setValue(idx, data.getIso());
+}
+
+BulkLoader::size_type BulkLoader::execute()
+{
+    appendRow();
+    ++_rows;
+
+    if (_maxRows > 0 && _rows >= _maxRows)
+        flush();
+    else if (_buffer.size() >= loadBlockSize)
+        load();
+
+    return 0;
+}
+
+tntdb::Result BulkLoader::select()
+{
+    throw Error("select is not possible with a bulk loader");
+}
+
+tntdb::Row BulkLoader::selectRow()
+{
+    throw Error("select is not possible with a bulk loader");
+}
+
+tntdb::Value BulkLoader::selectValue()
+{
+    throw Error("select is not possible with a bulk loader");
+}
+
+std::shared_ptr<ICursor> BulkLoader::createCursor(unsigned /* fetchsize */)
+{
+    throw Error("cursors are not possible with a bulk loader");
+}
+
+void BulkLoader::maxNumDelay(size_type n)
+{
+    _maxRows = n;
+    if (_maxRows > 0 && _rows >= _maxRows)
+        flush();
+}
+
+BulkLoader::size_type BulkLoader::numDelayed() const
+{
+    return _rows;
+}
+
+BulkLoader::size_type BulkLoader::flush()
+{
+    _rows = 0;
+    try
+    {
+        load();
+    }
+    catch (...)
+    {
+        _loaded = 0;
+        throw;
+    }
+
+    size_type count = _loaded;
+    _loaded = 0;
+
+    log_debug(count << " rows loaded into " << _table);
+    return count;
+}
+
+}
+}
@@ -31,10 +31,14 @@
 #include <tntdb/mysql/impl/resultrow.h>
 #include <tntdb/mysql/impl/rowvalue.h>
 #include <tntdb/mysql/impl/statement.h>
+#include <tntdb/mysql/impl/bulkloader.h>
 #include <tntdb/result.h>
 #include <tntdb/statement.h>
 #include <tntdb/mysql/error.h>
+#include <errmsg.h>
 #include <cctype>
+#include <cstring>
+#include <algorithm>
 
 #include <cxxtools/log.h>
 
@@ -76,6 +80,16 @@ void Connection::open(const char* app, const char* host, const char* user,
     if (::mysql_options(&mysql, MYSQL_READ_DEFAULT_GROUP, app && app[0] ? app : "tntdb") != 0)
         throw MysqlError("mysql_options", &mysql);
 
+    // LOAD DATA LOCAL INFILE reads only the data of a bulk loader; requests
+    // of the server for other files are refused by the handler
+    if (localInfileEnabled)
+    {
+        unsigned int enable = 1;
+        if (::mysql_options(&mysql, MYSQL_OPT_LOCAL_INFILE, &enable) != 0)
+            throw MysqlError("mysql_options", &mysql);
+        ::mysql_set_local_infile_handler(&mysql, infileInit, infileRead, infileEnd, infileError, this);
+    }
+
     if (!::mysql_real_connect(&mysql, zstr(host), zstr(user), zstr(passwd),
                                 zstr(db), port, zstr(unix_socket), client_flag))
         throw MysqlError("mysql_real_connect", &mysql);
@@ -85,14 +99,24 @@ Connection::Connection(const char* app, const char* host, const char* user,
     const char* passwd, const char* db, unsigned int port,
     const char* unix_socket, unsigned long client_flag)
   : initialized(false),
-    transactionActive(0)
+    transactionActive(0),
+    maxAllowedPacket(0),
+    localInfileEnabled(false),
+    localInfile(-1),
+    infileData(0),
+    infilePos(0)
 {
     open(app, host, user, passwd, db, port, unix_socket, client_flag);
 }
 
 Connection::Connection(const std::string& conn, const std::string& username_, const std::string& password_)
   : initialized(false),
-    transactionActive(0)
+    transactionActive(0),
+    maxAllowedPacket(0),
+    localInfileEnabled(false),
+    localInfile(-1),
+    infileData(0),
+    infilePos(0)
 {
     log_debug("Connection::Connection(\"" << conn << "\", \"" << username_ << "\", password)");
     std::string app;
@@ -103,6 +127,7 @@ Connection::Connection(const std::string& conn, const std::string& username_, co
     unsigned int port = 3306;
     std::string unix_socket;
     unsigned long client_flag = 0;
+    std::string local_infile;
 
     enum state_type {
         state_key,
@@ -154,6 +179,8 @@ Connection::Connection(const std::string& conn, const std::string& username_, co
                         value = &db;
                         else if (key == "unix_socket")
                         value = &unix_socket;
+                        else if (key == "local_infile")
+                        value = &local_infile;
                         else
                         throw std::runtime_error("invalid key \"" + key
                           + "\" in connectionstring \"" + conn + '"');
@@ -238,6 +265,8 @@ Connection::Connection(const std::string& conn, const std::string& username_, co
     if (state == state_key && !key.empty())
         throw std::runtime_error(std::string("invalid connectionstring ") + conn);
 
+    localInfileEnabled = local_infile == "1" || local_infile == "on" || local_infile == "true" || local_infile == "yes";
+
     open(app.c_str(), host.c_str(), user.c_str(), passwd.c_str(), db.c_str(),
         port, unix_socket.c_str(), client_flag);
 }
@@ -412,5 +441,97 @@ void Connection::lockTable(const std::string& tablename, bool exclusive)
         throw MysqlError("mysql_query", &mysql);
 }
 
+
+tntdb::Statement Connection::prepareBulkLoad(const std::string& table, const std::vector<std::string>& columns)
+{
+    if (!hasLocalInfile())
+    {
+        log_debug("LOAD DATA LOCAL INFILE is not enabled; bulk load with multi row inserts");
+        return IConnection::prepareBulkLoad(table, columns);
+    }
+
+    log_debug("prepareBulkLoad(\"" << table << "\")");
+    return tntdb::Statement(std::make_shared<BulkLoader>(this, table, columns));
+}
+
+unsigned long Connection::getMaxAllowedPacket()
+{
+    if (maxAllowedPacket == 0)
+    {
+        maxAllowedPacket = selectValue("select @@max_allowed_packet").getUnsignedLong();
+        log_debug("max_allowed_packet=" << maxAllowedPacket);
+    }
+
+    return maxAllowedPacket;
+}
+
+bool Connection::hasLocalInfile()
+{
+    if (!localInfileEnabled)
+        return false;
+
+    if (localInfile < 0)
+    {
+        localInfile = selectValue("select @@local_infile").getBool() ? 1 : 0;
+        log_debug("local_infile=" << localInfile);
+    }
+
+    return localInfile > 0;
+}
+
+Connection::size_type Connection::loadData(const std::string& query, const std::string& data)
+{
+    infileData = &data;
+    infilePos = 0;
+
+    log_debug("mysql_query(\"" << query << "\") with " << data.size() << " bytes");
+    int ret = ::mysql_query(&mysql, query.c_str());
+
+    infileData = 0;
+
+    if (ret != 0)
+        throw MysqlError("mysql_query", &mysql);
+
+    log_debug("mysql_affected_rows(" << &mysql << ')');
+    return ::mysql_affected_rows(&mysql);
+}
+
+int Connection::infileInit(void** ptr, const char* filename, void* userdata)
+{
+    Connection* conn = static_cast<Connection*>(userdata);
+    *ptr = conn;
+
+    if (conn->infileData == 0)
+    {
+        log_warn("refuse request for local file \"" << filename << '"');
+        return 1;
+    }
+
+    return 0;
+}
+
+int Connection::infileRead(void* ptr, char* buf, unsigned int length)
+{
+    Connection* conn = static_cast<Connection*>(ptr);
+    std::string::size_type count = std::min<std::string::size_type>(length,
+        conn->infileData->size() - conn->infilePos);
+    conn->infileData->copy(buf, count, conn->infilePos);
+    conn->infilePos += count;
+    return static_cast<int>(count);
+}
+
+void Connection::infileEnd(void* /* ptr */)
+{
+}
+
+int Connection::infileError(void* /* ptr */, char* msg, unsigned int length)
+{
+    static const char error[] = "LOAD DATA LOCAL INFILE is possible with a bulk loader only";
+    ::strncpy(msg, error, length);
+    if (length > 0)
+        msg[length - 1] = '\0';
+    return CR_UNKNOWN_ERROR;
+}
+
 }
 }
@@ -40,36 +40,35 @@ namespace tntdb
 {
 namespace mysql
 {
-Cursor::Cursor(Statement& statement, unsigned fetchsize)
-  : _row(std::make_shared<BoundRow>(statement.getFieldCount())),
-    _fields(statement.getFields()),
-    _stmt(statement.createStmt())
+Cursor::Cursor(const std::shared_ptr<Statement>& statement, unsigned fetchsize)
+  : _statement(statement),
+    _row(std::make_shared<BoundRow>(statement->getFieldCount())),
+    _stmt(0)
 {
-    unsigned field_count = _row->getSize();
+    _row->setSchema(statement->getSchema());
+    statement->initOutBuffers(*_row);
 
-    for (unsigned n = 0; n < field_count; ++n)
+    _stmt = statement->acquireStmt();
+
+    try
     {
-        if (_fields[n].length > 0x10000)
-            // do not allocate buffers > 64k - use mysql_stmt_fetch_column instead later
-            _fields[n].length = 0x10000;
+        log_debug("mysql_stmt_bind_result");
+        if (mysql_stmt_bind_result(_stmt, _row->getMysqlBind()) != 0)
+            throw MysqlStmtError("mysql_stmt_bind_result", _stmt);
 
-        _row->initOutBuffer(n, _fields[n]);
+        statement->execute(_stmt, fetchsize);
+    }
+    catch (...)
+    {
+        statement->releaseStmt(_stmt);
+        throw;
     }
-
-    log_debug("mysql_stmt_bind_result");
-    if (mysql_stmt_bind_result(_stmt, _row->getMysqlBind()) != 0)
-        throw MysqlStmtError("mysql_stmt_bind_result", _stmt);
-
-    statement.execute(_stmt, fetchsize);
 }
 
 Cursor::~Cursor()
 {
     if (_stmt)
-    {
-        log_debug("mysql_stmt_close(" << _stmt << ')');
-        ::mysql_stmt_close(_stmt);
-    }
+        _statement->releaseStmt(_stmt);
 }
 
 Row Cursor::fetch()
@@ -79,21 +78,12 @@ Row Cursor::fetch()
 
     if (ret == MYSQL_DATA_TRUNCATED)
     {
-        // fetch column data where truncated
-        for (unsigned n = 0; n < _row->getSize(); ++n)
-        {
-            if (*_row->getMysqlBind()[n].length > _row->getMysqlBind()[n].buffer_length)
-            {
-                // actual length was longer than buffer_length, so this column is truncated
-                _fields[n].length = *_row->getMysqlBind()[n].length;
-                _row->initOutBuffer(n, _fields[n]);
+        _statement->fetchTruncated(_stmt, *_row);
 
-                log_debug("mysql_stmt_fetch_column(" << _stmt << ", BIND, " << n
-                    << ", 0) with " << _fields[n].length << " bytes");
-                if (mysql_stmt_fetch_column(_stmt, _row->getMysqlBind() + n, n, 0) != 0)
-                    throw MysqlStmtError("mysql_stmt_fetch_column", _stmt);
-            }
-        }
+        // the buffers of the truncated columns are replaced
+        log_debug("mysql_stmt_bind_result");
+        if (mysql_stmt_bind_result(_stmt, _row->getMysqlBind()) != 0)
+            throw MysqlStmtError("mysql_stmt_bind_result", _stmt);
     }
     else if (ret == MYSQL_NO_DATA)
     {
@@ -104,6 +94,8 @@ Row Cursor::fetch()
     else if (ret == 1)
         throw MysqlStmtError("mysql_stmt_fetch", _stmt);
 
+    _statement->updateColumnWidths(*_row);
+
     return Row(_row);
 }
 }
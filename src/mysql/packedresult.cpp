@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/mysql/impl/packedresult.h>
+#include <tntdb/mysql/bindutils.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/blob.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/decimal.h>
+#include <algorithm>
+#include <string.h>
+
+namespace tntdb
+{
+namespace mysql
+{
+namespace
+{
+    // Returns the size of fixed size types or 0 for variable sized types.
+    // The output buffers of fixed size types may be larger than the value.
+    unsigned long fixedSize(enum_field_types type)
+    {
+        switch (type)
+        {
+            case MYSQL_TYPE_TINY:
+                return 1;
+
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_YEAR:
+                return 2;
+
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONG:
+                return 4;
+
+            case MYSQL_TYPE_FLOAT:
+                return sizeof(float);
+
+            case MYSQL_TYPE_LONGLONG:
+                return 8;
+
+            case MYSQL_TYPE_DOUBLE:
+                return sizeof(double);
+
+            case MYSQL_TYPE_DATE:
+            case MYSQL_TYPE_TIME:
+            case MYSQL_TYPE_DATETIME:
+            case MYSQL_TYPE_TIMESTAMP:
+                return sizeof(MYSQL_TIME);
+
+            default:
+                return 0;
+        }
+    }
+}
+
+PackedResult::PackedResult(const std::shared_ptr<const ResultSchema>& schema)
+  : _schema(schema),
+    _columns(schema->size()),
+    _size(0)
+{ }
+
+Row PackedResult::getRow(size_type tup_num) const
+{
+    return Row(std::make_shared<PackedRow>(shared_from_this(), tup_num));
+}
+
+PackedResult::size_type PackedResult::size() const
+{
+    return _size;
+}
+
+PackedResult::size_type PackedResult::getFieldCount() const
+{
+    return _columns.size();
+}
+
+void PackedResult::addRow(const MYSQL_BIND* bind)
+{
+    for (unsigned n = 0; n < _columns.size(); ++n)
+    {
+        Column& column = _columns[n];
+        const MYSQL_BIND& value = bind[n];
+
+        if (_size == 0)
+        {
+            column.type = value.buffer_type;
+            column.isUnsigned = value.is_unsigned;
+        }
+
+        if (mysql::isNull(value))
+        {
+            column.nulls.push_back(true);
+        }
+        else
+        {
+            unsigned long length = fixedSize(value.buffer_type);
+            if (length == 0)
+                length = *value.length;
+            column.data.append(static_cast<const char*>(value.buffer), length);
+            column.nulls.push_back(false);
+        }
+
+        column.ends.push_back(column.data.size());
+    }
+
+    ++_size;
+}
+
+const char* PackedResult::getData(size_type tup_num, size_type field_num, unsigned long& length) const
+{
+    const Column& column = _columns[field_num];
+    unsigned long begin = tup_num == 0 ? 0 : column.ends[tup_num - 1];
+    length = column.ends[tup_num] - begin;
+    return column.data.data() + begin;
+}
+
+PackedRow::size_type PackedRow::size() const
+{
+    return _result->getFieldCount();
+}
+
+Value PackedRow::getValueByNumber(size_type field_num) const
+{
+    return Value(std::make_shared<PackedValue>(_result, _tupNum, field_num));
+}
+
+Value PackedRow::getValueByName(const std::string& field_name) const
+{
+    return getValueByNumber(_result->getSchema().getFieldNumber(field_name));
+}
+
+std::string PackedRow::getColumnName(size_type field_num) const
+{
+    return _result->getSchema().getName(field_num);
+}
+
+PackedRow::size_type PackedRow::getFieldNumber(const std::string& field_name) const
+{
+    return _result->getSchema().getFieldNumber(field_name);
+}
+
+const ResultSchema* PackedRow::getSchema() const
+{
+    return &_result->getSchema();
+}
+
+PackedValue::PackedValue(const std::shared_ptr<const PackedResult>& result, unsigned tupNum, unsigned fieldNum)
+  : _result(result),
+    _length(0),
+    _isNull(result->isNull(tupNum, fieldNum))
+{
+    ::memset(&_bind, 0, sizeof(_bind));
+    _bind.buffer_type = result->getType(fieldNum);
+    _bind.is_unsigned = result->isUnsigned(fieldNum);
+    _bind.is_null = &_isNull;
+    _bind.length = &_length;
+
+    const char* data = result->getData(tupNum, fieldNum, _length);
+    if (fixedSize(_bind.buffer_type) > 0)
+    {
+        // the packed data is not aligned
+        ::memcpy(&_fixed, data, std::min<unsigned long>(_length, sizeof(_fixed)));
+        _bind.buffer = &_fixed;
+        _bind.buffer_length = sizeof(_fixed);
+    }
+    else
+    {
+        _bind.buffer = const_cast<char*>(data);
+        _bind.buffer_length = _length;
+    }
+}
+
+bool PackedValue::isNull() const
+{
+    return mysql::isNull(_bind);
+}
+
+bool PackedValue::getBool() const
+{
+    return mysql::getBool(_bind);
+}
+
+short PackedValue::getShort() const
+{
+    return mysql::getShort(_bind);
+}
+
+int PackedValue::getInt() const
+{
+    return mysql::getInt(_bind);
+}
+
+long PackedValue::getLong() const
+{
+    return mysql::getLong(_bind);
+}
+
+unsigned short PackedValue::getUnsignedShort() const
+{
+    return mysql::getUnsignedShort(_bind);
+}
+
+unsigned PackedValue::getUnsigned() const
+{
+    return mysql::getUnsigned(_bind);
+}
+
+unsigned long PackedValue::getUnsignedLong() const
+{
+    return mysql::getUnsignedLong(_bind);
+}
+
+int32_t PackedValue::getInt32() const
+{
+    return mysql::getInt32(_bind);
+}
+
+uint32_t PackedValue::getUnsigned32() const
+{
+    return mysql::getUnsigned32(_bind);
+}
+
+int64_t PackedValue::getInt64() const
+{
+    return mysql::getInt64(_bind);
+}
+
+uint64_t PackedValue::getUnsigned64() const
+{
+    return mysql::getUnsigned64(_bind);
+}
+
+Decimal PackedValue::getDecimal() const
+{
+    return mysql::getDecimal(_bind);
+}
+
+float PackedValue::getFloat() const
+{
+    return mysql::getFloat(_bind);
+}
+
+double PackedValue::getDouble() const
+{
+    return mysql::getDouble(_bind);
+}
+
+char PackedValue::getChar() const
+{
+    return mysql::getChar(_bind);
+}
+
+void PackedValue::getString(std::string& ret) const
+{
+    mysql::getString(_bind, ret);
+}
+
+void PackedValue::getBlob(Blob& ret) const
+{
+    mysql::getBlob(_bind, ret);
+}
+
+const char* PackedValue::getStringData(std::size_t& length) const
+{
+    return mysql::getStringData(_bind, length);
+}
+
+const char* PackedValue::getBlobData(std::size_t& length) const
+{
+    return mysql::getBlobData(_bind, length);
+}
+
+Date PackedValue::getDate() const
+{
+    return mysql::getDate(_bind);
+}
+
+Time PackedValue::getTime() const
+{
+    return mysql::getTime(_bind);
+}
+
+Datetime PackedValue::getDatetime() const
+{
+    return mysql::getDatetime(_bind);
+}
+
+}
+}
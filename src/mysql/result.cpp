@@ -47,6 +47,15 @@ Result::Result(MYSQL* m, MYSQL_RES* r)
 
     log_debug("mysql_field_count");
     field_count = ::mysql_field_count(m);
+
+    if (result)
+    {
+        log_debug("mysql_fetch_fields");
+        MYSQL_FIELD* fields = ::mysql_fetch_fields(result);
+        schema.reserve(field_count);
+        for (size_type n = 0; n < field_count; ++n)
+            schema.add(fields[n].name);
+    }
 }
 
 Result::~Result()
@@ -68,7 +77,7 @@ std::shared_ptr<ResultRow> Result::getMysqlRow(size_type tup_num) const
     if (row == 0)
       throw MysqlError("mysql_fetch_row", mysql);
 
-    return std::make_shared<ResultRow>(result, row, field_count);
+    return std::make_shared<ResultRow>(result, row, field_count, &schema);
 }
 
 Row Result::getRow(size_type tup_num) const
@@ -42,7 +42,8 @@ namespace mysql
 ResultRow::ResultRow(std::shared_ptr<Result> resultref, MYSQL_ROW row, unsigned field_count)
     : _resultref(resultref),
       _row(row),
-      _field_count(field_count)
+      _field_count(field_count),
+      _schema(&resultref->getSchema())
 {
     log_debug("mysql_fetch_lengths");
     _lengths = ::mysql_fetch_lengths(resultref->getMysqlRes());
@@ -51,9 +52,10 @@ ResultRow::ResultRow(std::shared_ptr<Result> resultref, MYSQL_ROW row, unsigned
     _fields = ::mysql_fetch_fields(resultref->getMysqlRes());
 }
 
-ResultRow::ResultRow(MYSQL_RES* res, MYSQL_ROW row, unsigned field_count)
+ResultRow::ResultRow(MYSQL_RES* res, MYSQL_ROW row, unsigned field_count, const ResultSchema* schema)
     : _row(row),
-      _field_count(field_count)
+      _field_count(field_count),
+      _schema(schema)
 {
     log_debug("mysql_fetch_lengths");
     _lengths = ::mysql_fetch_lengths(res);
@@ -79,6 +81,19 @@ Value ResultRow::getValueByNumber(size_type field_num) const
 
 Value ResultRow::getValueByName(const std::string& field_name) const
 {
+    return getValueByNumber(getFieldNumber(field_name));
+}
+
+std::string ResultRow::getColumnName(size_type field_num) const
+{
+    return _fields[field_num].name;
+}
+
+ResultRow::size_type ResultRow::getFieldNumber(const std::string& field_name) const
+{
+    if (_schema)
+        return _schema->getFieldNumber(field_name);
+
     size_type field_num;
     for (field_num = 0; field_num < size(); ++field_num)
         if (_fields[field_num].name == field_name)
@@ -87,12 +102,7 @@ Value ResultRow::getValueByName(const std::string& field_name) const
     if (field_num >= size())
         throw FieldNotFound(field_name);
 
-    return getValueByNumber(field_num);
-}
-
-std::string ResultRow::getColumnName(size_type field_num) const
-{
-    return _fields[field_num].name;
+    return field_num;
 }
 
 }
@@ -32,6 +32,7 @@
 #include <tntdb/time.h>
 #include <tntdb/datetime.h>
 #include <tntdb/decimal.h>
+#include <tntdb/error.h>
 #include <sstream>
 
 namespace tntdb
@@ -171,6 +172,19 @@ void RowValue::getBlob(Blob& ret) const
     ret.assign(_row[_col], _len);
 }
 
+const char* RowValue::getStringData(std::size_t& length) const
+{
+    if (isNull())
+        throw NullValue();
+    length = _len;
+    return _row[_col];
+}
+
+const char* RowValue::getBlobData(std::size_t& length) const
+{
+    return getStringData(length);
+}
+
 Date RowValue::getDate() const
 {
     return Date::fromIso(getString());
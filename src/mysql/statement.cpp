@@ -27,10 +27,11 @@
  */
 
 #include <tntdb/mysql/impl/statement.h>
-#include <tntdb/mysql/impl/rowcontainer.h>
+#include <tntdb/mysql/impl/packedresult.h>
 #include <tntdb/mysql/impl/boundrow.h>
 #include <tntdb/mysql/impl/boundvalue.h>
 #include <tntdb/mysql/impl/cursor.h>
+#include <tntdb/mysql/impl/streamresult.h>
 #include <tntdb/result.h>
 #include <tntdb/row.h>
 #include <tntdb/value.h>
@@ -40,6 +41,9 @@
 #include <tntdb/mysql/error.h>
 #include <tntdb/stmtparser.h>
 #include <sstream>
+#include <algorithm>
+#include <ctype.h>
+#include <strings.h>
 #include <cxxtools/log.h>
 
 log_define("tntdb.mysql.statement")
@@ -48,19 +52,22 @@ namespace tntdb
 {
 namespace mysql
 {
-typedef std::multimap<std::string, unsigned> hostvarMapType;
+typedef std::map<std::string, unsigned> hostvarMapType;
+typedef std::vector<std::vector<unsigned> > paramPositionsType;
 
 namespace
 {
     class SE : public StmtEvent
     {
         hostvarMapType& hostvarMap;
+        paramPositionsType& paramPositions;
         unsigned idx;
         static const std::string hostvarInd;
 
     public:
-        SE(hostvarMapType& hostvarMap_)
+        SE(hostvarMapType& hostvarMap_, paramPositionsType& paramPositions_)
           : hostvarMap(hostvarMap_),
+            paramPositions(paramPositions_),
             idx(0)
           { }
         std::string onHostVar(const std::string& name);
@@ -70,11 +77,122 @@ namespace
     std::string SE::onHostVar(const std::string& name)
     {
         log_debug("hostvar :" << name << ", idx=" << idx);
-        hostvarMap.insert(hostvarMapType::value_type(name, idx++));
+        hostvarMapType::iterator it = hostvarMap.find(name);
+        if (it == hostvarMap.end())
+        {
+            it = hostvarMap.insert(hostvarMapType::value_type(name, paramPositions.size())).first;
+            paramPositions.push_back(std::vector<unsigned>());
+        }
+        paramPositions[it->second].push_back(idx++);
         return hostvarInd;
     }
 
     const std::string SE::hostvarInd = "?";
+
+    // Finds the end of the quoted string starting at pos; returns the
+    // position of the closing quote.
+    std::string::size_type skipQuoted(const std::string& sql, std::string::size_type pos)
+    {
+        char quote = sql[pos];
+        for (++pos; pos < sql.size() && sql[pos] != quote; ++pos)
+            if (sql[pos] == '\\')
+                ++pos;
+        return pos;
+    }
+
+    unsigned countPlaceholders(const std::string& sql)
+    {
+        unsigned count = 0;
+        for (std::string::size_type pos = 0; pos < sql.size(); ++pos)
+        {
+            if (sql[pos] == '\'' || sql[pos] == '"' || sql[pos] == '`')
+                pos = skipQuoted(sql, pos);
+            else if (sql[pos] == '?')
+                ++count;
+        }
+        return count;
+    }
+
+    // Splits "INSERT ... VALUES (...) ..." into the parts before, at and
+    // after the values tuple. Returns false when the statement has another
+    // form or has placeholders outside the tuple.
+    bool splitInsert(const std::string& sql, std::string& prefix, std::string& row, std::string& suffix)
+    {
+        std::string::size_type pos = sql.find_first_not_of(" \t\r\n");
+        if (pos == std::string::npos
+            || (strncasecmp(sql.c_str() + pos, "insert", 6) != 0
+                && strncasecmp(sql.c_str() + pos, "replace", 7) != 0))
+            return false;
+
+        std::string::size_type begin = std::string::npos;
+        for ( ; pos < sql.size(); ++pos)
+        {
+            char ch = sql[pos];
+            if (ch == '\'' || ch == '"' || ch == '`')
+                pos = skipQuoted(sql, pos);
+            else if ((ch == 'v' || ch == 'V')
+                && (pos == 0 || !isalnum(static_cast<unsigned char>(sql[pos - 1])))
+                && strncasecmp(sql.c_str() + pos, "values", 6) == 0)
+            {
+                begin = sql.find_first_not_of(" \t\r\n", pos + 6);
+                break;
+            }
+        }
+
+        if (begin == std::string::npos || sql[begin] != '(')
+            return false;
+
+        unsigned depth = 0;
+        std::string::size_type end;
+        for (end = begin; end < sql.size(); ++end)
+        {
+            char ch = sql[end];
+            if (ch == '\'' || ch == '"' || ch == '`')
+                end = skipQuoted(sql, end);
+            else if (ch == '(')
+                ++depth;
+            else if (ch == ')' && --depth == 0)
+                break;
+        }
+
+        if (end >= sql.size())
+            return false;
+
+        prefix = sql.substr(0, begin);
+        row = sql.substr(begin, end + 1 - begin);
+        suffix = sql.substr(end + 1);
+
+        return countPlaceholders(prefix) == 0
+            && countPlaceholders(suffix) == 0;
+    }
+
+    // room for the header of an execute packet
+    const unsigned long packetHeaderSize = 1024;
+
+    // Returns the number of bytes, which a parameter takes in an execute
+    // packet: the type, the value and the length of variable sized values.
+    unsigned long paramSize(const MYSQL_BIND& bind)
+    {
+        if (mysql::isNull(bind))
+            return 2;
+
+        switch (bind.buffer_type)
+        {
+            case MYSQL_TYPE_TINY:       return 2 + 1;
+            case MYSQL_TYPE_SHORT:      return 2 + 2;
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_FLOAT:      return 2 + 4;
+            case MYSQL_TYPE_LONGLONG:
+            case MYSQL_TYPE_DOUBLE:     return 2 + 8;
+
+            case MYSQL_TYPE_DATE:
+            case MYSQL_TYPE_TIME:
+            case MYSQL_TYPE_DATETIME:
+            case MYSQL_TYPE_TIMESTAMP:  return 2 + 13;
+
+            default:                    return 2 + 9 + *bind.length;
+        }
+    }
 }
 
 std::shared_ptr<BoundRow> Statement::getRow()
@@ -88,15 +206,8 @@ std::shared_ptr<BoundRow> Statement::getRow()
     getFields();
 
     rowPtr.reset(new BoundRow(field_count));
-
-    for (unsigned n = 0; n < field_count; ++n)
-    {
-        if (fields[n].length > 0x10000)
-          // do not allocate buffers > 64k - use mysql_stmt_fetch_column instead later
-          fields[n].length = 0x10000;
-
-        rowPtr->initOutBuffer(n, fields[n]);
-    }
+    rowPtr->setSchema(schema);
+    initOutBuffers(*rowPtr);
 
     return rowPtr;
 }
@@ -113,52 +224,124 @@ std::shared_ptr<BoundRow> Statement::fetchRow()
     int ret = mysql_stmt_fetch(stmt);
 
     if (ret == MYSQL_DATA_TRUNCATED)
-    {
-        // fetch column data where truncated
-        for (unsigned n = 0; n < field_count; ++n)
-        {
-            if (*ptr->getMysqlBind()[n].length > ptr->getMysqlBind()[n].buffer_length)
-            {
-                // actual length was longer than buffer_length, so this column is truncated
-                fields[n].length = *ptr->getMysqlBind()[n].length;
-                ptr->initOutBuffer(n, fields[n]);
-
-                log_debug("mysql_stmt_fetch_column(" << stmt << ", BIND, " << n
-                    << ", 0) with " << fields[n].length << " bytes");
-                if (mysql_stmt_fetch_column(stmt, ptr->getMysqlBind() + n, n, 0) != 0)
-                  throw MysqlStmtError("mysql_stmt_fetch_column", stmt);
-            }
-        }
-    }
+        fetchTruncated(stmt, *ptr);
     else if (ret == MYSQL_NO_DATA)
-        ptr = nullptr;
+        return nullptr;
     else if (ret == 1)
         throw MysqlStmtError("mysql_stmt_fetch", stmt);
 
+    updateColumnWidths(*ptr);
+
     return ptr;
 }
 
+void Statement::initOutBuffers(BoundRow& row)
+{
+    getFields();
+
+    if (columnWidths.size() != field_count)
+        columnWidths.assign(field_count, 0);
+
+    for (unsigned n = 0; n < field_count; ++n)
+    {
+        unsigned long size = columnWidths[n];
+        if (size == 0)
+            // nothing fetched yet - do not allocate more than 4k for a
+            // column; longer values are fetched with mysql_stmt_fetch_column
+            size = std::min(std::max(fields[n].length, fields[n].max_length), 0x1000ul);
+
+        row.initOutBuffer(n, fields[n], size);
+    }
+}
+
+void Statement::fetchTruncated(MYSQL_STMT* s, BoundRow& row)
+{
+    for (unsigned n = 0; n < row.getSize(); ++n)
+    {
+        MYSQL_BIND& bind = row.getMysqlBind()[n];
+        unsigned long length = *bind.length;
+        if (length > bind.buffer_length)
+        {
+            // actual length was longer than buffer_length, so this column
+            // is truncated; grow at least by factor 2 to make following
+            // values fit
+            row.initOutBuffer(n, fields[n], std::max(length, 2 * bind.buffer_length));
+
+            log_debug("mysql_stmt_fetch_column(" << s << ", BIND, " << n
+                << ", 0) with " << length << " bytes");
+            if (mysql_stmt_fetch_column(s, &bind, n, 0) != 0)
+                throw MysqlStmtError("mysql_stmt_fetch_column", s);
+        }
+    }
+}
+
+void Statement::updateColumnWidths(const BoundRow& row)
+{
+    const MYSQL_BIND* bind = row.getMysqlBind();
+    for (unsigned n = 0; n < columnWidths.size(); ++n)
+        if (!mysql::isNull(bind[n]) && *bind[n].length > columnWidths[n])
+            columnWidths[n] = *bind[n].length;
+}
+
 Statement::Statement(Connection& conn_, MYSQL* mysql_,
   const std::string& query_)
   : conn(conn_),
     mysql(mysql_),
     stmt(0),
     fields(0),
-    field_count(0)
+    field_count(0),
+    streaming(false),
+    fetchSize(16),
+    generation(0),
+    maxDelay(0),
+    delayedRows(0),
+    delayedBytes(0),
+    batchStmt(0)
 {
     // parse hostvars
     StmtParser parser;
-    SE se(hostvarMap);
+    SE se(hostvarMap, paramPositions);
     parser.parse(query_, se);
 
     log_debug("sql=\"" << parser.getSql() << "\" invars " << se.getCount());
 
     query = parser.getSql();
     inVars.setSize(se.getCount());
+
+    if (se.getCount() > 0 && !splitInsert(query, insertPrefix, insertRow, insertSuffix))
+    {
+        insertPrefix.clear();
+        insertRow.clear();
+        insertSuffix.clear();
+    }
 }
 
 Statement::~Statement()
 {
+    if (delayedRows > 0)
+    {
+        try
+        {
+            flush();
+        }
+        catch (const std::exception& e)
+        {
+            log_error("failed to flush delayed statements: " << e.what());
+        }
+    }
+
+    if (batchStmt)
+    {
+        log_debug("mysql_stmt_close(" << batchStmt << ')');
+        ::mysql_stmt_close(batchStmt);
+    }
+
+    for (unsigned n = 0; n < cursorStmts.size(); ++n)
+    {
+        log_debug("mysql_stmt_close(" << cursorStmts[n] << ')');
+        ::mysql_stmt_close(cursorStmts[n]);
+    }
+
     if (stmt)
     {
         log_debug("mysql_stmt_close(" << stmt << ')');
@@ -169,348 +352,341 @@ Statement::~Statement()
 void Statement::clear()
 {
     log_debug("statement " << stmt << " clear()");
-    for (hostvarMapType::const_iterator it = hostvarMap.begin();
-         it != hostvarMap.end(); ++it)
-        inVars.setNull(it->second);
+    for (unsigned n = 0; n < inVars.getSize(); ++n)
+        inVars.setNull(n);
 }
 
 void Statement::setNull(const std::string& col)
 {
-    log_debug("statement " << stmt << " setNull(\"" << col << "\")");
-
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setNull(it->second);
-    }
-
-    if (!found)
-        throw HostvarNotFound(col);
+    setNullAt(paramIndex(col));
 }
 
 void Statement::setBool(const std::string& col, bool data)
 {
-    log_debug("statement " << stmt << " setBool(\"" << col << "\", " << data << ')');
-
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setBool(it->second, data);
-    }
-
-    if (!found)
-        throw HostvarNotFound(col);
+    setBoolAt(paramIndex(col), data);
 }
 
 void Statement::setShort(const std::string& col, short data)
 {
-    log_debug("statement " << stmt << " setShort(\"" << col << "\", " << data << ')');
-
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setShort(it->second, data);
-    }
-
-    if (!found)
-        throw HostvarNotFound(col);
+    setShortAt(paramIndex(col), data);
 }
 
 void Statement::setInt(const std::string& col, int data)
 {
-    log_debug("statement " << stmt << " setInt(\"" << col << "\", " << data << ')');
+    setIntAt(paramIndex(col), data);
+}
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setInt(it->second, data);
-    }
+void Statement::setLong(const std::string& col, long data)
+{
+    setLongAt(paramIndex(col), data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setUnsignedShort(const std::string& col, unsigned short data)
+{
+    setUnsignedShortAt(paramIndex(col), data);
 }
 
-void Statement::setLong(const std::string& col, long data)
+void Statement::setUnsigned(const std::string& col, unsigned data)
 {
-    log_debug("statement " << stmt << " setLong(\"" << col << "\", " << data << ')');
+    setUnsignedAt(paramIndex(col), data);
+}
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setLong(it->second, data);
-    }
+void Statement::setUnsignedLong(const std::string& col, unsigned long data)
+{
+    setUnsignedLongAt(paramIndex(col), data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setInt32(const std::string& col, int32_t data)
+{
+    setInt32At(paramIndex(col), data);
 }
 
-void Statement::setUnsignedShort(const std::string& col, unsigned short data)
+void Statement::setUnsigned32(const std::string& col, uint32_t data)
 {
-    log_debug("statement " << stmt << " setUnsignedShort(\"" << col << "\", " << data << ')');
+    setUnsigned32At(paramIndex(col), data);
+}
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setUnsignedShort(it->second, data);
-    }
+void Statement::setInt64(const std::string& col, int64_t data)
+{
+    setInt64At(paramIndex(col), data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setUnsigned64(const std::string& col, uint64_t data)
+{
+    setUnsigned64At(paramIndex(col), data);
 }
 
-void Statement::setUnsigned(const std::string& col, unsigned data)
+void Statement::setDecimal(const std::string& col, const Decimal& data)
 {
-    log_debug("statement " << stmt << " setUnsigned(\"" << col << "\", " << data << ')');
+    setDecimalAt(paramIndex(col), data);
+}
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setUnsigned(it->second, data);
-    }
+void Statement::setFloat(const std::string& col, float data)
+{
+    setFloatAt(paramIndex(col), data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setDouble(const std::string& col, double data)
+{
+    setDoubleAt(paramIndex(col), data);
 }
 
-void Statement::setUnsignedLong(const std::string& col, unsigned long data)
+void Statement::setChar(const std::string& col, char data)
 {
-    log_debug("statement " << stmt << " setUnsignedLong(\"" << col << "\", " << data << ')');
+    setCharAt(paramIndex(col), data);
+}
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setUnsignedLong(it->second, data);
-    }
+void Statement::setString(const std::string& col, const std::string& data)
+{
+    setStringAt(paramIndex(col), data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setBlob(const std::string& col, const Blob& data)
+{
+    setBlobAt(paramIndex(col), data);
 }
 
-void Statement::setInt32(const std::string& col, int32_t data)
+void Statement::setDate(const std::string& col, const Date& data)
 {
-    log_debug("statement " << stmt << " setInt32(\"" << col << "\", " << data << ')');
+    setDateAt(paramIndex(col), data);
+}
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setInt32(it->second, data);
-    }
+void Statement::setTime(const std::string& col, const Time& data)
+{
+    setTimeAt(paramIndex(col), data);
+}
 
-    if (!found)
+void Statement::setDatetime(const std::string& col, const Datetime& data)
+{
+    setDatetimeAt(paramIndex(col), data);
+}
+
+Statement::size_type Statement::paramIndex(const std::string& col)
+{
+    hostvarMapType::const_iterator it = hostvarMap.find(col);
+    if (it == hostvarMap.end())
         throw HostvarNotFound(col);
+    return it->second;
 }
 
-void Statement::setUnsigned32(const std::string& col, uint32_t data)
+void Statement::setNullAt(size_type hv)
 {
-    log_debug("statement " << stmt << " setUnsigned32(\"" << col << "\", " << data << ')');
+    log_debug("statement " << stmt << " setNullAt(" << hv << ")");
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setUnsigned32(it->second, data);
-    }
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setNull(pos[n]);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setBoolAt(size_type hv, bool data)
+{
+    log_debug("statement " << stmt << " setBoolAt(" << hv << ", " << data << ')');
+
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setBool(pos[n], data);
 }
 
-void Statement::setInt64(const std::string& col, int64_t data)
+void Statement::setShortAt(size_type hv, short data)
 {
-    log_debug("statement " << stmt << " setInt64(\"" << col << "\", " << data << ')');
+    log_debug("statement " << stmt << " setShortAt(" << hv << ", " << data << ')');
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setInt64(it->second, data);
-    }
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setShort(pos[n], data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setIntAt(size_type hv, int data)
+{
+    log_debug("statement " << stmt << " setIntAt(" << hv << ", " << data << ')');
+
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setInt(pos[n], data);
 }
 
-void Statement::setUnsigned64(const std::string& col, uint64_t data)
+void Statement::setLongAt(size_type hv, long data)
 {
-    log_debug("statement " << stmt << " setUnsigned64(\"" << col << "\", " << data << ')');
+    log_debug("statement " << stmt << " setLongAt(" << hv << ", " << data << ')');
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setUnsigned64(it->second, data);
-    }
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setLong(pos[n], data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setUnsignedShortAt(size_type hv, unsigned short data)
+{
+    log_debug("statement " << stmt << " setUnsignedShortAt(" << hv << ", " << data << ')');
+
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setUnsignedShort(pos[n], data);
 }
 
-void Statement::setDecimal(const std::string& col, const Decimal& data)
+void Statement::setUnsignedAt(size_type hv, unsigned data)
 {
-    log_debug("statement " << stmt << " setDecimal(\"" << col << "\", " << data << ')');
+    log_debug("statement " << stmt << " setUnsignedAt(" << hv << ", " << data << ')');
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setDecimal(it->second, data);
-    }
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setUnsigned(pos[n], data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setUnsignedLongAt(size_type hv, unsigned long data)
+{
+    log_debug("statement " << stmt << " setUnsignedLongAt(" << hv << ", " << data << ')');
+
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setUnsignedLong(pos[n], data);
 }
 
-void Statement::setFloat(const std::string& col, float data)
+void Statement::setInt32At(size_type hv, int32_t data)
 {
-    log_debug("statement " << stmt << " setFloat(\"" << col << "\", " << data << ')');
+    log_debug("statement " << stmt << " setInt32At(" << hv << ", " << data << ')');
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setFloat(it->second, data);
-    }
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setInt32(pos[n], data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setUnsigned32At(size_type hv, uint32_t data)
+{
+    log_debug("statement " << stmt << " setUnsigned32At(" << hv << ", " << data << ')');
+
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setUnsigned32(pos[n], data);
 }
 
-void Statement::setDouble(const std::string& col, double data)
+void Statement::setInt64At(size_type hv, int64_t data)
 {
-    log_debug("statement " << stmt << " setDouble(\"" << col << "\", " << data << ')');
+    log_debug("statement " << stmt << " setInt64At(" << hv << ", " << data << ')');
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setDouble(it->second, data);
-    }
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setInt64(pos[n], data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setUnsigned64At(size_type hv, uint64_t data)
+{
+    log_debug("statement " << stmt << " setUnsigned64At(" << hv << ", " << data << ')');
+
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setUnsigned64(pos[n], data);
 }
 
-void Statement::setChar(const std::string& col, char data)
+void Statement::setDecimalAt(size_type hv, const Decimal& data)
 {
-    log_debug("statement " << stmt << " setChar(\"" << col << "\", " << data << ')');
+    log_debug("statement " << stmt << " setDecimalAt(" << hv << ", " << data << ')');
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setChar(it->second, data);
-    }
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setDecimal(pos[n], data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setFloatAt(size_type hv, float data)
+{
+    log_debug("statement " << stmt << " setFloatAt(" << hv << ", " << data << ')');
+
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setFloat(pos[n], data);
 }
 
-void Statement::setString(const std::string& col, const std::string& data)
+void Statement::setDoubleAt(size_type hv, double data)
 {
-    log_debug("statement " << stmt << " setString(\"" << col << "\", \"" << data << "\")");
+    log_debug("statement " << stmt << " setDoubleAt(" << hv << ", " << data << ')');
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setString(it->second, data);
-    }
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setDouble(pos[n], data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setCharAt(size_type hv, char data)
+{
+    log_debug("statement " << stmt << " setCharAt(" << hv << ", " << data << ')');
+
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setChar(pos[n], data);
 }
 
-void Statement::setBlob(const std::string& col, const Blob& data)
+void Statement::setStringAt(size_type hv, const std::string& data)
 {
-    log_debug("statement " << stmt << " setBlob(\"" << col << "\", data {" << data.size() << "})");
+    log_debug("statement " << stmt << " setStringAt(" << hv << ", \"" << data << "\")");
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setBlob(it->second, data);
-    }
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setString(pos[n], data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setBlobAt(size_type hv, const Blob& data)
+{
+    log_debug("statement " << stmt << " setBlobAt(" << hv << ", data {" << data.size() << "})");
+
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setBlob(pos[n], data);
 }
 
-void Statement::setDate(const std::string& col, const Date& data)
+void Statement::setDateAt(size_type hv, const Date& data)
 {
-    log_debug("statement " << stmt << " setDate(\"" << col << "\", "
+    log_debug("statement " << stmt << " setDateAt(" << hv << ", "
       << data.getIso() << ')');
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setDate(it->second, data);
-    }
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setDate(pos[n], data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setTimeAt(size_type hv, const Time& data)
+{
+    log_debug("statement " << stmt << " setTimeAt(" << hv << ", "
+      << data.getIso() << ')');
+
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setTime(pos[n], data);
 }
 
-void Statement::setTime(const std::string& col, const Time& data)
+void Statement::setDatetimeAt(size_type hv, const Datetime& data)
 {
-    log_debug("statement " << stmt << " setTime(\"" << col << "\", "
+    log_debug("statement " << stmt << " setDatetimeAt(" << hv << ", "
       << data.getIso() << ')');
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setTime(it->second, data);
-    }
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setDatetime(pos[n], data);
+}
 
-    if (!found)
-        throw HostvarNotFound(col);
+void Statement::setStringRef(const std::string& col, const char* data, std::size_t length)
+{
+    setStringRefAt(paramIndex(col), data, length);
 }
 
-void Statement::setDatetime(const std::string& col, const Datetime& data)
+void Statement::setBlobRef(const std::string& col, const char* data, std::size_t length)
 {
-    log_debug("statement " << stmt << " setDatetime(\"" << col << "\", "
-      << data.getIso() << ')');
+    setBlobRefAt(paramIndex(col), data, length);
+}
 
-    bool found = false;
-    for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-         it != hostvarMap.end() && it->first == col; ++it)
-    {
-        found = true;
-        inVars.setDatetime(it->second, data);
-    }
+void Statement::setStringRefAt(size_type hv, const char* data, std::size_t length)
+{
+    log_debug("statement " << stmt << " setStringRefAt(" << hv << ", data, " << length << ')');
 
-    if (!found)
-        throw HostvarNotFound(col);
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setRef(pos[n], data, length);
+}
+
+void Statement::setBlobRefAt(size_type hv, const char* data, std::size_t length)
+{
+    log_debug("statement " << stmt << " setBlobRefAt(" << hv << ", data, " << length << ')');
+
+    const std::vector<unsigned>& pos = paramPositions[hv];
+    for (unsigned n = 0; n < pos.size(); ++n)
+        inVars.setRef(pos[n], data, length);
 }
 
 Statement::size_type Statement::execute()
@@ -520,11 +696,43 @@ Statement::size_type Statement::execute()
     {
         return conn.execute(query);
     }
+    else if (maxDelay > 0)
+    {
+        unsigned params = inVars.getSize();
+        size_type count = 0;
+
+        if (!insertRow.empty())
+        {
+            // the values of a multi row insert are sent in one packet,
+            // which must not exceed max_allowed_packet
+            unsigned long rowBytes = 0;
+            for (unsigned n = 0; n < params; ++n)
+                rowBytes += paramSize(inVars.getMysqlBind()[n]);
+
+            unsigned long maxBytes = conn.getMaxAllowedPacket();
+            maxBytes = maxBytes > 2 * packetHeaderSize ? maxBytes - packetHeaderSize : maxBytes / 2;
+            if (delayedRows > 0 && delayedBytes + rowBytes > maxBytes)
+            {
+                log_debug("flush " << delayedRows << " delayed rows before the packet exceeds " << maxBytes << " bytes");
+                count = flush();
+            }
+
+            delayedBytes += rowBytes;
+        }
+
+        for (unsigned n = 0; n < params; ++n)
+            delayedVars.setValue(delayedRows * params + n, inVars.getMysqlBind()[n]);
+
+        if (++delayedRows >= maxDelay)
+            count += flush();
+
+        return count;
+    }
     else
     {
         // use statement-API
         stmt = getStmt();
-        execute(stmt, 16);
+        execute(stmt, fetchSize);
         return mysql_stmt_affected_rows(stmt);
     }
 }
@@ -533,26 +741,39 @@ tntdb::Result Statement::select()
 {
     log_debug("select");
 
+    if (streaming)
+        return tntdb::Result(std::make_shared<StreamResult>(shared_from_this()));
+
     if (hostvarMap.empty())
         return conn.select(query);
 
-    if (fields)
-        getRow();
+    // size the fetch buffer by the column widths of the previous executions
+    if (rowPtr && rowPtr.unique())
+        initOutBuffers(*rowPtr);
 
     stmt = getStmt();
-    execute(stmt, 16);
-
-    if (mysql_stmt_store_result(stmt) != 0)
-        throw MysqlStmtError("mysql_stmt_store_result", stmt);
+    execute(stmt, fetchSize);
 
-    auto result = std::make_shared<RowContainer>();
+    // The rows are read from the connection one by one into the bind
+    // buffer of the statement and packed into the result, so they are not
+    // buffered by mysql_stmt_store_result in addition.
+    auto result = std::make_shared<PackedResult>(getSchema());
 
-    while (true)
+    try
     {
-        auto ptr = fetchRow();
-        if (!ptr)
-            break;
-        result->addRow(ptr);
+        while (true)
+        {
+            auto ptr = fetchRow();
+            if (!ptr)
+                break;
+            result->addRow(ptr->getMysqlBind());
+        }
+    }
+    catch (...)
+    {
+        log_debug("mysql_stmt_free_result(" << stmt << ')');
+        ::mysql_stmt_free_result(stmt);
+        throw;
     }
 
     return tntdb::Result(result);
@@ -562,8 +783,8 @@ std::shared_ptr<BoundRow> Statement::selectBoundRow()
 {
     log_debug("selectRow");
 
-    if (fields)
-        getRow();
+    if (rowPtr && rowPtr.unique())
+        initOutBuffers(*rowPtr);
 
     stmt = getStmt();
     execute(stmt, 1);
@@ -600,63 +821,217 @@ tntdb::Value Statement::selectValue()
 
 std::shared_ptr<ICursor> Statement::createCursor(unsigned fetchsize)
 {
-    return std::make_shared<Cursor>(*this, fetchsize);
+    return std::make_shared<Cursor>(shared_from_this(), fetchsize);
 }
 
-MYSQL_STMT* Statement::createStmt()
+void Statement::maxNumDelay(size_type n)
 {
-    MYSQL_STMT* result = getStmt();
-    stmt = 0;
-    return result;
+    flush();
+
+    if (batchStmt)
+    {
+        log_debug("mysql_stmt_close(" << batchStmt << ')');
+        ::mysql_stmt_close(batchStmt);
+        batchStmt = 0;
+    }
+
+    maxDelay = n;
+    delayedVars.setSize(n * inVars.getSize());
 }
 
-MYSQL_STMT* Statement::getStmt()
+Statement::size_type Statement::numDelayed() const
 {
-    if (stmt)
-        return stmt;
+    return delayedRows;
+}
+
+void Statement::setStreaming(bool sw)
+{
+    streaming = sw;
+}
+
+bool Statement::isStreaming() const
+{
+    return streaming;
+}
+
+void Statement::setFetchSize(unsigned n)
+{
+    fetchSize = n > 0 ? n : 1;
+}
+
+unsigned Statement::getFetchSize() const
+{
+    return fetchSize;
+}
+
+MYSQL_STMT* Statement::prepareBatch(unsigned rows)
+{
+    std::string sql = insertPrefix;
+    sql.reserve(insertPrefix.size() + rows * (insertRow.size() + 1) + insertSuffix.size());
+    for (unsigned n = 0; n < rows; ++n)
+    {
+        if (n > 0)
+            sql += ',';
+        sql += insertRow;
+    }
+    sql += insertSuffix;
 
-    // initialize statement
     log_debug("mysql_stmt_init(" << mysql << ')');
-    stmt = ::mysql_stmt_init(mysql);
-    if (stmt == 0)
+    MYSQL_STMT* s = ::mysql_stmt_init(mysql);
+    if (s == 0)
         throw MysqlError(mysql);
-    log_debug("mysql_stmt_init(" << mysql << ") => " << stmt);
 
-    log_debug("mysql_stmt_prepare(" << stmt << ", \"" << query << "\")");
-    if (mysql_stmt_prepare(stmt, query.data(), query.size()) != 0)
+    log_debug("mysql_stmt_prepare(" << s << ", \"" << insertPrefix << "... " << rows << " rows\")");
+    if (mysql_stmt_prepare(s, sql.data(), sql.size()) != 0)
     {
-        // MysqlStmtError fetches the last error from MYSQL_STMT, so we need
-        // to instantiate this before mysql_stmt_close
-        MysqlStmtError e("mysql_stmt_prepare", stmt);
-        log_debug("mysql_stmt_close(" << stmt << ')');
-        ::mysql_stmt_close(stmt);
-        stmt = 0;
+        MysqlStmtError e("mysql_stmt_prepare", s);
+        log_debug("mysql_stmt_close(" << s << ')');
+        ::mysql_stmt_close(s);
         throw e;
     }
 
-  /*
-    // read always with cursor
-    log_debug("mysql_stmt_attr_set(" << stmt << ", STMT_ATTR_CURSOR_TYPE)");
-    unsigned long cursorType = CURSOR_TYPE_READ_ONLY;
-    if (mysql_stmt_attr_set(stmt, STMT_ATTR_CURSOR_TYPE, &cursorType) != 0)
+    return s;
+}
+
+Statement::size_type Statement::executeBatch(MYSQL_STMT* s, MYSQL_BIND* bind)
+{
+    log_debug("mysql_stmt_bind_param(" << s << ')');
+    if (mysql_stmt_bind_param(s, bind) != 0)
+        throw MysqlStmtError("mysql_stmt_bind_param", s);
+
+    log_debug("mysql_stmt_execute(" << s << ')');
+    if (mysql_stmt_execute(s) != 0)
+        throw MysqlStmtError("mysql_stmt_execute", s);
+
+    return mysql_stmt_affected_rows(s);
+}
+
+Statement::size_type Statement::flush()
+{
+    if (delayedRows == 0)
+        return 0;
+
+    log_debug("flush " << delayedRows << " delayed statements");
+
+    // the delayed statements are discarded also when the execution fails
+    unsigned rows = delayedRows;
+    delayedRows = 0;
+    delayedBytes = 0;
+
+    unsigned params = inVars.getSize();
+    MYSQL_BIND* bind = delayedVars.getMysqlBind();
+    size_type count = 0;
+
+    if (insertRow.empty())
     {
-        log_debug("error");
+        stmt = getStmt();
+        ++generation;
+        for (unsigned n = 0; n < rows; ++n)
+            count += executeBatch(stmt, bind + n * params);
+    }
+    else
+    {
+        // a prepared statement may have at most 65535 placeholders
+        unsigned maxRows = std::max(65535u / params, 1u);
 
-        MysqlStmtError e("mysql_stmt_attr_set", stmt);
-        log_debug("mysql_stmt_close(" << stmt << ')');
-        ::mysql_stmt_close(stmt);
+        for (unsigned row = 0; row < rows; )
+        {
+            unsigned n = std::min(rows - row, maxRows);
+
+            if (n == std::min<unsigned>(maxDelay, maxRows))
+            {
+                // full batches reuse the prepared statement
+                if (batchStmt == 0)
+                    batchStmt = prepareBatch(n);
+
+                count += executeBatch(batchStmt, bind + row * params);
+            }
+            else
+            {
+                MYSQL_STMT* s = prepareBatch(n);
+                try
+                {
+                    count += executeBatch(s, bind + row * params);
+                }
+                catch (...)
+                {
+                    ::mysql_stmt_close(s);
+                    throw;
+                }
+
+                log_debug("mysql_stmt_close(" << s << ')');
+                ::mysql_stmt_close(s);
+            }
+
+            row += n;
+        }
+    }
+
+    return count;
+}
+
+MYSQL_STMT* Statement::acquireStmt()
+{
+    if (!cursorStmts.empty())
+    {
+        MYSQL_STMT* result = cursorStmts.back();
+        cursorStmts.pop_back();
+        log_debug("reuse prepared statement " << result);
+        return result;
+    }
+
+    return prepareStmt();
+}
+
+void Statement::releaseStmt(MYSQL_STMT* s)
+{
+    // closes the cursor and discards unread rows
+    log_debug("mysql_stmt_reset(" << s << ')');
+    if (mysql_stmt_reset(s) != 0)
+    {
+        log_warn("mysql_stmt_reset failed: " << mysql_stmt_error(s));
+        log_debug("mysql_stmt_close(" << s << ')');
+        ::mysql_stmt_close(s);
+        return;
+    }
+
+    cursorStmts.push_back(s);
+}
+
+MYSQL_STMT* Statement::getStmt()
+{
+    if (stmt == 0)
+        stmt = prepareStmt();
+    return stmt;
+}
+
+MYSQL_STMT* Statement::prepareStmt()
+{
+    // initialize statement
+    log_debug("mysql_stmt_init(" << mysql << ')');
+    MYSQL_STMT* s = ::mysql_stmt_init(mysql);
+    if (s == 0)
+        throw MysqlError(mysql);
+    log_debug("mysql_stmt_init(" << mysql << ") => " << s);
+
+    log_debug("mysql_stmt_prepare(" << s << ", \"" << query << "\")");
+    if (mysql_stmt_prepare(s, query.data(), query.size()) != 0)
+    {
+        // MysqlStmtError fetches the last error from MYSQL_STMT, so we need
+        // to instantiate this before mysql_stmt_close
+        MysqlStmtError e("mysql_stmt_prepare", s);
+        log_debug("mysql_stmt_close(" << s << ')');
+        ::mysql_stmt_close(s);
         throw e;
     }
-  */
 
     // check parametercount
-    log_debug("mysql_stmt_param_count(" << stmt << ')');
-    unsigned param_count = mysql_stmt_param_count(stmt);
+    log_debug("mysql_stmt_param_count(" << s << ')');
+    unsigned param_count = mysql_stmt_param_count(s);
     if (param_count != inVars.getSize())
     {
-        log_debug("mysql_stmt_close(" << stmt << ')');
-        ::mysql_stmt_close(stmt);
-        stmt = 0;
+        log_debug("mysql_stmt_close(" << s << ')');
+        ::mysql_stmt_close(s);
         std::ostringstream msg;
         msg << "invalid parametercount in query; "
             << inVars.getSize() << " expected "
@@ -664,12 +1039,15 @@ MYSQL_STMT* Statement::getStmt()
         throw std::runtime_error(msg.str());
     }
 
-    log_debug("statement initialized " << stmt);
-    return stmt;
+    log_debug("statement initialized " << s);
+    return s;
 }
 
 void Statement::execute(MYSQL_STMT* stmt, unsigned fetchsize)
 {
+    if (stmt == this->stmt)
+        ++generation;
+
     // fetch multiple rows at once
     log_debug("mysql_stmt_attr_set(STMT_ATTR_PREFETCH_ROWS, " << fetchsize << ")");
     unsigned long count = fetchsize;
@@ -704,6 +1082,12 @@ MYSQL_FIELD* Statement::getFields()
         log_debug("mysql_num_fields(" << metadata << ')');
         field_count = mysql_num_fields(metadata);
 
+        std::shared_ptr<ResultSchema> s = std::make_shared<ResultSchema>();
+        s->reserve(field_count);
+        for (unsigned n = 0; n < field_count; ++n)
+            s->add(fields[n].name);
+        schema = s;
+
         log_debug("mysql_free_result(" << metadata << ") (metadata)");
         ::mysql_free_result(metadata);
     }
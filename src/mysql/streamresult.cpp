@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/mysql/impl/streamresult.h>
+#include <tntdb/mysql/impl/statement.h>
+#include <tntdb/mysql/impl/boundrow.h>
+#include <tntdb/mysql/impl/boundvalue.h>
+#include <tntdb/mysql/error.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/error.h>
+#include <stdexcept>
+#include <cxxtools/log.h>
+
+log_define("tntdb.mysql.streamresult")
+
+namespace tntdb
+{
+namespace mysql
+{
+StreamResult::StreamResult(const std::shared_ptr<Statement>& statement)
+  : _statement(statement),
+    _params(statement->inVars.getSize()),
+    _fetchSize(statement->fetchSize),
+    _generation(0),
+    _schema(statement->getSchema()),
+    _pos(0),
+    _eof(false),
+    _sizeKnown(false),
+    _size(0)
+{
+    // the statement may be executed again with other values, while the
+    // result is rewound
+    for (unsigned n = 0; n < _params.getSize(); ++n)
+        _params.setValue(n, statement->inVars.getMysqlBind()[n]);
+
+    execute();
+}
+
+StreamResult::~StreamResult()
+{
+    // close the server side cursor
+    if (_statement->generation == _generation && _statement->stmt)
+    {
+        log_debug("mysql_stmt_free_result(" << _statement->stmt << ')');
+        if (mysql_stmt_free_result(_statement->stmt) != 0)
+            log_warn("failed to close cursor: " << mysql_stmt_error(_statement->stmt));
+    }
+}
+
+MYSQL_STMT* StreamResult::getStmt() const
+{
+    if (_statement->generation != _generation || _statement->stmt == 0)
+        throw Error("streaming result is invalid since the statement was used again");
+    return _statement->stmt;
+}
+
+void StreamResult::execute() const
+{
+    MYSQL_STMT* stmt = _statement->getStmt();
+
+    log_debug("mysql_stmt_attr_set(STMT_ATTR_PREFETCH_ROWS, " << _fetchSize << ")");
+    unsigned long count = _fetchSize;
+    if (mysql_stmt_attr_set(stmt, STMT_ATTR_PREFETCH_ROWS, &count) != 0)
+        throw MysqlStmtError("mysql_stmt_attr_set", stmt);
+
+    log_debug("mysql_stmt_bind_param(" << stmt << ')');
+    if (mysql_stmt_bind_param(stmt, _params.getMysqlBind()) != 0)
+        throw MysqlStmtError("mysql_stmt_bind_param", stmt);
+
+    // The cursor type is read on execution only, so it is reset right
+    // afterwards for the other uses of the statement.
+    log_debug("mysql_stmt_attr_set(" << stmt << ", STMT_ATTR_CURSOR_TYPE, CURSOR_TYPE_READ_ONLY)");
+    unsigned long cursorType = CURSOR_TYPE_READ_ONLY;
+    if (mysql_stmt_attr_set(stmt, STMT_ATTR_CURSOR_TYPE, &cursorType) != 0)
+        throw MysqlStmtError("mysql_stmt_attr_set", stmt);
+
+    log_debug("mysql_stmt_execute(" << stmt << ')');
+    int ret = mysql_stmt_execute(stmt);
+
+    cursorType = CURSOR_TYPE_NO_CURSOR;
+    mysql_stmt_attr_set(stmt, STMT_ATTR_CURSOR_TYPE, &cursorType);
+
+    if (ret != 0)
+        throw MysqlStmtError("mysql_stmt_execute", stmt);
+
+    _generation = ++_statement->generation;
+    _pos = 0;
+    _eof = false;
+}
+
+void StreamResult::bindRow() const
+{
+    // values of the current row are still referenced - fetch into a new buffer
+    if (!_row || !_row.unique())
+    {
+        _row = std::make_shared<BoundRow>(_schema->size());
+        _row->setSchema(_schema);
+        _statement->initOutBuffers(*_row);
+    }
+    else
+        _row->clear();
+
+    MYSQL_STMT* stmt = getStmt();
+    log_debug("mysql_stmt_bind_result(" << stmt << ", " << _row->getMysqlBind() << ')');
+    if (mysql_stmt_bind_result(stmt, _row->getMysqlBind()) != 0)
+        throw MysqlStmtError("mysql_stmt_bind_result", stmt);
+}
+
+bool StreamResult::fetch() const
+{
+    MYSQL_STMT* stmt = getStmt();
+
+    bindRow();
+
+    log_debug("mysql_stmt_fetch(" << stmt << ')');
+    int ret = mysql_stmt_fetch(stmt);
+
+    if (ret == MYSQL_DATA_TRUNCATED)
+        _statement->fetchTruncated(stmt, *_row);
+    else if (ret == MYSQL_NO_DATA)
+    {
+        log_debug("MYSQL_NO_DATA");
+        _row.reset();
+        _eof = true;
+        _sizeKnown = true;
+        _size = _pos;
+        return false;
+    }
+    else if (ret == 1)
+        throw MysqlStmtError("mysql_stmt_fetch", stmt);
+
+    _statement->updateColumnWidths(*_row);
+
+    ++_pos;
+    return true;
+}
+
+void StreamResult::moveTo(size_type tup_num) const
+{
+    if (_sizeKnown && tup_num >= _size)
+        throw std::out_of_range("row number out of range");
+
+    if (_eof || _pos > tup_num + 1)
+    {
+        log_debug("execute streaming result again for row " << tup_num);
+        getStmt();
+        execute();
+    }
+
+    while (_pos <= tup_num)
+        if (!fetch())
+            throw std::out_of_range("row number out of range");
+}
+
+Row StreamResult::getRow(size_type tup_num) const
+{
+    if (_sizeKnown && tup_num >= _size)
+        throw std::out_of_range("row number out of range");
+
+    return Row(std::make_shared<StreamRow>(shared_from_this(), tup_num));
+}
+
+StreamResult::size_type StreamResult::size() const
+{
+    // the rows are counted by fetching to the end; they are fetched again
+    // when they are accessed later
+    while (!_sizeKnown)
+        fetch();
+
+    return _size;
+}
+
+StreamResult::size_type StreamResult::getFieldCount() const
+{
+    return _schema->size();
+}
+
+Value StreamResult::getValue(size_type tup_num, size_type field_num) const
+{
+    moveTo(tup_num);
+
+    if (field_num >= _row->getSize())
+        throw std::out_of_range("field number out of range");
+
+    return Value(std::make_shared<BoundValue>(_row, _row->getMysqlBind()[field_num]));
+}
+
+StreamRow::size_type StreamRow::size() const
+{
+    return _result->getFieldCount();
+}
+
+Value StreamRow::getValueByNumber(size_type field_num) const
+{
+    return _result->getValue(_tupNum, field_num);
+}
+
+Value StreamRow::getValueByName(const std::string& field_name) const
+{
+    return _result->getValue(_tupNum, _result->getSchema().getFieldNumber(field_name));
+}
+
+std::string StreamRow::getColumnName(size_type field_num) const
+{
+    return _result->getSchema().getName(field_num);
+}
+
+StreamRow::size_type StreamRow::getFieldNumber(const std::string& field_name) const
+{
+    return _result->getSchema().getFieldNumber(field_name);
+}
+
+const ResultSchema* StreamRow::getSchema() const
+{
+    return &_result->getSchema();
+}
+
+}
+}
@@ -27,33 +27,76 @@
  */
 
 #include <tntdb/impl/poolconnection.h>
+#include <tntdb/impl/poolstatement.h>
 #include <tntdb/bits/connection.h>
 #include <tntdb/bits/result.h>
 #include <tntdb/bits/row.h>
 #include <tntdb/bits/value.h>
+#include <tntdb/error.h>
+#include <tntdb/statementcache.h>
 #include <cxxtools/log.h>
+#include <exception>
 
 log_define("tntdb.poolconnection")
 
 namespace tntdb
 {
-PoolConnection::PoolConnection(std::shared_ptr<IConnection>&& connection, ConnectionPool& connectionPool)
+PoolConnection::PoolConnection(std::shared_ptr<IConnection>&& connection, std::shared_ptr<StatementCache>&& statementCache,
+                               std::shared_ptr<bool>&& suspect, ConnectionPool::Clock::time_point created, ConnectionPool& connectionPool)
     : _connectionPool(connectionPool),
       _connection(connection),
+      _statementCache(statementCache),
+      _created(created),
       _inTransaction(false),
-      _drop(false)
+      _inPipeline(false),
+      _drop(false),
+      _suspect(suspect ? std::move(suspect) : std::make_shared<bool>(false))
 {
+    *_suspect = false;
     log_debug("PoolConnection " << this << " for connection " << _connection);
 }
 
 PoolConnection::~PoolConnection()
 {
     // don't put the connection back to the free pool, when there is a
-    // pending transaction or something unusual has happened
-    if (_inTransaction || _drop)
+    // pending transaction or pipeline or something unusual has happened
+    if (_inTransaction || _inPipeline || _drop)
+    {
         log_debug("don't reuse connection " << _connection);
-   else
-       _connectionPool.put(_connection);
+        _statementCache.reset();
+        _connection.reset();
+        _connectionPool.discard();
+        return;
+    }
+
+    // the statements stay prepared for the next checkout, but nothing of the
+    // current user may leak into it
+    if (_statementCache)
+    {
+        try
+        {
+            _statementCache->reset();
+        }
+        catch (const std::exception& e)
+        {
+            log_warn("failed to reset cached statements: " << e.what() << "; don't reuse connection " << _connection);
+            _statementCache.reset();
+            _connection.reset();
+            _connectionPool.discard();
+            return;
+        }
+    }
+
+    // when the connection is released while an exception is propagated,
+    // the connection may be broken
+#if __cplusplus >= 201703L
+    if (std::uncaught_exceptions() > 0)
+#else
+    if (std::uncaught_exception())
+#endif
+        *_suspect = true;
+
+    _connectionPool.put(_connection, _statementCache, _created, _suspect);
 }
 
 void PoolConnection::beginTransaction()
@@ -81,32 +124,63 @@ void PoolConnection::rollbackTransaction()
 
 PoolConnection::size_type PoolConnection::execute(const std::string& query)
 {
-    return _connection->execute(query);
+    return trackErrors(*_suspect, [&]() { return _connection->execute(query); });
 }
 
 Result PoolConnection::select(const std::string& query)
 {
-    return _connection->select(query);
+    return trackErrors(*_suspect, [&]() { return _connection->select(query); });
 }
 
 Row PoolConnection::selectRow(const std::string& query)
 {
-    return _connection->selectRow(query);
+    return trackErrors(*_suspect, [&]() { return _connection->selectRow(query); });
 }
 
 Value PoolConnection::selectValue(const std::string& query)
 {
-    return _connection->selectValue(query);
+    return trackErrors(*_suspect, [&]() { return _connection->selectValue(query); });
+}
+
+// Errors of the statements mark the connection as suspect as well.
+Statement PoolConnection::wrap(const Statement& stmt)
+{
+    return Statement(std::make_shared<PoolStatement>(stmt, _suspect));
 }
 
 Statement PoolConnection::prepareWithLimit(const std::string& query, const std::string& limit, const std::string& offset)
 {
-    return _connection->prepareWithLimit(query, limit, offset);
+    return wrap(trackErrors(*_suspect, [&]() { return _connection->prepareWithLimit(query, limit, offset); }));
 }
 
 Statement PoolConnection::prepare(const std::string& query)
 {
-    return _connection->prepare(query);
+    return wrap(trackErrors(*_suspect, [&]() { return _connection->prepare(query); }));
+}
+
+Statement PoolConnection::prepareBulkLoad(const std::string& table, const std::vector<std::string>& columns)
+{
+    return wrap(trackErrors(*_suspect, [&]() { return _connection->prepareBulkLoad(table, columns); }));
+}
+
+PoolConnection::size_type PoolConnection::copyOut(const std::string& query, std::ostream& out)
+{
+    return _connection->copyOut(query, out);
+}
+
+PoolConnection::size_type PoolConnection::copyOutRows(const std::string& query, const std::function<void (const Row&)>& callback)
+{
+    return _connection->copyOutRows(query, callback);
+}
+
+// The cache is kept with the connection in the pool, so that the prepared
+// statements are reused by the next checkout. The limits of the first
+// checkout, which uses the cache, are kept.
+StatementCache* PoolConnection::getStatementCache(unsigned maxSize, std::chrono::milliseconds maxAge)
+{
+    if (!_statementCache)
+        _statementCache = std::make_shared<StatementCache>(maxSize, maxAge);
+    return _statementCache.get();
 }
 
 bool PoolConnection::ping()
@@ -127,4 +201,37 @@ void PoolConnection::lockTable(const std::string& tablename, bool exclusive)
     _connection->lockTable(tablename, exclusive);
 }
 
+void PoolConnection::beginPipeline()
+{
+    _connection->beginPipeline();
+    _inPipeline = true;
+}
+
+PoolConnection::size_type PoolConnection::syncPipeline()
+{
+    try
+    {
+        return _connection->syncPipeline();
+    }
+    catch (const Error&)
+    {
+        *_suspect = true;
+        throw;
+    }
+}
+
+void PoolConnection::endPipeline()
+{
+    try
+    {
+        _connection->endPipeline();
+        _inPipeline = false;
+    }
+    catch (const Error&)
+    {
+        *_suspect = true;
+        throw;
+    }
+}
+
 }
@@ -0,0 +1,573 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/postgresql/impl/binaryformat.h>
+#include <tntdb/error.h>
+#include <cxxtools/convert.h>
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <vector>
+#include <string.h>
+
+namespace tntdb
+{
+namespace postgresql
+{
+namespace
+{
+    // days from 1970-01-01 to 2000-01-01, the epoch of postgresql
+    const int64_t pgEpochDays = 10957;
+    const int64_t usecsPerDay = 86400000000LL;
+
+    void putUint16(std::string& s, uint16_t v)
+    {
+        s += static_cast<char>(v >> 8);
+        s += static_cast<char>(v);
+    }
+
+    void putUint32(std::string& s, uint32_t v)
+    {
+        putUint16(s, static_cast<uint16_t>(v >> 16));
+        putUint16(s, static_cast<uint16_t>(v));
+    }
+
+    void putUint64(std::string& s, uint64_t v)
+    {
+        putUint32(s, static_cast<uint32_t>(v >> 32));
+        putUint32(s, static_cast<uint32_t>(v));
+    }
+
+    uint16_t getUint16(const char* p)
+    {
+        const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+        return static_cast<uint16_t>((u[0] << 8) | u[1]);
+    }
+
+    uint32_t getUint32(const char* p)
+    {
+        return (static_cast<uint32_t>(getUint16(p)) << 16) | getUint16(p + 2);
+    }
+
+    uint64_t getUint64(const char* p)
+    {
+        return (static_cast<uint64_t>(getUint32(p)) << 32) | getUint32(p + 4);
+    }
+
+    void checkLength(int len, int expected, const char* type)
+    {
+        if (len != expected)
+        {
+            std::ostringstream msg;
+            msg << "invalid length " << len << " of binary " << type << " value";
+            throw TypeError(msg.str());
+        }
+    }
+
+    int64_t floorDiv(int64_t a, int64_t b)
+    {
+        return a >= 0 ? a / b : -((-a + b - 1) / b);
+    }
+
+    // see http://howardhinnant.github.io/date_algorithms.html
+    int64_t daysFromCivil(int64_t y, unsigned m, unsigned d)
+    {
+        y -= m <= 2;
+        int64_t era = floorDiv(y, 400);
+        unsigned yoe = static_cast<unsigned>(y - era * 400);
+        unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+        unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<int64_t>(doe) - 719468;
+    }
+
+    Date civilFromDays(int64_t z)
+    {
+        z += 719468;
+        int64_t era = floorDiv(z, 146097);
+        unsigned doe = static_cast<unsigned>(z - era * 146097);
+        unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        unsigned mp = (5 * doy + 2) / 153;
+        unsigned d = doy - (153 * mp + 2) / 5 + 1;
+        unsigned m = mp < 10 ? mp + 3 : mp - 9;
+        int64_t y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+        return Date(static_cast<unsigned short>(y), m, d);
+    }
+
+    int64_t timeUsecs(unsigned hour, unsigned minute, unsigned second, unsigned millis)
+    {
+        return ((static_cast<int64_t>(hour) * 60 + minute) * 60 + second) * 1000000
+             + static_cast<int64_t>(millis) * 1000;
+    }
+
+    // rounds a number of microseconds to milliseconds like the text format parser
+    Time timeFromUsecs(int64_t usecs)
+    {
+        int64_t millis = (usecs + 500) / 1000;
+        return Time(static_cast<unsigned short>(millis / 3600000),
+                    static_cast<unsigned short>(millis / 60000 % 60),
+                    static_cast<unsigned short>(millis / 1000 % 60),
+                    static_cast<unsigned short>(millis % 1000));
+    }
+
+    void appendDigits(std::string& s, unsigned value, unsigned width)
+    {
+        char buffer[8];
+        for (unsigned n = width; n > 0; --n)
+        {
+            buffer[n - 1] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        s.append(buffer, width);
+    }
+
+    // formats microseconds since midnight as HH:MM:SS[.ffffff]
+    void appendTime(std::string& s, int64_t usecs)
+    {
+        appendDigits(s, static_cast<unsigned>(usecs / 3600000000LL), 2);
+        s += ':';
+        appendDigits(s, static_cast<unsigned>(usecs / 60000000 % 60), 2);
+        s += ':';
+        appendDigits(s, static_cast<unsigned>(usecs / 1000000 % 60), 2);
+
+        unsigned fraction = static_cast<unsigned>(usecs % 1000000);
+        if (fraction != 0)
+        {
+            unsigned width = 6;
+            while (fraction % 10 == 0)
+            {
+                fraction /= 10;
+                --width;
+            }
+            s += '.';
+            appendDigits(s, fraction, width);
+        }
+    }
+
+    template <typename T>
+    std::string floatToString(T value)
+    {
+        if (value != value)
+            return "NaN";
+        else if (value == std::numeric_limits<T>::infinity())
+            return "Infinity";
+        else if (value == -std::numeric_limits<T>::infinity())
+            return "-Infinity";
+        else
+            return cxxtools::convert<std::string>(value);
+    }
+
+    template <typename T>
+    std::string floatToText(T data)
+    {
+        if (data != data || data == std::numeric_limits<T>::infinity() || data == -std::numeric_limits<T>::infinity())
+            return floatToString(data);
+
+        std::ostringstream v;
+        v.precision(24);
+        v << data;
+        return v.str();
+    }
+}
+
+bool isTextType(Oid type)
+{
+    switch (type)
+    {
+        case CHAROID:
+        case NAMEOID:
+        case TEXTOID:
+        case JSONOID:
+        case XMLOID:
+        case UNKNOWNOID:
+        case BPCHAROID:
+        case VARCHAROID:
+            return true;
+    }
+
+    return false;
+}
+
+std::string encodeText(bool data)               { return data ? "1" : "0"; }
+std::string encodeText(int16_t data)            { return cxxtools::convert<std::string>(data); }
+std::string encodeText(int32_t data)            { return cxxtools::convert<std::string>(data); }
+std::string encodeText(int64_t data)            { return cxxtools::convert<std::string>(data); }
+std::string encodeText(float data)              { return floatToText(data); }
+std::string encodeText(double data)             { return floatToText(data); }
+std::string encodeText(const Decimal& data)     { return data.toString(); }
+std::string encodeText(const Date& data)        { return data.getIso(); }
+std::string encodeText(const Time& data)        { return data.getIso(); }
+std::string encodeText(const Datetime& data)    { return data.getIso(); }
+
+std::string encodeBinary(bool data)
+{
+    return std::string(1, data ? '\1' : '\0');
+}
+
+std::string encodeBinary(int16_t data)
+{
+    std::string ret;
+    putUint16(ret, static_cast<uint16_t>(data));
+    return ret;
+}
+
+std::string encodeBinary(int32_t data)
+{
+    std::string ret;
+    putUint32(ret, static_cast<uint32_t>(data));
+    return ret;
+}
+
+std::string encodeBinary(int64_t data)
+{
+    std::string ret;
+    putUint64(ret, static_cast<uint64_t>(data));
+    return ret;
+}
+
+std::string encodeBinary(float data)
+{
+    uint32_t v;
+    ::memcpy(&v, &data, sizeof(v));
+    std::string ret;
+    putUint32(ret, v);
+    return ret;
+}
+
+std::string encodeBinary(double data)
+{
+    uint64_t v;
+    ::memcpy(&v, &data, sizeof(v));
+    std::string ret;
+    putUint64(ret, v);
+    return ret;
+}
+
+std::string encodeBinary(const Decimal& data)
+{
+    // A numeric is sent as a header of ndigits, weight, sign and dscale
+    // followed by ndigits digits of base 10000. The weight is the exponent
+    // of the first digit.
+    std::string ret;
+
+    if (data.isNaN() || data.isInfinity(true) || data.isInfinity(false))
+    {
+        putUint16(ret, 0);
+        putUint16(ret, 0);
+        putUint16(ret, data.isNaN() ? 0xC000 : data.isPositiveInfinity() ? 0xD000 : 0xF000);
+        putUint16(ret, 0);
+        return ret;
+    }
+
+    const std::string& mantissa = data.mantissa();
+    int exponent = data.exponent();
+
+    std::vector<uint16_t> digits;
+    int weight = 0;
+    int dscale = 0;
+
+    if (!data.isZero())
+    {
+        dscale = std::max(0, static_cast<int>(mantissa.size()) - exponent);
+
+        // the decimal value is 0.<mantissa> * 10^exponent
+        weight = static_cast<int>(floorDiv(exponent - 1, 4));
+        int last = static_cast<int>(floorDiv(exponent - static_cast<int>(mantissa.size()), 4));
+        digits.resize(weight - last + 1);
+
+        static const uint16_t pow10[] = { 1, 10, 100, 1000 };
+        for (unsigned n = 0; n < mantissa.size(); ++n)
+        {
+            int p = exponent - 1 - static_cast<int>(n);
+            int g = static_cast<int>(floorDiv(p, 4));
+            digits[weight - g] += (mantissa[n] - '0') * pow10[p - 4 * g];
+        }
+
+        while (!digits.empty() && digits.back() == 0)
+            digits.pop_back();
+    }
+
+    putUint16(ret, static_cast<uint16_t>(digits.size()));
+    putUint16(ret, static_cast<uint16_t>(weight));
+    putUint16(ret, data.negative() && !digits.empty() ? 0x4000 : 0x0000);
+    putUint16(ret, static_cast<uint16_t>(dscale));
+    for (unsigned n = 0; n < digits.size(); ++n)
+        putUint16(ret, digits[n]);
+
+    return ret;
+}
+
+std::string encodeBinary(const Date& data)
+{
+    int64_t days = daysFromCivil(data.getYear(), data.getMonth(), data.getDay()) - pgEpochDays;
+    return encodeBinary(static_cast<int32_t>(days));
+}
+
+std::string encodeBinary(const Time& data)
+{
+    return encodeBinary(timeUsecs(data.getHour(), data.getMinute(), data.getSecond(), data.getMillis()));
+}
+
+std::string encodeBinary(const Datetime& data)
+{
+    int64_t days = daysFromCivil(data.getYear(), data.getMonth(), data.getDay()) - pgEpochDays;
+    return encodeBinary(days * usecsPerDay
+        + timeUsecs(data.getHour(), data.getMinute(), data.getSecond(), data.getMillis()));
+}
+
+bool decodeBool(const char* data, int len)
+{
+    checkLength(len, 1, "bool");
+    return data[0] != 0;
+}
+
+int64_t decodeInteger(Oid type, const char* data, int len)
+{
+    switch (type)
+    {
+        case INT2OID:
+            checkLength(len, 2, "int2");
+            return static_cast<int16_t>(getUint16(data));
+
+        case INT4OID:
+            checkLength(len, 4, "int4");
+            return static_cast<int32_t>(getUint32(data));
+
+        case OIDOID:
+            checkLength(len, 4, "oid");
+            return getUint32(data);
+
+        case INT8OID:
+            checkLength(len, 8, "int8");
+            return static_cast<int64_t>(getUint64(data));
+    }
+
+    std::ostringstream msg;
+    msg << "type oid " << type << " is not an integer type";
+    throw TypeError(msg.str());
+}
+
+double decodeFloat(Oid type, const char* data, int len)
+{
+    if (type == FLOAT4OID)
+    {
+        checkLength(len, 4, "float4");
+        uint32_t v = getUint32(data);
+        float ret;
+        ::memcpy(&ret, &v, sizeof(ret));
+        return ret;
+    }
+    else if (type == FLOAT8OID)
+    {
+        checkLength(len, 8, "float8");
+        uint64_t v = getUint64(data);
+        double ret;
+        ::memcpy(&ret, &v, sizeof(ret));
+        return ret;
+    }
+
+    return static_cast<double>(decodeInteger(type, data, len));
+}
+
+std::string decodeNumeric(const char* data, int len)
+{
+    if (len < 8)
+        checkLength(len, 8, "numeric");
+
+    int ndigits = getUint16(data);
+    int weight = static_cast<int16_t>(getUint16(data + 2));
+    uint16_t sign = getUint16(data + 4);
+    unsigned dscale = getUint16(data + 6);
+
+    checkLength(len, 8 + 2 * ndigits, "numeric");
+
+    if (sign == 0xC000)
+        return "NaN";
+    else if (sign == 0xD000)
+        return "Infinity";
+    else if (sign == 0xF000)
+        return "-Infinity";
+
+    const char* digits = data + 8;
+
+    std::string ret;
+    if (sign == 0x4000)
+        ret = '-';
+
+    if (weight < 0)
+        ret += '0';
+    else
+    {
+        for (int n = 0; n <= weight; ++n)
+        {
+            unsigned digit = n < ndigits ? getUint16(digits + 2 * n) : 0;
+            if (n == 0)
+                ret += cxxtools::convert<std::string>(digit);
+            else
+                appendDigits(ret, digit, 4);
+        }
+    }
+
+    if (dscale > 0)
+    {
+        ret += '.';
+        std::string::size_type start = ret.size();
+        for (int n = weight + 1; ret.size() - start < dscale; ++n)
+            appendDigits(ret, n >= 0 && n < ndigits ? getUint16(digits + 2 * n) : 0, 4);
+        ret.resize(start + dscale);
+    }
+
+    return ret;
+}
+
+Date decodeDate(const char* data, int len)
+{
+    checkLength(len, 4, "date");
+    int32_t days = static_cast<int32_t>(getUint32(data));
+    if (days == std::numeric_limits<int32_t>::max() || days == std::numeric_limits<int32_t>::min())
+        throw TypeError("can't convert infinite date to Date");
+    return civilFromDays(days + pgEpochDays);
+}
+
+Time decodeTime(const char* data, int len)
+{
+    checkLength(len, 8, "time");
+    return timeFromUsecs(static_cast<int64_t>(getUint64(data)));
+}
+
+Datetime decodeTimestamp(const char* data, int len)
+{
+    checkLength(len, 8, "timestamp");
+    int64_t usecs = static_cast<int64_t>(getUint64(data));
+    if (usecs == std::numeric_limits<int64_t>::max() || usecs == std::numeric_limits<int64_t>::min())
+        throw TypeError("can't convert infinite timestamp to Datetime");
+
+    // round first, so that a carry propagates into the date
+    int64_t millis = floorDiv(usecs + 500, 1000);
+    int64_t days = floorDiv(millis, 86400000);
+    return Datetime(civilFromDays(days + pgEpochDays),
+                    timeFromUsecs((millis - days * 86400000) * 1000));
+}
+
+std::string decodeString(Oid type, const char* data, int len)
+{
+    switch (type)
+    {
+        case BOOLOID:
+            return decodeBool(data, len) ? "t" : "f";
+
+        case INT2OID:
+        case INT4OID:
+        case INT8OID:
+        case OIDOID:
+            return cxxtools::convert<std::string>(decodeInteger(type, data, len));
+
+        case FLOAT4OID:
+            return floatToString(static_cast<float>(decodeFloat(type, data, len)));
+
+        case FLOAT8OID:
+            return floatToString(decodeFloat(type, data, len));
+
+        case NUMERICOID:
+            return decodeNumeric(data, len);
+
+        case DATEOID:
+        {
+            checkLength(len, 4, "date");
+            int32_t days = static_cast<int32_t>(getUint32(data));
+            if (days == std::numeric_limits<int32_t>::max())
+                return "infinity";
+            else if (days == std::numeric_limits<int32_t>::min())
+                return "-infinity";
+            return civilFromDays(days + pgEpochDays).getIso();
+        }
+
+        case TIMEOID:
+        {
+            checkLength(len, 8, "time");
+            std::string ret;
+            appendTime(ret, static_cast<int64_t>(getUint64(data)));
+            return ret;
+        }
+
+        case TIMESTAMPOID:
+        case TIMESTAMPTZOID:
+        {
+            checkLength(len, 8, "timestamp");
+            int64_t usecs = static_cast<int64_t>(getUint64(data));
+            if (usecs == std::numeric_limits<int64_t>::max())
+                return "infinity";
+            else if (usecs == std::numeric_limits<int64_t>::min())
+                return "-infinity";
+
+            // timestamp with time zone is always received in UTC
+            int64_t days = floorDiv(usecs, usecsPerDay);
+            std::string ret = civilFromDays(days + pgEpochDays).getIso();
+            ret += ' ';
+            appendTime(ret, usecs - days * usecsPerDay);
+            if (type == TIMESTAMPTZOID)
+                ret += "+00";
+            return ret;
+        }
+
+        case UUIDOID:
+        {
+            checkLength(len, 16, "uuid");
+            static const char hex[] = "0123456789abcdef";
+            std::string ret;
+            for (int n = 0; n < 16; ++n)
+            {
+                if (n == 4 || n == 6 || n == 8 || n == 10)
+                    ret += '-';
+                unsigned char ch = static_cast<unsigned char>(data[n]);
+                ret += hex[ch >> 4];
+                ret += hex[ch & 0xf];
+            }
+            return ret;
+        }
+
+        case JSONBOID:
+            // jsonb starts with a version number
+            if (len < 1 || data[0] != 1)
+                throw TypeError("unsupported binary jsonb version");
+            return std::string(data + 1, len - 1);
+
+        case BYTEAOID:
+            return std::string(data, len);
+    }
+
+    if (isTextType(type))
+        return std::string(data, len);
+
+    std::ostringstream msg;
+    msg << "binary format of type oid " << type << " is not supported";
+    throw TypeError(msg.str());
+}
+
+}
+}
@@ -0,0 +1,742 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/postgresql/impl/bulkloader.h>
+#include <tntdb/postgresql/impl/connection.h>
+#include <tntdb/postgresql/impl/binaryformat.h>
+#include <tntdb/postgresql/error.h>
+#include <tntdb/bits/result.h>
+#include <tntdb/bits/row.h>
+#include <tntdb/bits/value.h>
+#include <tntdb/blob.h>
+#include <tntdb/error.h>
+#include <cxxtools/log.h>
+#include <limits>
+#include <sstream>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+log_define("tntdb.postgresql.bulkloader")
+
+namespace tntdb
+{
+namespace postgresql
+{
+namespace
+{
+    // COPY data is sent to the server, when the buffer reaches this size
+    const std::string::size_type copyBlockSize = 65536;
+
+    // pg_attribute stores unquoted identifiers in lower case
+    std::string attributeName(const std::string& col)
+    {
+        if (col.size() >= 2 && col[0] == '"' && col[col.size() - 1] == '"')
+            return col.substr(1, col.size() - 2);
+
+        std::string ret(col);
+        for (std::string::iterator it = ret.begin(); it != ret.end(); ++it)
+            *it = std::tolower(static_cast<unsigned char>(*it));
+        return ret;
+    }
+
+    void appendEscaped(std::string& buffer, const std::string& data)
+    {
+        for (std::string::const_iterator it = data.begin(); it != data.end(); ++it)
+        {
+            switch (*it)
+            {
+                case '\\': buffer += "\\\\"; break;
+                case '\t': buffer += "\\t"; break;
+                case '\n': buffer += "\\n"; break;
+                case '\r': buffer += "\\r"; break;
+                default: buffer += *it;
+            }
+        }
+    }
+
+    std::string byteaText(const std::string& data)
+    {
+        static const char hex[] = "0123456789abcdef";
+        std::string ret;
+        ret.reserve(data.size() * 2 + 2);
+        ret += "\\x";
+        for (std::string::const_iterator it = data.begin(); it != data.end(); ++it)
+        {
+            unsigned char ch = static_cast<unsigned char>(*it);
+            ret += hex[ch >> 4];
+            ret += hex[ch & 0xf];
+        }
+        return ret;
+    }
+
+    bool isIntegerType(Oid type)
+    {
+        return type == INT2OID || type == INT4OID || type == INT8OID;
+    }
+
+    bool isNumberType(Oid type)
+    {
+        return isIntegerType(type)
+            || type == FLOAT4OID
+            || type == FLOAT8OID
+            || type == NUMERICOID;
+    }
+}
+
+BulkLoader::BulkLoader(Connection* conn, const std::string& table, const std::vector<std::string>& columns, bool binary)
+  : _conn(conn),
+    _table(table),
+    _columns(columns),
+    _fields(columns.size()),
+    _binary(binary),
+    _copyActive(false),
+    _rows(0),
+    _maxRows(0)
+{
+    _copySql = "COPY " + table + " (";
+    for (unsigned n = 0; n < columns.size(); ++n)
+    {
+        if (n > 0)
+            _copySql += ", ";
+        _copySql += columns[n];
+    }
+    _copySql += ") FROM STDIN";
+    if (_binary)
+    {
+        _copySql += " (FORMAT binary)";
+        readTypes();
+    }
+
+    log_debug("bulk loader for \"" << _copySql << '"');
+}
+
+BulkLoader::~BulkLoader()
+{
+    if (_copyActive)
+    {
+        try
+        {
+            flush();
+        }
+        catch (const std::exception& e)
+        {
+            log_error("failed to finish COPY: " << e.what());
+        }
+    }
+}
+
+unsigned BulkLoader::columnIndex(const std::string& col) const
+{
+    for (unsigned n = 0; n < _columns.size(); ++n)
+        if (_columns[n] == col)
+            return n;
+
+    throw HostvarNotFound(col);
+}
+
+void BulkLoader::readTypes()
+{
+    static const char sql[] =
+        "select attname, atttypid from pg_attribute"
+        " where attrelid = $1::regclass and attnum > 0 and not attisdropped";
+
+    const char* paramValues[1] = { _table.c_str() };
+
+    log_debug("PQexecParams(" << getPGConn() << ", \"" << sql << "\", 1)");
+    PGresult* result = PQexecParams(getPGConn(), sql, 1, 0, paramValues, 0, 0, 0);
+    if (isError(result))
+    {
+        log_error(PQresultErrorMessage(result));
+        throw PgSqlError(sql, "PQexecParams", result, true);
+    }
+
+    _types.assign(_columns.size(), InvalidOid);
+    for (int row = 0; row < PQntuples(result); ++row)
+    {
+        std::string attname = PQgetvalue(result, row, 0);
+        for (unsigned n = 0; n < _columns.size(); ++n)
+            if (attributeName(_columns[n]) == attname)
+                _types[n] = static_cast<Oid>(std::strtoul(PQgetvalue(result, row, 1), 0, 10));
+    }
+
+    PQclear(result);
+
+    for (unsigned n = 0; n < _columns.size(); ++n)
+        if (_types[n] == InvalidOid)
+            throw Error("column \"" + _columns[n] + "\" not found in table \"" + _table + '"');
+}
+
+PGconn* BulkLoader::getPGConn()
+{
+    return _conn->getPGConn();
+}
+
+void BulkLoader::setValue(unsigned idx, const std::string& data)
+{
+    _fields[idx].isNull = false;
+    _fields[idx].value = data;
+}
+
+void BulkLoader::setText(unsigned idx, const std::string& data)
+{
+    if (!_binary)
+    {
+        setValue(idx, data);
+        return;
+    }
+
+    Oid type = _types[idx];
+    if (isTextType(type) || type == BYTEAOID)
+        setValue(idx, data);
+    else if (isNumberType(type))
+        setNumeric(idx, Decimal(data));
+    else if (type == BOOLOID)
+        setValue(idx, encodeBinary(!data.empty() && std::strchr("tTyY1", data[0]) != 0));
+    else if (type == DATEOID)
+        setValue(idx, encodeBinary(Date::fromIso(data)));
+    else if (type == TIMEOID)
+        setValue(idx, encodeBinary(Time::fromIso(data)));
+    else if (type == TIMESTAMPOID || type == TIMESTAMPTZOID)
+        setValue(idx, encodeBinary(Datetime::fromIso(data)));
+    else
+        typeError(idx, "a string");
+}
+
+void BulkLoader::setInteger(unsigned idx, int64_t data)
+{
+    if (!_binary)
+    {
+        setValue(idx, encodeText(data));
+        return;
+    }
+
+    switch (_types[idx])
+    {
+        case INT2OID:
+            if (data < std::numeric_limits<int16_t>::min() || data > std::numeric_limits<int16_t>::max())
+                typeError(idx, "an integer out of range");
+            setValue(idx, encodeBinary(static_cast<int16_t>(data)));
+            break;
+
+        case INT4OID:
+            if (data < std::numeric_limits<int32_t>::min() || data > std::numeric_limits<int32_t>::max())
+                typeError(idx, "an integer out of range");
+            setValue(idx, encodeBinary(static_cast<int32_t>(data)));
+            break;
+
+        case INT8OID:      setValue(idx, encodeBinary(data)); break;
+        case FLOAT4OID:    setValue(idx, encodeBinary(static_cast<float>(data))); break;
+        case FLOAT8OID:    setValue(idx, encodeBinary(static_cast<double>(data))); break;
+        case NUMERICOID:   setValue(idx, encodeBinary(Decimal(static_cast<long long>(data)))); break;
+        case BOOLOID:      setValue(idx, encodeBinary(data != 0)); break;
+
+        default:
+            if (isTextType(_types[idx]))
+                setValue(idx, encodeText(data));
+            else
+                typeError(idx, "an integer");
+    }
+}
+
+void BulkLoader::setFloating(unsigned idx, double data, bool isFloat)
+{
+    if (!_binary || isTextType(_types[idx]))
+    {
+        setValue(idx, isFloat ? encodeText(static_cast<float>(data)) : encodeText(data));
+        return;
+    }
+
+    switch (_types[idx])
+    {
+        case FLOAT4OID:    setValue(idx, encodeBinary(static_cast<float>(data))); break;
+        case FLOAT8OID:    setValue(idx, encodeBinary(data)); break;
+        case NUMERICOID:   setValue(idx, encodeBinary(Decimal(data))); break;
+
+        default:
+            typeError(idx, "a floating point number");
+    }
+}
+
+void BulkLoader::setNumeric(unsigned idx, const Decimal& data)
+{
+    if (!_binary || isTextType(_types[idx]))
+    {
+        setValue(idx, encodeText(data));
+        return;
+    }
+
+    Oid type = _types[idx];
+    if (type == NUMERICOID)
+        setValue(idx, encodeBinary(data));
+    else if (isIntegerType(type))
+        setInteger(idx, data.getInteger<int64_t>());
+    else if (type == FLOAT4OID || type == FLOAT8OID)
+        setFloating(idx, static_cast<double>(data.getDouble()), type == FLOAT4OID);
+    else
+        typeError(idx, "a decimal");
+}
+
+void BulkLoader::setBytes(unsigned idx, const std::string& data)
+{
+    if (!_binary)
+        setValue(idx, byteaText(data));
+    else if (_types[idx] == BYTEAOID || isTextType(_types[idx]))
+        setValue(idx, data);
+    else
+        typeError(idx, "a blob");
+}
+
+void BulkLoader::typeError(unsigned idx, const char* what) const
+{
+    std::ostringstream msg;
+    msg << "can't copy " << what << " into column \"" << _columns[idx]
+        << "\" of type oid " << _types[idx];
+    throw TypeError(msg.str());
+}
+
+void BulkLoader::beginCopy()
+{
+    if (_conn->inPipeline())
+        throw Error("COPY is not possible in pipeline mode");
+
+    log_debug("PQexec(" << getPGConn() << ", \"" << _copySql << "\")");
+    PGresult* result = PQexec(getPGConn(), _copySql.c_str());
+    if (PQresultStatus(result) != PGRES_COPY_IN)
+    {
+        log_error(PQresultErrorMessage(result));
+        throw PgSqlError(_copySql, "PQexec", result, true);
+    }
+
+    PQclear(result);
+
+    _copyActive = true;
+    _rows = 0;
+    _buffer.clear();
+
+    if (_binary)
+    {
+        // signature, flags and length of the header extension
+        _buffer.append("PGCOPY\n\377\r\n\0", 11);
+        _buffer += encodeBinary(static_cast<int32_t>(0));
+        _buffer += encodeBinary(static_cast<int32_t>(0));
+    }
+}
+
+void BulkLoader::putData(bool force)
+{
+    if (_buffer.empty() || (!force && _buffer.size() < copyBlockSize))
+        return;
+
+    log_debug("PQputCopyData(" << getPGConn() << ", " << _buffer.size() << " bytes)");
+    if (PQputCopyData(getPGConn(), _buffer.data(), static_cast<int>(_buffer.size())) != 1)
+        throw PgConnError("PQputCopyData", getPGConn());
+
+    _buffer.clear();
+}
+
+void BulkLoader::appendRow()
+{
+    if (_binary)
+    {
+        _buffer += encodeBinary(static_cast<int16_t>(_fields.size()));
+        for (std::vector<Field>::const_iterator it = _fields.begin(); it != _fields.end(); ++it)
+        {
+            if (it->isNull)
+                _buffer += encodeBinary(static_cast<int32_t>(-1));
+            else
+            {
+                _buffer += encodeBinary(static_cast<int32_t>(it->value.size()));
+                _buffer += it->value;
+            }
+        }
+    }
+    else
+    {
+        for (std::vector<Field>::const_iterator it = _fields.begin(); it != _fields.end(); ++it)
+        {
+            if (it != _fields.begin())
+                _buffer += '\t';
+            if (it->isNull)
+                _buffer += "\\N";
+            else
+                appendEscaped(_buffer, it->value);
+        }
+        _buffer += '\n';
+    }
+}
+
+void BulkLoader::clear()
+{
+    for (std::vector<Field>::iterator it = _fields.begin(); it != _fields.end(); ++it)
+    {
+        it->isNull = true;
+        it->value.clear();
+    }
+}
+
+void BulkLoader::setNull(const std::string& col)
+{
+    setNullAt(columnIndex(col));
+}
+
+void BulkLoader::setBool(const std::string& col, bool data)
+{
+    setBoolAt(columnIndex(col), data);
+}
+
+void BulkLoader::setShort(const std::string& col, short data)
+{
+    setShortAt(columnIndex(col), data);
+}
+
+void BulkLoader::setInt(const std::string& col, int data)
+{
+    setIntAt(columnIndex(col), data);
+}
+
+void BulkLoader::setLong(const std::string& col, long data)
+{
+    setLongAt(columnIndex(col), data);
+}
+
+void BulkLoader::setUnsignedShort(const std::string& col, unsigned short data)
+{
+    setUnsignedShortAt(columnIndex(col), data);
+}
+
+void BulkLoader::setUnsigned(const std::string& col, unsigned data)
+{
+    setUnsignedAt(columnIndex(col), data);
+}
+
+void BulkLoader::setUnsignedLong(const std::string& col, unsigned long data)
+{
+    setUnsignedLongAt(columnIndex(col), data);
+}
+
+void BulkLoader::setInt32(const std::string& col, int32_t data)
+{
+    setInt32At(columnIndex(col), data);
+}
+
+void BulkLoader::setUnsigned32(const std::string& col, uint32_t data)
+{
+    setUnsigned32At(columnIndex(col), data);
+}
+
+void BulkLoader::setInt64(const std::string& col, int64_t data)
+{
+    setInt64At(columnIndex(col), data);
+}
+
+void BulkLoader::setUnsigned64(const std::string& col, uint64_t data)
+{
+    setUnsigned64At(columnIndex(col), data);
+}
+
+void BulkLoader::setDecimal(const std::string& col, const Decimal& data)
+{
+    setDecimalAt(columnIndex(col), data);
+}
+
+void BulkLoader::setFloat(const std::string& col, float data)
+{
+    setFloatAt(columnIndex(col), data);
+}
+
+void BulkLoader::setDouble(const std::string& col, double data)
+{
+    setDoubleAt(columnIndex(col), data);
+}
+
+void BulkLoader::setChar(const std::string& col, char data)
+{
+    setCharAt(columnIndex(col), data);
+}
+
+void BulkLoader::setString(const std::string& col, const std::string& data)
+{
+    setStringAt(columnIndex(col), data);
+}
+
+void BulkLoader::setBlob(const std::string& col, const Blob& data)
+{
+    setBlobAt(columnIndex(col), data);
+}
+
+void BulkLoader::setDate(const std::string& col, const Date& data)
+{
+    setDateAt(columnIndex(col), data);
+}
+
+void BulkLoader::setTime(const std::string& col, const Time& data)
+{
+    setTimeAt(columnIndex(col), data);
+}
+
+void BulkLoader::setDatetime(const std::string& col, const Datetime& data)
+{
+    setDatetimeAt(columnIndex(col), data);
+}
+
+BulkLoader::size_type BulkLoader::paramIndex(const std::string& col)
+{
+    return columnIndex(col);
+}
+
+void BulkLoader::setNullAt(size_type idx)
+{
+    _fields[idx].isNull = true;
+}
+
+void BulkLoader::setBoolAt(size_type idx, bool data)
+{
+    if (!_binary || isTextType(_types[idx]))
+        setValue(idx, encodeText(data));
+    else if (_types[idx] == BOOLOID)
+        setValue(idx, encodeBinary(data));
+    else
+        setInteger(idx, data ? 1 : 0);
+}
+
+void BulkLoader::setShortAt(size_type idx, short data)
+{
+    setInteger(idx, data);
+}
+
+void BulkLoader::setIntAt(size_type idx, int data)
+{
+    setInteger(idx, data);
+}
+
+void BulkLoader::setLongAt(size_type idx, long data)
+{
+    setInteger(idx, data);
+}
+
+void BulkLoader::setUnsignedShortAt(size_type idx, unsigned short data)
+{
+    setInteger(idx, data);
+}
+
+void BulkLoader::setUnsignedAt(size_type idx, unsigned data)
+{
+    setInteger(idx, data);
+}
+
+void BulkLoader::setUnsignedLongAt(size_type idx, unsigned long data)
+{
+    setUnsigned64At(idx, data);
+}
+
+void BulkLoader::setInt32At(size_type idx, int32_t data)
+{
+    setInteger(idx, data);
+}
+
+void BulkLoader::setUnsigned32At(size_type idx, uint32_t data)
+{
+    setInteger(idx, data);
+}
+
+void BulkLoader::setInt64At(size_type idx, int64_t data)
+{
+    setInteger(idx, data);
+}
+
+void BulkLoader::setUnsigned64At(size_type idx, uint64_t data)
+{
+    if (data > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+        setNumeric(idx, Decimal(static_cast<unsigned long long>(data)));
+    else
+        setInteger(idx, static_cast<int64_t>(data));
+}
+
+void BulkLoader::setDecimalAt(size_type idx, const Decimal& data)
+{
+    setNumeric(idx, data);
+}
+
+void BulkLoader::setFloatAt(size_type idx, float data)
+{
+    setFloating(idx, data, true);
+}
+
+void BulkLoader::setDoubleAt(size_type idx, double data)
+{
+    setFloating(idx, data, false);
+}
+
+void BulkLoader::setCharAt(size_type idx, char data)
+{
+    setText(idx, std::string(1, data));
+}
+
+void BulkLoader::setStringAt(size_type idx, const std::string& data)
+{
+    setText(idx, data);
+}
+
+void BulkLoader::setBlobAt(size_type idx, const Blob& data)
+{
+    setBytes(idx, std::string(data.data(), data.size()));
+}
+
+void BulkLoader::setDateAt(size_type idx, const Date& data)
+{
+    if (!_binary || isTextType(_types[idx]))
+        setValue(idx, encodeText(data));
+    else if (_types[idx] == DATEOID)
+        setValue(idx, encodeBinary(data));
+    else if (_types[idx] == TIMESTAMPOID || _types[idx] == TIMESTAMPTZOID)
+        setValue(idx, encodeBinary(Datetime(data, Time(0, 0, 0))));
+    else
+        typeError(idx, "a date");
+}
+
+void BulkLoader::setTimeAt(size_type idx, const Time& data)
+{
+    if (!_binary || isTextType(_types[idx]))
+        setValue(idx, encodeText(data));
+    else if (_types[idx] == TIMEOID)
+        setValue(idx, encodeBinary(data));
+    else
+        typeError(idx, "a time");
+}
+
+void BulkLoader::setDatetimeAt(size_type idx, const Datetime& data)
+{
+    if (!_binary || isTextType(_types[idx]))
+        setValue(idx, encodeText(data));
+    else if (_types[idx] == TIMESTAMPOID || _types[idx] == TIMESTAMPTZOID)
+        setValue(idx, encodeBinary(data));
+    else if (_types[idx] == DATEOID)
+        setValue(idx, encodeBinary(data.getDate()));
+    else
+        typeError(idx, "a datetime");
+}
+
+BulkLoader::size_type BulkLoader::execute()
+{
+    if (!_copyActive)
+        beginCopy();
+
+    appendRow();
+    ++_rows;
+    putData(false);
+
+    if (_maxRows > 0 && _rows >= _maxRows)
+        flush();
+
+    return 0;
+}
+
+tntdb::Result BulkLoader::select()
+{
+    throw Error("select is not possible with a bulk loader");
+}
+
+tntdb::Row BulkLoader::selectRow()
+{
+    throw Error("select is not possible with a bulk loader");
+}
+
+tntdb::Value BulkLoader::selectValue()
+{
+    throw Error("select is not possible with a bulk loader");
+}
+
+std::shared_ptr<ICursor> BulkLoader::createCursor(unsigned /* fetchsize */)
+{
+    throw Error("cursors are not possible with a bulk loader");
+}
+
+void BulkLoader::maxNumDelay(size_type n)
+{
+    _maxRows = n;
+    if (_maxRows > 0 && _rows >= _maxRows)
+        flush();
+}
+
+BulkLoader::size_type BulkLoader::numDelayed() const
+{
+    return _rows;
+}
+
+BulkLoader::size_type BulkLoader::flush()
+{
+    if (!_copyActive)
+        return 0;
+
+    PGconn* conn = getPGConn();
+    _copyActive = false;
+    _rows = 0;
+
+    const char* errormsg = 0;
+    try
+    {
+        if (_binary)
+            _buffer += encodeBinary(static_cast<int16_t>(-1));
+        putData(true);
+    }
+    catch (const std::exception&)
+    {
+        errormsg = "failed to send COPY data";
+    }
+
+    _buffer.clear();
+
+    log_debug("PQputCopyEnd(" << conn << ')');
+    if (PQputCopyEnd(conn, errormsg) != 1)
+        throw PgConnError("PQputCopyEnd", conn);
+
+    size_type count = 0;
+    PGresult* result;
+    while ((result = PQgetResult(conn)) != 0)
+    {
+        if (isError(result))
+        {
+            log_error(PQresultErrorMessage(result));
+            while (PGresult* r = PQgetResult(conn))
+                PQclear(r);
+            throw PgSqlError(_copySql, "PQputCopyEnd", result, true);
+        }
+
+        const char* t = PQcmdTuples(result);
+        if (t[0] != '\0')
+            count = static_cast<size_type>(std::strtoul(t, 0, 10));
+        PQclear(result);
+    }
+
+    log_debug(count << " rows copied into " << _table);
+    return count;
+}
+
+}
+}
@@ -31,13 +31,20 @@
 #include <tntdb/postgresql/impl/resultrow.h>
 #include <tntdb/postgresql/impl/resultvalue.h>
 #include <tntdb/postgresql/impl/statement.h>
+#include <tntdb/postgresql/impl/bulkloader.h>
+#include <tntdb/postgresql/impl/binaryformat.h>
 #include <tntdb/postgresql/error.h>
 #include <tntdb/result.h>
 #include <tntdb/statement.h>
+#include <tntdb/impl/columnarresult.h>
 #include <cxxtools/convert.h>
 #include <cxxtools/log.h>
+#include <cctype>
 #include <new>
+#include <ostream>
+#include <algorithm>
 #include <poll.h>
+#include "config.h"
 
 log_define("tntdb.postgresql.connection")
 
@@ -45,26 +52,229 @@ namespace tntdb
 {
 namespace postgresql
 {
+namespace
+{
+    // Sets the option, when the keyword is one of the options of tntdb.
+    bool parseOption(const std::string& keyword, const std::string& value, bool& binary, unsigned& prepareThreshold)
+    {
+        if (keyword == "binary")
+            binary = value == "1" || value == "on" || value == "true" || value == "yes";
+        else if (keyword == "prepare_threshold")
+            prepareThreshold = cxxtools::convert<unsigned>(value);
+        else
+            return false;
+        return true;
+    }
+
+    std::string percentDecode(const std::string& s)
+    {
+        std::string ret;
+        for (std::string::size_type pos = 0; pos < s.size(); ++pos)
+        {
+            if (s[pos] == '%' && pos + 2 < s.size()
+                && std::isxdigit(static_cast<unsigned char>(s[pos + 1]))
+                && std::isxdigit(static_cast<unsigned char>(s[pos + 2])))
+            {
+                ret += static_cast<char>(std::stoi(s.substr(pos + 1, 2), 0, 16));
+                pos += 2;
+            }
+            else
+                ret += s[pos];
+        }
+        return ret;
+    }
+
+    // Removes the options of tntdb from the query string of a connection
+    // uri, since libpq rejects unknown uri parameters.
+    std::string extractUriOptions(const std::string& uri, bool& binary, unsigned& prepareThreshold)
+    {
+        std::string::size_type q = uri.find('?');
+        if (q == std::string::npos)
+            return uri;
+
+        std::string ret(uri, 0, q);
+        char sep = '?';
+        std::string::size_type pos = q + 1;
+        while (pos <= uri.size())
+        {
+            std::string::size_type end = uri.find('&', pos);
+            if (end == std::string::npos)
+                end = uri.size();
+
+            std::string param(uri, pos, end - pos);
+            std::string::size_type eq = param.find('=');
+            std::string keyword = percentDecode(param.substr(0, eq));
+            std::string value = eq == std::string::npos ? std::string() : percentDecode(param.substr(eq + 1));
+
+            if (!param.empty() && !parseOption(keyword, value, binary, prepareThreshold))
+            {
+                ret += sep;
+                ret += param;
+                sep = '&';
+            }
+
+            pos = end + 1;
+        }
+
+        return ret;
+    }
+
+    // Removes the options "binary" and "prepare_threshold" from a conninfo
+    // string of libpq, which does not know them. The values are parsed like
+    // libpq does, so that a quoted value containing "binary=" is kept.
+    std::string extractOptions(const std::string& conninfo, bool& binary, unsigned& prepareThreshold)
+    {
+        if (conninfo.compare(0, 13, "postgresql://") == 0
+            || conninfo.compare(0, 11, "postgres://") == 0)
+            return extractUriOptions(conninfo, binary, prepareThreshold);
+
+        std::string ret;
+        std::string::size_type pos = 0;
+        while (pos < conninfo.size())
+        {
+            std::string::size_type begin = pos;
+
+            while (pos < conninfo.size() && std::isspace(conninfo[pos]))
+                ++pos;
+
+            std::string::size_type keywordBegin = pos;
+            while (pos < conninfo.size() && conninfo[pos] != '=' && !std::isspace(conninfo[pos]))
+                ++pos;
+            std::string keyword(conninfo, keywordBegin, pos - keywordBegin);
+
+            while (pos < conninfo.size() && std::isspace(conninfo[pos]))
+                ++pos;
+            if (pos < conninfo.size() && conninfo[pos] == '=')
+                ++pos;
+            while (pos < conninfo.size() && std::isspace(conninfo[pos]))
+                ++pos;
+
+            std::string value;
+            bool quoted = pos < conninfo.size() && conninfo[pos] == '\'';
+            if (quoted)
+                ++pos;
+            while (pos < conninfo.size()
+                && (quoted ? conninfo[pos] != '\'' : !std::isspace(conninfo[pos])))
+            {
+                if (conninfo[pos] == '\\' && pos + 1 < conninfo.size())
+                    ++pos;
+                value += conninfo[pos++];
+            }
+            if (quoted && pos < conninfo.size())
+                ++pos;
+
+            if (!parseOption(keyword, value, binary, prepareThreshold))
+                ret.append(conninfo, begin, pos - begin);
+        }
+
+        return ret;
+    }
+
+    Connection::size_type cmdTuples(PGresult* result)
+    {
+        std::string t = PQcmdTuples(result);
+        return t.empty() ? 0 : cxxtools::convert<Connection::size_type>(t);
+    }
+
+    // Decodes a field of the text format of COPY.
+    void unescapeCopyField(const char* begin, const char* end, std::string& ret)
+    {
+        ret.clear();
+        for (const char* p = begin; p < end; ++p)
+        {
+            if (*p != '\\' || p + 1 == end)
+            {
+                ret += *p;
+                continue;
+            }
+
+            char ch = *++p;
+            switch (ch)
+            {
+                case 'b': ret += '\b'; break;
+                case 'f': ret += '\f'; break;
+                case 'n': ret += '\n'; break;
+                case 'r': ret += '\r'; break;
+                case 't': ret += '\t'; break;
+                case 'v': ret += '\v'; break;
+
+                case 'x':
+                {
+                    // up to 2 hex digits
+                    unsigned v = 0;
+                    unsigned n = 0;
+                    for (; n < 2 && p + 1 < end && std::isxdigit(static_cast<unsigned char>(p[1])); ++n)
+                    {
+                        char d = *++p;
+                        v = v * 16 + (std::isdigit(static_cast<unsigned char>(d)) ? d - '0' : std::tolower(d) - 'a' + 10);
+                    }
+                    ret += n > 0 ? static_cast<char>(v) : 'x';
+                    break;
+                }
+
+                default:
+                    if (ch >= '0' && ch <= '7')
+                    {
+                        // up to 3 octal digits
+                        unsigned v = ch - '0';
+                        for (unsigned n = 1; n < 3 && p + 1 < end && p[1] >= '0' && p[1] <= '7'; ++n)
+                            v = v * 8 + (*++p - '0');
+                        ret += static_cast<char>(v);
+                    }
+                    else
+                        ret += ch;
+            }
+        }
+    }
+
+    // Rows decoded by copyOutRows are collected in results of this size,
+    // which are released, when the rows are no longer referenced.
+    const unsigned copyBatchSize = 1000;
+
+    // The results of queued queries are read at sync points. Without
+    // limit the server would block on a full socket buffer while the
+    // client still sends.
+    const unsigned maxPipeline = 1000;
+}
+
 Connection::Connection(const std::string& url_, const std::string& username, const std::string& password)
   : transactionActive(0),
-    stmtCounter(0)
+    stmtCounter(0),
+    binaryFormat(false),
+    prepareThreshold(2),
+    pipelineMode(false),
+    pipelineCount(0)
 {
     log_debug("PQconnectdb(\"" << url_ << "\")");
 
-    conn = PQconnectdb(url(url_, username, password).c_str());
+    std::string conninfo = extractOptions(url(url_, username, password), binaryFormat, prepareThreshold);
+    conn = PQconnectdb(conninfo.c_str());
     if (conn == 0)
         throw std::bad_alloc();
 
     if (PQstatus(conn) == CONNECTION_BAD )
         throw PgConnError("PQconnectdb", conn);
 
-    log_debug("connected to postgresql backend process " << PQbackendPID(conn));
+    log_debug("connected to postgresql backend process " << PQbackendPID(conn)
+        << (binaryFormat ? " using binary format" : ""));
 }
 
 Connection::~Connection()
 {
     if (conn)
     {
+        if (pipelineMode)
+        {
+            try
+            {
+                endPipeline();
+            }
+            catch (const std::exception& e)
+            {
+                log_error("failed to end pipeline: " << e.what());
+            }
+        }
+
         currvalStmt = tntdb::Statement();
         lastvalStmt = tntdb::Statement();
 
@@ -102,6 +312,12 @@ Connection::size_type Connection::execute(const std::string& query)
 {
     log_debug("execute(\"" << query << "\")");
 
+    if (pipelineMode)
+    {
+        sendQuery(query, 0, 0, 0, 0, 0, 0);
+        return 0;
+    }
+
     log_debug("PQexec(" << conn << ", \"" << query << "\")");
     PGresult* result = PQexec(conn, query.c_str());
     log_debug("PGresult=" << static_cast<void*>(result));
@@ -111,9 +327,7 @@ Connection::size_type Connection::execute(const std::string& query)
         throw PgSqlError(query, "PQexec", result, true);
     }
 
-    std::string t = PQcmdTuples(result);
-    Connection::size_type ret = t.empty() ? 0
-                                          : cxxtools::convert<Connection::size_type>(t);
+    Connection::size_type ret = cmdTuples(result);
 
     log_debug("PQclear(" << result << ')');
     PQclear(result);
@@ -123,6 +337,14 @@ Connection::size_type Connection::execute(const std::string& query)
 
 std::shared_ptr<Result> Connection::pgselect(const std::string& query)
 {
+    if (pipelineMode)
+    {
+        PGresult* result;
+        sendQuery(query, 0, 0, 0, 0, 0, 0);
+        processPipeline(&result);
+        return std::make_shared<Result>(result);
+    }
+
     log_debug("PQexec(" << conn << ", \"" << query << "\")");
     PGresult* result = PQexec(conn, query.c_str());
     log_debug("PGresult=" << static_cast<void*>(result));
@@ -185,10 +407,191 @@ tntdb::Statement Connection::prepareWithLimit(const std::string& query, const st
     return prepare(q);
 }
 
+tntdb::Statement Connection::prepareBulkLoad(const std::string& table, const std::vector<std::string>& columns)
+{
+    log_debug("prepareBulkLoad(\"" << table << "\")");
+    return tntdb::Statement(std::make_shared<BulkLoader>(this, table, columns, binaryFormat));
+}
+
+Connection::size_type Connection::copyData(const std::string& query, const std::function<void (const char*, int)>& onRow)
+{
+    if (pipelineMode)
+        throw Error("COPY is not possible in pipeline mode");
+
+    std::string sql = "COPY (" + query + ") TO STDOUT";
+
+    log_debug("PQexec(" << conn << ", \"" << sql << "\")");
+    PGresult* result = PQexec(conn, sql.c_str());
+    if (PQresultStatus(result) != PGRES_COPY_OUT)
+    {
+        log_error(PQresultErrorMessage(result));
+        throw PgSqlError(sql, "PQexec", result, true);
+    }
+
+    PQclear(result);
+
+    // PQgetCopyData returns one row at a time
+    size_type count = 0;
+    char* buffer;
+    int len;
+    while ((len = PQgetCopyData(conn, &buffer, 0)) > 0)
+    {
+        try
+        {
+            onRow(buffer, len);
+        }
+        catch (...)
+        {
+            PQfreemem(buffer);
+            abortCopyOut();
+            throw;
+        }
+
+        PQfreemem(buffer);
+        ++count;
+    }
+
+    if (len == -2)
+        throw PgConnError("PQgetCopyData", conn);
+
+    while ((result = PQgetResult(conn)) != 0)
+    {
+        if (isError(result))
+        {
+            log_error(PQresultErrorMessage(result));
+            while (PGresult* r = PQgetResult(conn))
+                PQclear(r);
+            throw PgSqlError(sql, "PQgetCopyData", result, true);
+        }
+
+        PQclear(result);
+    }
+
+    log_debug(count << " rows copied");
+    return count;
+}
+
+void Connection::abortCopyOut()
+{
+    // cancel the query and discard the data sent until the server noticed
+    log_debug("abort COPY");
+    PGcancel* cancel = PQgetCancel(conn);
+    if (cancel)
+    {
+        char errbuf[256];
+        if (!PQcancel(cancel, errbuf, sizeof(errbuf)))
+            log_warn("PQcancel failed: " << errbuf);
+        PQfreeCancel(cancel);
+    }
+
+    char* buffer;
+    while (PQgetCopyData(conn, &buffer, 0) > 0)
+        PQfreemem(buffer);
+
+    while (PGresult* r = PQgetResult(conn))
+        PQclear(r);
+}
+
+Connection::size_type Connection::copyOut(const std::string& query, std::ostream& out)
+{
+    log_debug("copyOut(\"" << query << "\")");
+
+    return copyData(query, [&out] (const char* data, int len) {
+        out.write(data, len);
+    });
+}
+
+Connection::size_type Connection::copyOutRows(const std::string& query, const std::function<void (const Row&)>& callback)
+{
+    log_debug("copyOutRows(\"" << query << "\")");
+
+#ifdef HAVE_PQPREPARE
+    if (pipelineMode)
+        throw Error("COPY is not possible in pipeline mode");
+
+    // COPY does not send the column names and types, so they are read
+    // from the description of the unnamed statement
+    log_debug("PQprepare(" << conn << ", \"\", \"" << query << "\")");
+    PGresult* result = PQprepare(conn, "", query.c_str(), 0, 0);
+    if (isError(result))
+    {
+        log_error(PQresultErrorMessage(result));
+        throw PgSqlError(query, "PQprepare", result, true);
+    }
+
+    PQclear(result);
+
+    log_debug("PQdescribePrepared(" << conn << ", \"\")");
+    result = PQdescribePrepared(conn, "");
+    if (isError(result))
+    {
+        log_error(PQresultErrorMessage(result));
+        throw PgSqlError(query, "PQdescribePrepared", result, true);
+    }
+
+    std::shared_ptr<ResultSchema> schema = std::make_shared<ResultSchema>();
+    std::vector<Oid> types;
+    int nfields = PQnfields(result);
+    schema->reserve(nfields);
+    for (int n = 0; n < nfields; ++n)
+    {
+        schema->add(PQfname(result, n));
+        types.push_back(PQftype(result, n));
+    }
+
+    PQclear(result);
+
+    std::shared_ptr<ColumnarResult> batch;
+    std::string value;
+
+    return copyData(query, [&] (const char* data, int len) {
+        if (!batch || batch->size() >= copyBatchSize)
+            batch = std::make_shared<ColumnarResult>(schema);
+
+        const char* end = data + len;
+        if (end > data && end[-1] == '\n')
+            --end;
+
+        const char* p = data;
+        for (unsigned n = 0; n < types.size(); ++n)
+        {
+            const char* e = std::find(p, end, '\t');
+            if (e - p == 2 && p[0] == '\\' && p[1] == 'N')
+                batch->addNull(n);
+            else
+            {
+                unescapeCopyField(p, e, value);
+                if (types[n] == BYTEAOID)
+                {
+                    size_t to_len;
+                    unsigned char* bytes = PQunescapeBytea(reinterpret_cast<const unsigned char*>(value.c_str()), &to_len);
+                    if (bytes == 0)
+                        throw std::bad_alloc();
+                    batch->add(n, reinterpret_cast<const char*>(bytes), to_len);
+                    PQfreemem(bytes);
+                }
+                else
+                    batch->add(n, value.data(), value.size());
+            }
+
+            p = e < end ? e + 1 : end;
+        }
+
+        callback(Row(std::make_shared<ColumnarRow>(batch, batch->size() - 1)));
+    });
+#else
+    return IConnection::copyOutRows(query, callback);
+#endif
+}
+
 bool Connection::ping()
 {
     log_debug("ping()");
 
+    // a query would mix up the results of the pipeline
+    if (pipelineMode)
+        return PQstatus(conn) == CONNECTION_OK;
+
     if (PQsendQuery(conn, "select 1") == 0)
     {
         log_debug("failed to send statement \"select 1\" to database in Connection::ping()");
@@ -269,6 +672,10 @@ void Connection::deallocateStatement(const std::string& stmtName)
 
 void Connection::deallocateStatements()
 {
+    // statements are deallocated, when the pipeline is left
+    if (pipelineMode)
+        return;
+
     for (std::vector<std::string>::size_type n = 0; n < stmtsToDeallocate.size(); ++n)
     {
         std::string sql = "DEALLOCATE " + stmtsToDeallocate[n];
@@ -296,5 +703,249 @@ void Connection::lockTable(const std::string& tablename, bool exclusive)
     tntdb::Statement lockStmt = prepare(query);
     lockStmt.execute();
 }
+void Connection::checkPipeline()
+{
+    if (pipeline.size() >= maxPipeline)
+        processPipeline();
+}
+
+void Connection::sendQuery(const std::string& query, int nParams, const Oid* paramTypes,
+    const char* const* paramValues, const int* paramLengths, const int* paramFormats, int resultFormat)
+{
+    checkPipeline();
+
+    log_debug("PQsendQueryParams(" << conn << ", \"" << query << "\", " << nParams << ')');
+    if (!PQsendQueryParams(conn, query.c_str(), nParams, paramTypes, paramValues, paramLengths, paramFormats, resultFormat))
+        throw PgConnError("PQsendQueryParams", conn);
+
+    pipeline.push_back(query);
+}
+
+void Connection::sendPrepare(const std::string& stmtName, const std::string& query, int nParams, const Oid* paramTypes)
+{
+    checkPipeline();
+
+    log_debug("PQsendPrepare(" << conn << ", \"" << stmtName << "\", \"" << query << "\", " << nParams << ')');
+    if (!PQsendPrepare(conn, stmtName.c_str(), query.c_str(), nParams, paramTypes))
+        throw PgConnError("PQsendPrepare", conn);
+
+    pipeline.push_back(query);
+}
+
+void Connection::sendQueryPrepared(const std::string& stmtName, const std::string& query, int nParams,
+    const char* const* paramValues, const int* paramLengths, const int* paramFormats, int resultFormat)
+{
+    checkPipeline();
+
+    log_debug("PQsendQueryPrepared(" << conn << ", \"" << stmtName << "\", " << nParams << ')');
+    if (!PQsendQueryPrepared(conn, stmtName.c_str(), nParams, paramValues, paramLengths, paramFormats, resultFormat))
+        throw PgConnError("PQsendQueryPrepared", conn);
+
+    pipeline.push_back(query);
+}
+
+Connection::size_type Connection::syncPipeline()
+{
+    if (!pipelineMode)
+        return 0;
+
+    try
+    {
+        processPipeline();
+    }
+    catch (...)
+    {
+        pipelineCount = 0;
+        throw;
+    }
+
+    size_type ret = pipelineCount;
+    pipelineCount = 0;
+    return ret;
+}
+
+#ifdef HAVE_PQENTERPIPELINEMODE
+
+void Connection::beginPipeline()
+{
+    if (pipelineMode)
+        return;
+
+    log_debug("PQenterPipelineMode(" << conn << ')');
+    if (!PQenterPipelineMode(conn))
+        throw PgConnError("PQenterPipelineMode", conn);
+
+    pipelineMode = true;
+}
+
+void Connection::endPipeline()
+{
+    if (!pipelineMode)
+        return;
+
+    try
+    {
+        syncPipeline();
+    }
+    catch (...)
+    {
+        // the results are read or discarded by syncPipeline, so that the
+        // pipeline mode can be left
+        log_debug("PQexitPipelineMode(" << conn << ')');
+        if (!PQexitPipelineMode(conn))
+            log_error("PQexitPipelineMode failed: " << PQerrorMessage(conn));
+        pipelineMode = false;
+        throw;
+    }
+
+    log_debug("PQexitPipelineMode(" << conn << ')');
+    if (!PQexitPipelineMode(conn))
+        throw PgConnError("PQexitPipelineMode", conn);
+
+    pipelineMode = false;
+
+    if (transactionActive == 0)
+        deallocateStatements();
+}
+
+void Connection::discardPipeline()
+{
+    pipeline.clear();
+
+    // A sync point makes the server send the results of all queries sent so
+    // far. The results are read until the connection is idle, which is
+    // signaled by two null pointers in a row, or the connection is broken.
+    log_debug("PQpipelineSync(" << conn << ") to discard pending results");
+    if (!PQpipelineSync(conn))
+        log_warn("PQpipelineSync failed: " << PQerrorMessage(conn));
+
+    unsigned nulls = 0;
+    while (nulls < 2)
+    {
+        PGresult* result = PQgetResult(conn);
+        if (result == 0)
+            ++nulls;
+        else
+        {
+            nulls = 0;
+            PQclear(result);
+        }
+    }
+}
+
+void Connection::processPipeline(PGresult** last)
+{
+    if (last)
+        *last = 0;
+
+    std::vector<std::string> queries;
+    queries.swap(pipeline);
+
+    if (queries.empty())
+        return;
+
+    log_debug("PQpipelineSync(" << conn << ") after " << queries.size() << " queries");
+    if (!PQpipelineSync(conn))
+    {
+        PgConnError e("PQpipelineSync", conn);
+        discardPipeline();
+        throw e;
+    }
+
+    // Each query delivers one result followed by a null pointer. After an
+    // error the remaining queries up to the sync point are reported as
+    // aborted and the error of the failed query is thrown.
+    PGresult* error = 0;
+    std::string errorQuery;
+
+    for (unsigned n = 0; n < queries.size(); ++n)
+    {
+        PGresult* result = PQgetResult(conn);
+        if (result == 0)
+        {
+            PgConnError e("PQgetResult", conn);
+            if (error)
+                PQclear(error);
+            discardPipeline();
+            throw e;
+        }
+
+        ExecStatusType status = PQresultStatus(result);
+        if (status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK)
+        {
+            if (last && n + 1 == queries.size())
+                *last = result;
+            else
+            {
+                pipelineCount += cmdTuples(result);
+                PQclear(result);
+            }
+        }
+        else if (status == PGRES_PIPELINE_ABORTED || error)
+        {
+            log_debug("query \"" << queries[n] << "\" aborted");
+            PQclear(result);
+        }
+        else
+        {
+            log_error("query \"" << queries[n] << "\" failed: " << PQresultErrorMessage(result));
+            error = result;
+            errorQuery = queries[n];
+        }
+
+        while ((result = PQgetResult(conn)) != 0)
+            PQclear(result);
+    }
+
+    PGresult* sync = PQgetResult(conn);
+    if (sync)
+        PQclear(sync);
+
+    if (error)
+    {
+        // a failed transaction, which was already committed in the
+        // pipeline, is rolled back, so that the connection is usable again
+        if (transactionActive == 0 && PQtransactionStatus(conn) == PQTRANS_INERROR)
+        {
+            try
+            {
+                sendQuery("ROLLBACK", 0, 0, 0, 0, 0, 0);
+                processPipeline();
+            }
+            catch (const std::exception& e)
+            {
+                log_error("rollback failed: " << e.what());
+            }
+        }
+
+        throw PgSqlError(errorQuery, "PQgetResult", error, true);
+    }
+}
+
+#else
+
+void Connection::beginPipeline()
+{
+    log_debug("pipeline mode is not supported by libpq; statements are executed immediately");
+}
+
+void Connection::endPipeline()
+{
+}
+
+// no pipeline can be active without pipeline mode
+void Connection::discardPipeline()
+{
+    pipeline.clear();
+}
+
+void Connection::processPipeline(PGresult** last)
+{
+    if (last)
+        *last = 0;
+}
+
+#endif
+
 }
 }
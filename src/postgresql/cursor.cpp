@@ -50,6 +50,19 @@ Cursor::~Cursor()
     {
         std::string sql = "CLOSE " + cursorName;
 
+        if (stmt.getConnection()->inPipeline())
+        {
+            try
+            {
+                stmt.getConnection()->execute(sql);
+            }
+            catch (const std::exception& e)
+            {
+                log_error("error closing cursor: " << e.what());
+            }
+            return;
+        }
+
         log_debug("PQexec(" << getPGConn() << ", \"" << sql << "\")");
         PGresult* result = PQexec(getPGConn(), sql.c_str());
 
@@ -74,21 +87,30 @@ Row Cursor::fetch()
           + stmt.getQuery();
 
         // declare cursor
-        log_debug("PQexecParams(" << getPGConn() << ", \"" << sql
-          << "\", " << stmt.getNParams() << ", 0, paramValues, paramLengths, 0, 0)");
-        PGresult* result = PQexecParams(getPGConn(), sql.c_str(),
-          stmt.getNParams(), 0,
-          stmt.getParamValues(), stmt.getParamLengths(),
-          stmt.getParamFormats(), 0);
-
-        if (isError(result))
+        if (stmt.getConnection()->inPipeline())
         {
-            log_error(PQresultErrorMessage(result));
-            throw PgSqlError(sql, "PQexecParams", result, true);
+            stmt.getConnection()->sendQuery(sql, stmt.getNParams(), stmt.getParamTypes(),
+                stmt.getParamValues(), stmt.getParamLengths(), stmt.getParamFormats(), 0);
+            stmt.getConnection()->processPipeline();
+        }
+        else
+        {
+            log_debug("PQexecParams(" << getPGConn() << ", \"" << sql
+              << "\", " << stmt.getNParams() << ", paramTypes, paramValues, paramLengths, paramFormats, 0)");
+            PGresult* result = PQexecParams(getPGConn(), sql.c_str(),
+              stmt.getNParams(), stmt.getParamTypes(),
+              stmt.getParamValues(), stmt.getParamLengths(),
+              stmt.getParamFormats(), 0);
+
+            if (isError(result))
+            {
+                log_error(PQresultErrorMessage(result));
+                throw PgSqlError(sql, "PQexecParams", result, true);
+            }
+
+            log_debug("PQclear(" << result << ')');
+            PQclear(result);
         }
-
-        log_debug("PQclear(" << result << ')');
-        PQclear(result);
 
         cursorName = s.str();
     }
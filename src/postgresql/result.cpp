@@ -39,6 +39,20 @@ namespace postgresql
 {
 Result::Result(PGresult* result)
   : _result(result)
+{
+    log_debug("postgresql-result " << _result);
+
+    std::shared_ptr<ResultSchema> schema = std::make_shared<ResultSchema>();
+    int count = ::PQnfields(_result);
+    schema->reserve(count);
+    for (int n = 0; n < count; ++n)
+        schema->add(::PQfname(_result, n));
+    _schema = schema;
+}
+
+Result::Result(PGresult* result, const std::shared_ptr<const ResultSchema>& schema)
+  : _result(result),
+    _schema(schema)
 {
     log_debug("postgresql-result " << _result);
 }
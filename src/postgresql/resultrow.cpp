@@ -60,16 +60,7 @@ Value ResultRow::getValueByNumber(size_type field_num) const
 
 Value ResultRow::getValueByName(const std::string& field_name) const
 {
-    unsigned fc = _result.getFieldCount();
-    unsigned n;
-    for (n = 0; n < fc; ++n)
-        if (field_name == PQfname(getPGresult(), n))
-            break;
-
-    if (n == fc)
-        throw FieldNotFound(field_name);
-
-    return getValueByNumber(n);
+    return getValueByNumber(_result.getSchema().getFieldNumber(field_name));
 }
 
 std::string ResultRow::getColumnName(size_type field_num) const
@@ -77,6 +68,16 @@ std::string ResultRow::getColumnName(size_type field_num) const
     return PQfname(getPGresult(), field_num);
 }
 
+ResultRow::size_type ResultRow::getFieldNumber(const std::string& field_name) const
+{
+    return _result.getSchema().getFieldNumber(field_name);
+}
+
+const ResultSchema* ResultRow::getSchema() const
+{
+    return &_result.getSchema();
+}
+
 PGresult* ResultRow::getPGresult() const
 {
     return _result.getPGresult();
@@ -28,6 +28,7 @@
 
 #include <tntdb/postgresql/impl/resultvalue.h>
 #include <tntdb/postgresql/impl/result.h>
+#include <tntdb/postgresql/impl/binaryformat.h>
 #include <tntdb/error.h>
 #include <sstream>
 #include <cxxtools/log.h>
@@ -55,6 +56,64 @@ ResultValue::ResultValue(const Result& result, unsigned rownumber, int tup_num)
 {
 }
 
+bool ResultValue::isBinary() const
+{
+    return PQfformat(_result.getPGresult(), _tup_num) == 1;
+}
+
+Oid ResultValue::getType() const
+{
+    return PQftype(_result.getPGresult(), _tup_num);
+}
+
+const char* ResultValue::getValue() const
+{
+    if (PQgetisnull(_result.getPGresult(), _rownumber, _tup_num))
+      throw NullValue();
+    return PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
+}
+
+int ResultValue::getLength() const
+{
+    return PQgetlength(_result.getPGresult(), _rownumber, _tup_num);
+}
+
+template <typename T>
+T ResultValue::getInteger() const
+{
+    if (isBinary())
+    {
+        Oid type = getType();
+        if (type == INT2OID || type == INT4OID || type == INT8OID || type == OIDOID)
+        {
+            int64_t value = decodeInteger(type, getValue(), getLength());
+            if (value < static_cast<int64_t>(std::numeric_limits<T>::min())
+                || (value > 0 && static_cast<uint64_t>(value) > static_cast<uint64_t>(std::numeric_limits<T>::max())))
+            {
+                std::ostringstream msg;
+                msg << "value " << value << " out of range";
+                throw TypeError(msg.str());
+            }
+            return static_cast<T>(value);
+        }
+    }
+
+    return cxxtools::convert<T>(getString());
+}
+
+template <typename T>
+T ResultValue::getFloatValue() const
+{
+    if (isBinary())
+    {
+        Oid type = getType();
+        if (type == FLOAT4OID || type == FLOAT8OID || type == INT2OID || type == INT4OID || type == INT8OID)
+            return static_cast<T>(decodeFloat(type, getValue(), getLength()));
+    }
+
+    return cxxtools::convert<T>(getString());
+}
+
 bool ResultValue::isNull() const
 {
     return PQgetisnull(_result.getPGresult(), _rownumber, _tup_num) != 0;
@@ -62,7 +121,22 @@ bool ResultValue::isNull() const
 
 bool ResultValue::getBool() const
 {
-    char* value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
+    std::string s;
+    const char* value;
+    if (isBinary())
+    {
+        Oid type = getType();
+        if (type == BOOLOID)
+            return decodeBool(getValue(), getLength());
+        else if (type == INT2OID || type == INT4OID || type == INT8OID)
+            return decodeInteger(type, getValue(), getLength()) != 0;
+
+        getString(s);
+        value = s.c_str();
+    }
+    else
+        value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
+
     return value[0] == 't' || value[0] == 'T'
         || value[0] == 'y' || value[0] == 'Y'
         || value[0] == '1';
@@ -70,71 +144,81 @@ bool ResultValue::getBool() const
 
 short ResultValue::getShort() const
 {
-    return cxxtools::convert<short>(getString());
+    return getInteger<short>();
 }
 
 int ResultValue::getInt() const
 {
-    return cxxtools::convert<int>(getString());
+    return getInteger<int>();
 }
 
 long ResultValue::getLong() const
 {
-    return cxxtools::convert<long>(getString());
+    return getInteger<long>();
 }
 
 unsigned short ResultValue::getUnsignedShort() const
 {
-    return cxxtools::convert<unsigned short>(getString());
+    return getInteger<unsigned short>();
 }
 
 unsigned ResultValue::getUnsigned() const
 {
-    return cxxtools::convert<unsigned>(getString());
+    return getInteger<unsigned>();
 }
 
 unsigned long ResultValue::getUnsignedLong() const
 {
-    return cxxtools::convert<unsigned long>(getString());
+    return getInteger<unsigned long>();
 }
 
 int32_t ResultValue::getInt32() const
 {
-    return cxxtools::convert<int32_t>(getString());
+    return getInteger<int32_t>();
 }
 
 uint32_t ResultValue::getUnsigned32() const
 {
-    return cxxtools::convert<uint32_t>(getString());
+    return getInteger<uint32_t>();
 }
 
 int64_t ResultValue::getInt64() const
 {
-    return cxxtools::convert<int64_t>(getString());
+    return getInteger<int64_t>();
 }
 
 uint64_t ResultValue::getUnsigned64() const
 {
-    return cxxtools::convert<uint64_t>(getString());
+    return getInteger<uint64_t>();
 }
 
 Decimal ResultValue::getDecimal() const
 {
+    if (isBinary())
+    {
+        Oid type = getType();
+        if (type == INT2OID || type == INT4OID || type == INT8OID)
+            return Decimal(static_cast<long long>(decodeInteger(type, getValue(), getLength())));
+    }
+
     return Decimal(getString());
 }
 
 float ResultValue::getFloat() const
 {
-    return cxxtools::convert<float>(getString());
+    return getFloatValue<float>();
 }
 
 double ResultValue::getDouble() const
 {
-    return cxxtools::convert<double>(getString());
+    return getFloatValue<double>();
 }
 
 char ResultValue::getChar() const
 {
+    if (isBinary())
+        return getString()[0];
+
     char* value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
     return *value;
 }
@@ -145,11 +229,23 @@ void ResultValue::getString(std::string& ret) const
       throw NullValue();
     char* value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
     int len = PQgetlength(_result.getPGresult(), _rownumber, _tup_num);
-    ret.assign(value, len);
+    if (isBinary())
+        ret = decodeString(getType(), value, len);
+    else
+        ret.assign(value, len);
 }
 
 void ResultValue::getBlob(Blob& ret) const
 {
+    if (isBinary())
+    {
+        // bytea is received as is in binary format
+        std::string s;
+        getString(s);
+        ret.assign(s.data(), s.size());
+        return;
+    }
+
     char* value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
     int len = PQgetlength(_result.getPGresult(), _rownumber, _tup_num);
     log_debug("PQgetlength returns " << len);
@@ -159,9 +255,49 @@ void ResultValue::getBlob(Blob& ret) const
     PQfreemem(data);
 }
 
+const char* ResultValue::getStringData(std::size_t& length) const
+{
+    const char* value = getValue();
+    length = getLength();
+    if (!isBinary())
+        return value;
+
+    Oid type = getType();
+    if (type == BYTEAOID || isTextType(type))
+        return value;
+
+    if (type == JSONBOID && length >= 1 && value[0] == 1)
+    {
+        --length;
+        return value + 1;
+    }
+
+    throw TypeError("binary value of this type has no string representation without conversion");
+}
+
+const char* ResultValue::getBlobData(std::size_t& length) const
+{
+    // bytea is escaped in text format
+    if (!isBinary() && getType() == BYTEAOID)
+        throw TypeError("bytea in text format has no blob representation without conversion");
+    return getStringData(length);
+}
+
 Date ResultValue::getDate() const
 {
-    std::string value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
+    std::string value;
+    if (isBinary())
+    {
+        Oid type = getType();
+        if (type == DATEOID)
+            return decodeDate(getValue(), getLength());
+        else if (type == TIMESTAMPOID || type == TIMESTAMPTZOID)
+            return decodeTimestamp(getValue(), getLength()).getDate();
+        getString(value);
+    }
+    else
+        value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
+
     if (value.find('-') != std::string::npos)
     {
         // ISO 8601/SQL standard
@@ -200,7 +336,19 @@ Date ResultValue::getDate() const
 
 Time ResultValue::getTime() const
 {
-    std::string value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
+    std::string value;
+    if (isBinary())
+    {
+        Oid type = getType();
+        if (type == TIMEOID)
+            return decodeTime(getValue(), getLength());
+        else if (type == TIMESTAMPOID || type == TIMESTAMPTZOID)
+            return decodeTimestamp(getValue(), getLength()).getTime();
+        getString(value);
+    }
+    else
+        value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
+
     char ch;
     unsigned short hour, min, sec, msec;
     float fsec;
@@ -221,7 +369,19 @@ Time ResultValue::getTime() const
 
 Datetime ResultValue::getDatetime() const
 {
-    std::string value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
+    std::string value;
+    if (isBinary())
+    {
+        Oid type = getType();
+        if (type == TIMESTAMPOID || type == TIMESTAMPTZOID)
+            return decodeTimestamp(getValue(), getLength());
+        else if (type == DATEOID)
+            return Datetime(decodeDate(getValue(), getLength()), Time(0, 0, 0));
+        getString(value);
+    }
+    else
+        value = PQgetvalue(_result.getPGresult(), _rownumber, _tup_num);
+
     log_debug("datetime value=" << value);
     if (value.find('-') != std::string::npos)
     {
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/postgresql/impl/singlerowcursor.h>
+#include <tntdb/postgresql/impl/connection.h>
+#include <tntdb/postgresql/impl/result.h>
+#include <tntdb/postgresql/error.h>
+#include <tntdb/bits/row.h>
+#include <cxxtools/log.h>
+#include "config.h"
+
+log_define("tntdb.postgresql.singlerowcursor")
+
+namespace tntdb
+{
+namespace postgresql
+{
+SingleRowCursor::SingleRowCursor(Statement& statement, unsigned fetchSize)
+  : _stmt(statement),
+    _fetchSize(fetchSize),
+    _sent(false),
+    _active(false),
+    _currentRow(0)
+{ }
+
+SingleRowCursor::~SingleRowCursor()
+{
+    if (_active)
+        discard();
+}
+
+void SingleRowCursor::send()
+{
+    _stmt.sendStatement();
+
+    int ret;
+#ifdef HAVE_PQSETCHUNKEDROWSMODE
+    if (_fetchSize > 1)
+    {
+        log_debug("PQsetChunkedRowsMode(" << getPGConn() << ", " << _fetchSize << ')');
+        ret = PQsetChunkedRowsMode(getPGConn(), _fetchSize);
+    }
+    else
+#endif
+    {
+        log_debug("PQsetSingleRowMode(" << getPGConn() << ')');
+        ret = PQsetSingleRowMode(getPGConn());
+    }
+    if (!ret)
+        log_warn("failed to set single row mode; the result is read at once");
+
+    _sent = true;
+    _active = true;
+}
+
+void SingleRowCursor::discard()
+{
+    // cancel the query and read the remaining results
+    log_debug("discard remaining rows");
+
+    PGcancel* cancel = PQgetCancel(getPGConn());
+    if (cancel)
+    {
+        char errbuf[256];
+        if (!PQcancel(cancel, errbuf, sizeof(errbuf)))
+            log_warn("PQcancel failed: " << errbuf);
+        PQfreeCancel(cancel);
+    }
+
+    while (PGresult* result = PQgetResult(getPGConn()))
+        PQclear(result);
+
+    _active = false;
+}
+
+Row SingleRowCursor::fetch()
+{
+    if (!_currentResult || _currentRow >= _currentResult.size())
+    {
+        if (!_sent)
+            send();
+
+        // release the previous rows before reading the next
+        _currentResult = tntdb::Result();
+        _currentRow = 0;
+
+        if (!_active)
+            return Row();
+
+        PGresult* result = PQgetResult(getPGConn());
+        if (result == 0)
+        {
+            _active = false;
+            return Row();
+        }
+
+        // the rows are passed in results of their own status
+        ExecStatusType status = PQresultStatus(result);
+        bool rows = status == PGRES_SINGLE_TUPLE;
+#ifdef HAVE_PQSETCHUNKEDROWSMODE
+        rows = rows || status == PGRES_TUPLES_CHUNK;
+#endif
+        if (!rows && isError(result))
+        {
+            log_error(PQresultErrorMessage(result));
+            while (PGresult* r = PQgetResult(getPGConn()))
+                PQclear(r);
+            _active = false;
+            throw PgSqlError(_stmt.getQuery(), "PQgetResult", result, true);
+        }
+
+        if (_schema)
+            _currentResult = tntdb::Result(std::make_shared<Result>(result, _schema));
+        else
+        {
+            std::shared_ptr<Result> r = std::make_shared<Result>(result);
+            _schema = r->getSharedSchema();
+            _currentResult = tntdb::Result(r);
+        }
+
+        if (status == PGRES_TUPLES_OK)
+        {
+            // the final result, which has no rows in single row mode
+            while (PGresult* r = PQgetResult(getPGConn()))
+                PQclear(r);
+            _active = false;
+        }
+
+        log_debug(_currentResult.size() << " rows received");
+
+        if (_currentResult.empty())
+            return Row();
+    }
+
+    return _currentResult[_currentRow++];
+}
+}
+}
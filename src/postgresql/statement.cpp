@@ -32,6 +32,8 @@
 #include <tntdb/postgresql/impl/resultrow.h>
 #include <tntdb/postgresql/impl/resultvalue.h>
 #include <tntdb/postgresql/impl/cursor.h>
+#include <tntdb/postgresql/impl/singlerowcursor.h>
+#include <tntdb/postgresql/impl/binaryformat.h>
 #include <tntdb/postgresql/error.h>
 #include <tntdb/bits/result.h>
 #include <tntdb/bits/row.h>
@@ -39,6 +41,7 @@
 #include <tntdb/stmtparser.h>
 #include <sstream>
 #include <limits>
+#include <algorithm>
 #include <cxxtools/log.h>
 #include <cxxtools/convert.h>
 #include "config.h"
@@ -95,7 +98,15 @@ namespace
 }
 
 Statement::Statement(Connection* conn_, const std::string& query_)
-  : conn(conn_)
+  : conn(conn_),
+#ifdef HAVE_PQPREPARE
+    binary(conn_->getBinaryFormat()),
+#else
+    binary(false),
+#endif
+    maxDelay(0),
+    streaming(false),
+    executions(0)
 {
     // parse hostvars
     StmtParser parser;
@@ -109,10 +120,24 @@ Statement::Statement(Connection* conn_, const std::string& query_)
     paramValues.resize(se.getMaxIdx());
     paramLengths.resize(se.getMaxIdx());
     paramFormats.resize(se.getMaxIdx());
+    if (binary)
+        paramTypes.resize(se.getMaxIdx());
 }
 
 Statement::~Statement()
 {
+    if (!delayed.empty())
+    {
+        try
+        {
+            flush();
+        }
+        catch (const std::exception& e)
+        {
+            log_error("failed to flush delayed statements: " << e.what());
+        }
+    }
+
     if (!stmtName.empty())
         conn->deallocateStatement(stmtName);
 }
@@ -125,10 +150,18 @@ void Statement::doPrepare()
 
     // prepare statement
 #ifdef HAVE_PQPREPARE
+    if (conn->inPipeline())
+    {
+        // errors are reported at the next sync point
+        conn->sendPrepare(s.str(), query, binary ? getNParams() : 0, getParamTypes());
+        stmtName = s.str();
+        return;
+    }
+
     log_debug("PQprepare(" << getPGConn() << ", \"" << s.str()
-      << "\", \"" << query << "\", 0, 0)");
+      << "\", \"" << query << "\", " << (binary ? values.size() : 0) << ", paramTypes)");
     PGresult* result = PQprepare(getPGConn(),
-        s.str().c_str(), query.c_str(), 0, 0);
+        s.str().c_str(), query.c_str(), binary ? getNParams() : 0, getParamTypes());
 
     if (isError(result))
     {
@@ -144,6 +177,13 @@ void Statement::doPrepare()
         sql << ')';
     sql << " AS " << query;
 
+    if (conn->inPipeline())
+    {
+        conn->sendQuery(sql.str(), 0, 0, 0, 0, 0, 0);
+        stmtName = s.str();
+        return;
+    }
+
     log_debug("PQexec(" << getPGConn() << ", \"" << sql.str() << "\")");
     PGresult* result = PQexec(getPGConn(), sql.str().c_str());
 
@@ -160,15 +200,63 @@ void Statement::doPrepare()
     PQclear(result);
 }
 
-PGresult* Statement::execPrepared()
+// A statement is executed as the unnamed statement, until it is executed
+// the prepareThreshold time. So a statement, which is executed just once,
+// saves the round trips of the PREPARE and the DEALLOCATE. This counts the
+// execution.
+bool Statement::usePrepared()
 {
+    if (!stmtName.empty())
+        return true;
+
+    unsigned threshold = conn->getPrepareThreshold();
+    return threshold > 0 && ++executions >= threshold;
+}
+
+PGresult* Statement::execStatement()
+{
+    if (!usePrepared())
+    {
+        if (conn->inPipeline())
+        {
+            PGresult* result;
+            conn->sendQuery(query, getNParams(), getParamTypes(), getParamValues(),
+                getParamLengths(), getParamFormats(), binary);
+            conn->processPipeline(&result);
+            return result;
+        }
+
+        log_debug("PQexecParams(" << getPGConn() << ", \"" << query
+          << "\", " << values.size() << ", paramTypes, paramValues, paramLengths, paramFormats, " << binary << ')');
+        PGresult* result = PQexecParams(getPGConn(), query.c_str(), getNParams(), getParamTypes(),
+            getParamValues(), getParamLengths(), getParamFormats(), binary);
+
+        if (isError(result))
+        {
+            log_error(PQresultErrorMessage(result));
+            throw PgSqlError(query, "PQexecParams", result, true);
+        }
+
+        return result;
+    }
+
     if (stmtName.empty())
         doPrepare();
 
+    if (conn->inPipeline())
+    {
+        // the result is needed, so the pipeline is synced
+        PGresult* result;
+        conn->sendQueryPrepared(stmtName, query, getNParams(), getParamValues(),
+            getParamLengths(), getParamFormats(), binary);
+        conn->processPipeline(&result);
+        return result;
+    }
+
     log_debug("PQexecPrepared(" << getPGConn() << ", \"" << stmtName
-      << "\", " << values.size() << ", paramValues, paramLengths, paramFormats, 0)");
+      << "\", " << values.size() << ", paramValues, paramLengths, paramFormats, " << binary << ')');
     PGresult* result = PQexecPrepared(getPGConn(), stmtName.c_str(),
-        getNParams(), getParamValues(), getParamLengths(), getParamFormats(), 0);
+        getNParams(), getParamValues(), getParamLengths(), getParamFormats(), binary);
 
     if (isError(result))
     {
@@ -188,68 +276,51 @@ unsigned Statement::hostvarId(const std::string& col)
     return it->second;
 }
 
-template <typename T>
-void Statement::setValue(const std::string& col, T data)
+// A parameter is sent in binary format, when the binary format is enabled
+// and the type matches the type, the statement was prepared with. Otherwise
+// it is sent as text, which the server converts to the prepared type.
+bool Statement::binaryParam(unsigned hv, Oid type) const
 {
-    unsigned hv = hostvarId(col);
-    std::string v = cxxtools::convert<std::string>(data);
-    values[hv].setValue(v);
-    paramFormats[hv] = 0;
+    return binary && (stmtName.empty() || paramTypes[hv] == type);
 }
 
-template <>
-void Statement::setValue(const std::string& col, float data)
+void Statement::setParam(unsigned hv, std::string v, int format, Oid type)
 {
-    unsigned hv = hostvarId(col);
-    std::ostringstream v;
-    v.precision(24);
-    v << data;
-    values[hv].setValue(v.str());
-    paramFormats[hv] = 0;
+    values[hv].setValue(std::move(v));
+    setFormat(hv, format, type);
 }
 
-template <>
-void Statement::setValue(const std::string& col, double data)
+void Statement::setParamRef(unsigned hv, const char* data, std::size_t length, int format, Oid type)
 {
-    unsigned hv = hostvarId(col);
-    std::ostringstream v;
-    v.precision(24);
-    v << data;
-    values[hv].setValue(v.str());
-    paramFormats[hv] = 0;
+    values[hv].setRef(data, length);
+    setFormat(hv, format, type);
 }
 
-template <>
-void Statement::setValue(const std::string& col, Decimal data)
+void Statement::setFormat(unsigned hv, int format, Oid type)
 {
-    unsigned hv = hostvarId(col);
-    std::ostringstream v;
-    v.precision(24);
-    v << data;
-    values[hv].setValue(v.str());
-    paramFormats[hv] = 0;
+    paramFormats[hv] = format;
+    if (binary && stmtName.empty())
+        paramTypes[hv] = type;
 }
 
 template <typename T>
-void Statement::setStringValue(const std::string& col, T data, bool binary)
+void Statement::setValue(unsigned hv, T data, Oid type)
 {
-    unsigned hv = hostvarId(col);
-    values[hv].setValue(data);
-    paramFormats[hv] = binary;
+    if (binaryParam(hv, type))
+        setParam(hv, encodeBinary(data), 1, type);
+    else
+        setParam(hv, encodeText(data), 0);
 }
 
 template <typename T>
-void Statement::setIsoValue(const std::string& col, T data)
+void Statement::setStringValue(unsigned hv, T data, bool binary)
 {
-    unsigned hv = hostvarId(col);
-    values[hv].setValue(data.getIso());
-    paramFormats[hv] = 0;
+    setParam(hv, std::move(data), binary, binary ? BYTEAOID : 0);
 }
 
 #ifndef HAVE_PQPREPARE
-void Statement::setType(const std::string& col, const std::string& type)
+void Statement::setType(unsigned hv, const std::string& type)
 {
-    unsigned hv = hostvarId(col);
     values[hv].setType(type);
 }
 #endif
@@ -263,176 +334,345 @@ void Statement::clear()
 
 void Statement::setNull(const std::string& col)
 {
-    log_debug("setNull(\"" << col << "\")");
-
-    unsigned hv = hostvarId(col);
-    values[hv].setNull();
-    paramFormats[hv] = 0;
+    setNullAt(hostvarId(col));
 }
 
 void Statement::setBool(const std::string& col, bool data)
 {
-    log_debug("setBool(\"" << col << "\", " << data << ')');
-
-    unsigned hv = hostvarId(col);
-    values[hv].setValue(data ? "1" : "0");
-    paramFormats[hv] = 0;
-
-    SET_TYPE(col, "bool");
+    setBoolAt(hostvarId(col), data);
 }
 
 void Statement::setShort(const std::string& col, short data)
 {
-    log_debug("setShort(\"" << col << "\", " << data << ')');
-    setValue(col, data);
-    SET_TYPE(col, "short");
+    setShortAt(hostvarId(col), data);
 }
 
 void Statement::setInt(const std::string& col, int data)
 {
-    log_debug("setInt(\"" << col << "\", " << data << ')');
-    setValue(col, data);
-    SET_TYPE(col, "int");
+    setIntAt(hostvarId(col), data);
 }
 
 void Statement::setLong(const std::string& col, long data)
 {
-    log_debug("setLong(\"" << col << "\", " << data << ')');
-    setValue(col, data);
-    SET_TYPE(col, "long");
+    setLongAt(hostvarId(col), data);
 }
 
 void Statement::setUnsignedShort(const std::string& col, unsigned short data)
 {
-    log_debug("setUnsignedShort(\"" << col << "\", " << data << ')');
-    setValue(col, data);
-    SET_TYPE(col, "unsigned short");
+    setUnsignedShortAt(hostvarId(col), data);
 }
 
 void Statement::setUnsigned(const std::string& col, unsigned data)
 {
-    log_debug("setUnsigned(\"" << col << "\", " << data << ')');
-    setValue(col, data);
-    SET_TYPE(col, "unsigned");
+    setUnsignedAt(hostvarId(col), data);
 }
 
 void Statement::setUnsignedLong(const std::string& col, unsigned long data)
 {
-    log_debug("setUnsignedLong(\"" << col << "\", " << data << ')');
-    setValue(col, data);
-    SET_TYPE(col, "unsigned long");
+    setUnsignedLongAt(hostvarId(col), data);
 }
 
 void Statement::setInt32(const std::string& col, int32_t data)
 {
-    log_debug("setInt32(\"" << col << "\", " << data << ')');
-    setValue(col, data);
-    SET_TYPE(col, "int");
+    setInt32At(hostvarId(col), data);
 }
 
 void Statement::setUnsigned32(const std::string& col, uint32_t data)
 {
-    log_debug("setUnsigned32(\"" << col << "\", " << data << ')');
-    setValue(col, data);
-    SET_TYPE(col, "int");
+    setUnsigned32At(hostvarId(col), data);
 }
 
 void Statement::setInt64(const std::string& col, int64_t data)
 {
-    log_debug("setInt64(\"" << col << "\", " << data << ')');
-    setValue(col, data);
-    SET_TYPE(col, "bigint");
+    setInt64At(hostvarId(col), data);
 }
 
 void Statement::setUnsigned64(const std::string& col, uint64_t data)
 {
-    log_debug("setUnsigned64(\"" << col << "\", " << data << ')');
-    setValue(col, data);
-    SET_TYPE(col, "bigint");
+    setUnsigned64At(hostvarId(col), data);
 }
 
 void Statement::setDecimal(const std::string& col, const Decimal& data)
 {
-    log_debug("setDecimal(\"" << col << "\", " << data << ')');
-    setValue(col, data);
-    SET_TYPE(col, "numeric");
+    setDecimalAt(hostvarId(col), data);
 }
 
 void Statement::setFloat(const std::string& col, float data)
 {
-    log_debug("setFloat(\"" << col << "\", " << data << ')');
-    if (data != data)
-        setValue(col, "NaN");
-    else if (data == std::numeric_limits<float>::infinity())
-        setValue(col, "Infinity");
-    else if (data == -std::numeric_limits<float>::infinity())
-        setValue(col, "-Infinity");
-    else
-        setValue(col, data);
-    SET_TYPE(col, "numeric");
+    setFloatAt(hostvarId(col), data);
 }
 
 void Statement::setDouble(const std::string& col, double data)
 {
-    log_debug("setDouble(\"" << col << "\", " << data << ')');
-    if (data != data)
-        setValue(col, "NaN");
-    else if (data == std::numeric_limits<double>::infinity())
-        setValue(col, "Infinity");
-    else if (data == -std::numeric_limits<double>::infinity())
-        setValue(col, "-Infinity");
-    else
-        setValue(col, data);
-    SET_TYPE(col, "numeric");
+    setDoubleAt(hostvarId(col), data);
 }
 
 void Statement::setChar(const std::string& col, char data)
 {
-    log_debug("setChar(\"" << col << "\", '" << data << "')");
-    setStringValue(col, std::string(1, data));
-    SET_TYPE(col, "text");
+    setCharAt(hostvarId(col), data);
 }
 
 void Statement::setString(const std::string& col, const std::string& data)
 {
-    log_debug("setString(\"" << col << "\", \"" << data << "\")");
-    setStringValue(col, data);
-    SET_TYPE(col, "text");
+    setStringAt(hostvarId(col), data);
 }
 
 void Statement::setBlob(const std::string& col, const Blob& data)
 {
-    log_debug("setBlob(\"" << col << "\", Blob)");
-    setStringValue(col, std::string(data.data(), data.size()), true);
-    SET_TYPE(col, "blob");
+    setBlobAt(hostvarId(col), data);
 }
 
 void Statement::setDate(const std::string& col, const Date& data)
 {
-    log_debug("setDate(\"" << col << "\", " << data.getIso() << ')');
-    setIsoValue(col, data);
-    SET_TYPE(col, "date");
+    setDateAt(hostvarId(col), data);
 }
 
 void Statement::setTime(const std::string& col, const Time& data)
 {
-    log_debug("setTime(\"" << col << "\", " << data.getIso() << ')');
-    setIsoValue(col, data);
-    SET_TYPE(col, "time");
+    setTimeAt(hostvarId(col), data);
 }
 
 void Statement::setDatetime(const std::string& col, const Datetime& data)
 {
-    log_debug("setDatetime(\"" << col << "\", " << data.getIso() << ')');
-    setIsoValue(col, data);
-    SET_TYPE(col, "datetime");
+    setDatetimeAt(hostvarId(col), data);
+}
+
+Statement::size_type Statement::paramIndex(const std::string& col)
+{
+    return hostvarId(col);
+}
+
+void Statement::setNullAt(size_type hv)
+{
+    log_debug("setNullAt(" << hv << ")");
+
+    values[hv].setNull();
+    paramFormats[hv] = 0;
+}
+
+void Statement::setBoolAt(size_type hv, bool data)
+{
+    log_debug("setBoolAt(" << hv << ", " << data << ')');
+
+    setValue(hv, data, BOOLOID);
+    SET_TYPE(hv, "bool");
+}
+
+void Statement::setShortAt(size_type hv, short data)
+{
+    log_debug("setShortAt(" << hv << ", " << data << ')');
+    setValue(hv, static_cast<int16_t>(data), INT2OID);
+    SET_TYPE(hv, "short");
+}
+
+void Statement::setIntAt(size_type hv, int data)
+{
+    log_debug("setIntAt(" << hv << ", " << data << ')');
+    setValue(hv, static_cast<int32_t>(data), INT4OID);
+    SET_TYPE(hv, "int");
+}
+
+void Statement::setLongAt(size_type hv, long data)
+{
+    log_debug("setLongAt(" << hv << ", " << data << ')');
+    if (sizeof(long) == sizeof(int32_t))
+        setValue(hv, static_cast<int32_t>(data), INT4OID);
+    else
+        setValue(hv, static_cast<int64_t>(data), INT8OID);
+    SET_TYPE(hv, "long");
+}
+
+void Statement::setUnsignedShortAt(size_type hv, unsigned short data)
+{
+    log_debug("setUnsignedShortAt(" << hv << ", " << data << ')');
+    setValue(hv, static_cast<int32_t>(data), INT4OID);
+    SET_TYPE(hv, "unsigned short");
+}
+
+void Statement::setUnsignedAt(size_type hv, unsigned data)
+{
+    log_debug("setUnsignedAt(" << hv << ", " << data << ')');
+    setValue(hv, static_cast<int64_t>(data), INT8OID);
+    SET_TYPE(hv, "unsigned");
+}
+
+void Statement::setUnsignedLongAt(size_type hv, unsigned long data)
+{
+    log_debug("setUnsignedLongAt(" << hv << ", " << data << ')');
+    if (data > static_cast<unsigned long>(std::numeric_limits<int64_t>::max()))
+        setValue(hv, Decimal(data), NUMERICOID);
+    else
+        setValue(hv, static_cast<int64_t>(data), INT8OID);
+    SET_TYPE(hv, "unsigned long");
+}
+
+void Statement::setInt32At(size_type hv, int32_t data)
+{
+    log_debug("setInt32At(" << hv << ", " << data << ')');
+    setValue(hv, data, INT4OID);
+    SET_TYPE(hv, "int");
+}
+
+void Statement::setUnsigned32At(size_type hv, uint32_t data)
+{
+    log_debug("setUnsigned32At(" << hv << ", " << data << ')');
+    setValue(hv, static_cast<int64_t>(data), INT8OID);
+    SET_TYPE(hv, "int");
+}
+
+void Statement::setInt64At(size_type hv, int64_t data)
+{
+    log_debug("setInt64At(" << hv << ", " << data << ')');
+    setValue(hv, data, INT8OID);
+    SET_TYPE(hv, "bigint");
+}
+
+void Statement::setUnsigned64At(size_type hv, uint64_t data)
+{
+    log_debug("setUnsigned64At(" << hv << ", " << data << ')');
+    if (data > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+        setValue(hv, Decimal(static_cast<unsigned long long>(data)), NUMERICOID);
+    else
+        setValue(hv, static_cast<int64_t>(data), INT8OID);
+    SET_TYPE(hv, "bigint");
+}
+
+void Statement::setDecimalAt(size_type hv, const Decimal& data)
+{
+    log_debug("setDecimalAt(" << hv << ", " << data << ')');
+    setValue(hv, data, NUMERICOID);
+    SET_TYPE(hv, "numeric");
+}
+
+void Statement::setFloatAt(size_type hv, float data)
+{
+    log_debug("setFloatAt(" << hv << ", " << data << ')');
+    setValue(hv, data, FLOAT4OID);
+    SET_TYPE(hv, "numeric");
+}
+
+void Statement::setDoubleAt(size_type hv, double data)
+{
+    log_debug("setDoubleAt(" << hv << ", " << data << ')');
+    setValue(hv, data, FLOAT8OID);
+    SET_TYPE(hv, "numeric");
+}
+
+void Statement::setCharAt(size_type hv, char data)
+{
+    log_debug("setCharAt(" << hv << ", '" << data << "')");
+    setStringValue(hv, std::string(1, data));
+    SET_TYPE(hv, "text");
+}
+
+void Statement::setStringAt(size_type hv, const std::string& data)
+{
+    log_debug("setStringAt(" << hv << ", \"" << data << "\")");
+    setStringValue(hv, data);
+    SET_TYPE(hv, "text");
+}
+
+void Statement::setBlobAt(size_type hv, const Blob& data)
+{
+    log_debug("setBlobAt(" << hv << ", Blob)");
+    setStringValue(hv, std::string(data.data(), data.size()), true);
+    SET_TYPE(hv, "blob");
+}
+
+void Statement::setDateAt(size_type hv, const Date& data)
+{
+    log_debug("setDateAt(" << hv << ", " << data.getIso() << ')');
+    setValue(hv, data, DATEOID);
+    SET_TYPE(hv, "date");
+}
+
+void Statement::setTimeAt(size_type hv, const Time& data)
+{
+    log_debug("setTimeAt(" << hv << ", " << data.getIso() << ')');
+    setValue(hv, data, TIMEOID);
+    SET_TYPE(hv, "time");
+}
+
+void Statement::setDatetimeAt(size_type hv, const Datetime& data)
+{
+    log_debug("setDatetimeAt(" << hv << ", " << data.getIso() << ')');
+    setValue(hv, data, TIMESTAMPOID);
+    SET_TYPE(hv, "datetime");
+}
+
+void Statement::setStringRef(const std::string& col, const char* data, std::size_t length)
+{
+    setStringRefAt(hostvarId(col), data, length);
+}
+
+void Statement::setBlobRef(const std::string& col, const char* data, std::size_t length)
+{
+    setBlobRefAt(hostvarId(col), data, length);
+}
+
+void Statement::takeString(const std::string& col, std::string&& data)
+{
+    takeStringAt(hostvarId(col), std::move(data));
+}
+
+void Statement::setStringRefAt(size_type hv, const char* data, std::size_t length)
+{
+    log_debug("setStringRefAt(" << hv << ", data, " << length << ')');
+    setParamRef(hv, data, length, 0, 0);
+    SET_TYPE(hv, "text");
+}
+
+void Statement::setBlobRefAt(size_type hv, const char* data, std::size_t length)
+{
+    log_debug("setBlobRefAt(" << hv << ", data, " << length << ')');
+    setParamRef(hv, data, length, 1, BYTEAOID);
+    SET_TYPE(hv, "blob");
+}
+
+void Statement::takeStringAt(size_type hv, std::string&& data)
+{
+    log_debug("takeStringAt(" << hv << ", \"" << data << "\")");
+    setParam(hv, std::move(data), 0);
+    SET_TYPE(hv, "text");
 }
 
 Statement::size_type Statement::execute()
 {
     log_debug("execute()");
 
-    PGresult* result = execPrepared();
+    if (conn->inPipeline())
+    {
+        if (stmtName.empty())
+            doPrepare();
+
+        conn->sendQueryPrepared(stmtName, query, getNParams(), getParamValues(),
+            getParamLengths(), getParamFormats(), 0);
+        return 0;
+    }
+
+    if (maxDelay > 0)
+    {
+        // the parameters of the delayed executions are encoded for the
+        // types, the statement is prepared with
+        if (binary && stmtName.empty())
+            doPrepare();
+
+        delayedType d;
+        d.values = values;
+        d.paramFormats = paramFormats;
+        for (valuesType::iterator it = d.values.begin(); it != d.values.end(); ++it)
+            it->keep();
+        delayed.push_back(d);
+
+        log_debug(delayed.size() << " statements delayed");
+
+        if (delayed.size() >= maxDelay)
+            return flush();
+
+        return 0;
+    }
+
+    PGresult* result = execStatement();
 
     std::istringstream tuples(PQcmdTuples(result));
     unsigned ret = 0;
@@ -447,13 +687,13 @@ Statement::size_type Statement::execute()
 tntdb::Result Statement::select()
 {
     log_debug("select()");
-    PGresult* result = execPrepared();
+    PGresult* result = execStatement();
     return tntdb::Result(std::make_shared<Result>(result));
 }
 
 tntdb::Row Statement::selectRow()
 {
-    auto result = std::make_shared<Result>(execPrepared());
+    auto result = std::make_shared<Result>(execStatement());
 
     if (result->size() <= 0)
         throw NotFound();
@@ -463,7 +703,7 @@ tntdb::Row Statement::selectRow()
 
 tntdb::Value Statement::selectValue()
 {
-    auto result = std::make_shared<Result>(execPrepared());
+    auto result = std::make_shared<Result>(execStatement());
 
     if (result->size() <= 0)
         throw NotFound();
@@ -473,9 +713,229 @@ tntdb::Value Statement::selectValue()
 
 std::shared_ptr<ICursor> Statement::createCursor(unsigned fetchsize)
 {
+#ifdef HAVE_PQSETSINGLEROWMODE
+    if (streaming && !conn->inPipeline())
+        return std::make_shared<SingleRowCursor>(*this, fetchsize);
+#endif
     return std::make_shared<Cursor>(*this, fetchsize);
 }
 
+void Statement::setStreaming(bool sw)
+{
+    streaming = sw;
+}
+
+bool Statement::isStreaming() const
+{
+    return streaming;
+}
+
+void Statement::sendStatement()
+{
+    if (!usePrepared())
+    {
+        log_debug("PQsendQueryParams(" << getPGConn() << ", \"" << query
+          << "\", " << values.size() << ", paramTypes, paramValues, paramLengths, paramFormats, " << binary << ')');
+        if (!PQsendQueryParams(getPGConn(), query.c_str(), getNParams(), getParamTypes(),
+                getParamValues(), getParamLengths(), getParamFormats(), binary))
+            throw PgConnError("PQsendQueryParams", getPGConn());
+        return;
+    }
+
+    if (stmtName.empty())
+        doPrepare();
+
+    log_debug("PQsendQueryPrepared(" << getPGConn() << ", \"" << stmtName
+      << "\", " << values.size() << ", paramValues, paramLengths, paramFormats, " << binary << ')');
+    if (!PQsendQueryPrepared(getPGConn(), stmtName.c_str(), getNParams(),
+            getParamValues(), getParamLengths(), getParamFormats(), binary))
+        throw PgConnError("PQsendQueryPrepared", getPGConn());
+}
+
+void Statement::maxNumDelay(size_type n)
+{
+    maxDelay = n;
+    if (delayed.size() >= maxDelay)
+        flush();
+}
+
+Statement::size_type Statement::numDelayed() const
+{
+    return delayed.size();
+}
+
+Statement::size_type Statement::flush()
+{
+    if (delayed.empty())
+        return 0;
+
+    log_debug("flush " << delayed.size() << " delayed statements");
+
+    // the delayed statements are discarded also when the execution fails
+    std::vector<delayedType> d;
+    d.swap(delayed);
+
+    if (stmtName.empty())
+        doPrepare();
+
+    if (conn->inPipeline())
+    {
+        // the delayed statements are just queued in the pipeline of the connection
+        for (unsigned n = 0; n < d.size(); ++n)
+        {
+            setParams(d[n]);
+            conn->sendQueryPrepared(stmtName, query, getNParams(), paramValues.data(),
+                paramLengths.data(), d[n].paramFormats.data(), 0);
+        }
+        return 0;
+    }
+
+    return execDelayed(d);
+}
+
+void Statement::setParams(delayedType& d)
+{
+    for (unsigned n = 0; n < d.values.size(); ++n)
+    {
+        paramValues[n] = d.values[n].getValue();
+        paramLengths[n] = d.values[n].getLength();
+    }
+}
+
+#ifdef HAVE_PQENTERPIPELINEMODE
+
+Statement::size_type Statement::execDelayed(std::vector<delayedType>& d)
+{
+    // The statements are sent in pipeline mode without waiting for the
+    // results, so that all of them need just one round trip. The pipeline
+    // is synced in chunks, so that the results the server sends in the
+    // meantime do not fill up the socket buffers while the client still
+    // sends.
+    static const unsigned chunkSize = 1000;
+
+    PGconn* pgconn = getPGConn();
+
+    log_debug("PQenterPipelineMode(" << pgconn << ')');
+    if (!PQenterPipelineMode(pgconn))
+        throw PgConnError("PQenterPipelineMode", pgconn);
+
+    size_type count = 0;
+    PGresult* error = 0;
+
+    try
+    {
+        for (unsigned chunk = 0; chunk < d.size(); chunk += chunkSize)
+        {
+            unsigned end = std::min<unsigned>(chunk + chunkSize, d.size());
+
+            for (unsigned n = chunk; n < end; ++n)
+            {
+                setParams(d[n]);
+
+                if (!PQsendQueryPrepared(pgconn, stmtName.c_str(), getNParams(),
+                        paramValues.data(), paramLengths.data(), d[n].paramFormats.data(), 0))
+                    throw PgConnError("PQsendQueryPrepared", pgconn);
+            }
+
+            log_debug("PQpipelineSync(" << pgconn << ") after " << (end - chunk) << " statements");
+            if (!PQpipelineSync(pgconn))
+                throw PgConnError("PQpipelineSync", pgconn);
+
+            // Each statement delivers one result followed by a null pointer.
+            // After an error the remaining statements up to the sync point are
+            // reported as aborted.
+            for (unsigned n = chunk; n < end; ++n)
+            {
+                PGresult* result = PQgetResult(pgconn);
+                if (result == 0)
+                    throw PgConnError("PQgetResult", pgconn);
+
+                ExecStatusType status = PQresultStatus(result);
+                if (status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK)
+                {
+                    std::istringstream tuples(PQcmdTuples(result));
+                    unsigned ret = 0;
+                    tuples >> ret;
+                    count += ret;
+                    PQclear(result);
+                }
+                else if (status == PGRES_PIPELINE_ABORTED || error)
+                {
+                    PQclear(result);
+                }
+                else
+                {
+                    log_error("delayed statement " << n << " failed: " << PQresultErrorMessage(result));
+                    error = result;
+                }
+
+                while ((result = PQgetResult(pgconn)) != 0)
+                    PQclear(result);
+            }
+
+            PGresult* sync = PQgetResult(pgconn);
+            if (sync)
+                PQclear(sync);
+
+            if (error)
+                break;
+        }
+    }
+    catch (...)
+    {
+        // leave the pipeline mode, so that the connection is usable again
+        if (error)
+            PQclear(error);
+        conn->discardPipeline();
+        log_debug("PQexitPipelineMode(" << pgconn << ')');
+        PQexitPipelineMode(pgconn);
+        throw;
+    }
+
+    log_debug("PQexitPipelineMode(" << pgconn << ')');
+    PQexitPipelineMode(pgconn);
+
+    if (error)
+        throw PgSqlError(query, "PQsendQueryPrepared", error, true);
+
+    return count;
+}
+
+#else
+
+Statement::size_type Statement::execDelayed(std::vector<delayedType>& d)
+{
+    // without pipeline mode the statements are just executed one by one
+    size_type count = 0;
+
+    for (unsigned n = 0; n < d.size(); ++n)
+    {
+        setParams(d[n]);
+
+        log_debug("PQexecPrepared(" << getPGConn() << ", \"" << stmtName
+          << "\", " << getNParams() << ", paramValues, paramLengths, paramFormats, 0)");
+        PGresult* result = PQexecPrepared(getPGConn(), stmtName.c_str(),
+            getNParams(), paramValues.data(), paramLengths.data(), d[n].paramFormats.data(), 0);
+
+        if (isError(result))
+        {
+            log_error(PQresultErrorMessage(result));
+            throw PgSqlError(query, "PQexecPrepared", result, true);
+        }
+
+        std::istringstream tuples(PQcmdTuples(result));
+        unsigned ret = 0;
+        tuples >> ret;
+        count += ret;
+
+        PQclear(result);
+    }
+
+    return count;
+}
+
+#endif
+
 const char* const* Statement::getParamValues()
 {
     for (unsigned n = 0; n < values.size(); ++n)
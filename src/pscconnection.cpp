@@ -5,18 +5,33 @@ log_define("tntdb.PSCConnection")
 
 namespace tntdb
 {
+PSCConnection::PSCConnection(tntdb::Connection conn, unsigned maxSize, StatementCache::Duration maxAge)
+    : Connection(conn)
+{
+    StatementCache* cache = getImpl() ? getImpl()->getStatementCache(maxSize, maxAge) : 0;
+    if (cache)
+    {
+        // the cache is owned by the connection, which is kept alive here
+        log_debug("use statement cache of connection");
+        _stmtCache = std::shared_ptr<StatementCache>(getImpl(), cache);
+    }
+    else
+        _stmtCache = std::make_shared<StatementCache>(maxSize, maxAge);
+}
+
 Statement PSCConnection::prepare(const std::string& query)
 {
     log_debug("prepare(\"" << query << "\")");
-    auto it = _stmtCache->find(query);
-    if (it != _stmtCache->end())
+    auto stmt = _stmtCache->get(query);
+    if (!stmt)
     {
-        log_debug("query found in cache");
-        return it->second;
+        log_debug("query not found in cache");
+        stmt = Connection::prepare(query);
+        _stmtCache->put(query, stmt);
     }
-    log_debug("query not found in cache");
-    auto stmt = Connection::prepare(query);
-    _stmtCache->emplace(query, stmt);
+    else
+        log_debug("query found in cache");
+
     return stmt;
 }
 
@@ -24,16 +39,16 @@ Statement PSCConnection::prepareWithLimit(const std::string& query, const std::s
 {
     log_debug("prepareWithLimit(\"" << query << "\", " << limit << ", " << offset << ')');
     auto key = query + '\0' + limit + '\0' + offset;
-    auto it = _stmtCache->find(key);
-    if (it != _stmtCache->end())
+    auto stmt = _stmtCache->get(key);
+    if (!stmt)
     {
-        log_debug("query found in cache");
-        return it->second;
+        log_debug("query not found in cache");
+        stmt = Connection::prepareWithLimit(query, limit, offset);
+        _stmtCache->put(key, stmt);
     }
+    else
+        log_debug("query found in cache");
 
-    log_debug("query not found in cache");
-    auto stmt = Connection::prepareWithLimit(query, limit, offset);
-    _stmtCache->emplace(key, stmt);
     return stmt;
 }
 
@@ -165,5 +165,25 @@ void Connection::lockTable(const std::string& tablename, bool exclusive)
     connections.begin()->getImpl()->lockTable(tablename, exclusive);
 }
 
+void Connection::beginPipeline()
+{
+    for (Connections::iterator it = connections.begin(); it != connections.end(); ++it)
+        it->beginPipeline();
+}
+
+Connection::size_type Connection::syncPipeline()
+{
+    size_type ret = connections[0].syncPipeline();
+    for (Connections::size_type n = 1; n < connections.size(); ++n)
+        connections[n].syncPipeline();
+    return ret;
+}
+
+void Connection::endPipeline()
+{
+    for (Connections::iterator it = connections.begin(); it != connections.end(); ++it)
+        it->endPipeline();
+}
+
 }
 }
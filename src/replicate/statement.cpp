@@ -44,7 +44,9 @@ namespace tntdb
 namespace replicate
 {
 Statement::Statement(Connection& conn, const std::string& query, const std::string& limit, const std::string& offset)
-  : _conn(conn)
+  : _conn(conn),
+    _maxNumDelay(0),
+    _numDelayed(0)
 {
     // check if it a select statement
     // a select statement need to be prepared only on the first connection
@@ -204,6 +206,18 @@ void Statement::setDatetime(const std::string& col, const Datetime& data)
 
 Statement::size_type Statement::execute()
 {
+    if (_maxNumDelay > 0 && _numDelayed + 1 < _maxNumDelay)
+    {
+        // the statements delay the execution themselves; they are
+        // flushed in one transaction when the buffer is full
+        for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
+            it->execute();
+        ++_numDelayed;
+        return 0;
+    }
+
+    _numDelayed = 0;
+
     Transaction transaction(_conn);
 
     Statement::size_type ret = statements[0].execute();
@@ -246,5 +260,60 @@ std::shared_ptr<ICursor> Statement::createCursor(unsigned fetchsize)
     return statements.begin()->getImpl()->createCursor(fetchsize);
 }
 
+void Statement::maxNumDelay(size_type n)
+{
+    if (_numDelayed >= n)
+        flush();
+
+    _maxNumDelay = n;
+    for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
+        it->maxNumDelay(n);
+}
+
+Statement::size_type Statement::numDelayed() const
+{
+    return _numDelayed;
+}
+
+Statement::size_type Statement::flush()
+{
+    if (_numDelayed == 0)
+        return 0;
+
+    _numDelayed = 0;
+
+    Transaction transaction(_conn);
+
+    Statement::size_type ret = statements[0].flush();
+
+    for (Statements::size_type n = 1; n < statements.size(); ++n)
+    {
+        try
+        {
+            statements[n].flush();
+        }
+        catch (const tntdb::Error& e)
+        {
+            std::ostringstream msg;
+            msg << "replication failed on " << (n + 1) << ". connection: " << e.what();
+            throw tntdb::Error(msg.str());
+        }
+    }
+
+    transaction.commit();
+    return ret;
+}
+
+void Statement::setStreaming(bool sw)
+{
+    // selects are executed on the first connection only
+    statements.begin()->setStreaming(sw);
+}
+
+bool Statement::isStreaming() const
+{
+    return statements.begin()->isStreaming();
+}
+
 }
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2005 Tommi Maekitalo
+ * Copyright (C) 2026 Tommi Maekitalo
  *
  * This library is free software; you can redistribute it and/or
  * modify it under the terms of the GNU Lesser General Public
@@ -26,30 +26,44 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-#ifndef TNTDB_MYSQL_IMPL_ROWCONTAINER_H
-#define TNTDB_MYSQL_IMPL_ROWCONTAINER_H
-
-#include <tntdb/iface/iresult.h>
-#include <tntdb/iface/irow.h>
-#include <vector>
-#include <memory>
+#include <tntdb/impl/resultschema.h>
+#include <tntdb/error.h>
+#include <atomic>
 
 namespace tntdb
 {
-namespace mysql
+uint64_t ResultSchema::nextId()
 {
-class RowContainer : public IResult
+    static std::atomic<uint64_t> id(0);
+    return ++id;
+}
+
+ResultSchema::ResultSchema(const std::vector<std::string>& names)
+  : _id(nextId())
 {
-    std::vector<std::shared_ptr<IRow>> rows;
+    reserve(names.size());
+    for (const auto& name : names)
+        add(name);
+}
 
-public:
-    void addRow(std::shared_ptr<IRow> row)  { rows.emplace_back(row); }
+void ResultSchema::add(const std::string& name)
+{
+    _index.emplace(name, _names.size());
+    _names.push_back(name);
+}
 
-    Row getRow(size_type tup_num) const;
-    size_type size() const;
-    size_type getFieldCount() const;
-};
+void ResultSchema::reserve(size_type n)
+{
+    _names.reserve(n);
+    _index.reserve(n);
 }
+
+ResultSchema::size_type ResultSchema::getFieldNumber(const std::string& field_name) const
+{
+    auto it = _index.find(field_name);
+    if (it == _index.end())
+        throw FieldNotFound(field_name);
+    return it->second;
 }
 
-#endif // TNTDB_MYSQL_IMPL_ROWCONTAINER_H
+}
@@ -28,6 +28,7 @@
 
 #include <tntdb/bits/row.h>
 #include <tntdb/bits/row_iterator.h>
+#include <tntdb/error.h>
 
 namespace tntdb
 {
@@ -41,4 +42,18 @@ namespace tntdb
     return const_iterator(*this, size());
   }
 
+  IRow::size_type IRow::getFieldNumber(const std::string& field_name) const
+  {
+    for (size_type n = 0; n < size(); ++n)
+      if (getColumnName(n) == field_name)
+        return n;
+
+    throw FieldNotFound(field_name);
+  }
+
+  const ResultSchema* IRow::getSchema() const
+  {
+    return 0;
+  }
+
 }
@@ -45,16 +45,7 @@ namespace tntdb
 
   Value RowImpl::getValueByName(const std::string& field_name) const
   {
-    data_type::const_iterator it;
-
-    for (it = data.begin(); it != data.end(); ++it)
-      if (it->name == field_name)
-        break;
-
-    if (it == data.end())
-      throw FieldNotFound(field_name);
-
-    return it->value;
+    return data[getFieldNumber(field_name)].value;
   }
 
   std::string RowImpl::getColumnName(size_type field_num) const
@@ -62,4 +53,13 @@ namespace tntdb
     return data[field_num].name;
   }
 
+  RowImpl::size_type RowImpl::getFieldNumber(const std::string& field_name) const
+  {
+    for (size_type n = 0; n < data.size(); ++n)
+      if (data[n].name == field_name)
+        return n;
+
+    throw FieldNotFound(field_name);
+  }
+
 }
@@ -45,7 +45,9 @@ namespace tntdb
 namespace sqlite
 {
 Connection::Connection(const char* conninfo)
-  : transactionActive(0)
+  : transactionActive(0),
+    implicitTransaction(false),
+    implicitRollbacks(0)
 {
     log_debug("sqlite3_open(\"" << conninfo << "\")");
     int errcode = ::sqlite3_open(conninfo, &db);
@@ -65,6 +67,15 @@ Connection::~Connection()
 {
     if (db)
     {
+        try
+        {
+            commitImplicitTransaction();
+        }
+        catch (const std::exception& e)
+        {
+            log_error("failed to commit delayed statements: " << e.what());
+        }
+
         log_debug("sqlite3_close(" << db << ")");
         ::sqlite3_close(db);
     }
@@ -73,7 +84,10 @@ Connection::~Connection()
 void Connection::beginTransaction()
 {
     if (transactionActive == 0)
+    {
+        commitImplicitTransaction();
         execute("BEGIN IMMEDIATE TRANSACTION");
+    }
     ++transactionActive;
 }
 
@@ -145,6 +159,34 @@ tntdb::Statement Connection::prepareWithLimit(const std::string& query, const st
     return prepare(q);
 }
 
+void Connection::beginImplicitTransaction()
+{
+    if (transactionActive == 0 && !implicitTransaction)
+    {
+        execute("BEGIN IMMEDIATE TRANSACTION");
+        implicitTransaction = true;
+    }
+}
+
+void Connection::commitImplicitTransaction()
+{
+    if (implicitTransaction)
+    {
+        implicitTransaction = false;
+        execute("COMMIT TRANSACTION");
+    }
+}
+
+void Connection::rollbackImplicitTransaction()
+{
+    if (implicitTransaction)
+    {
+        implicitTransaction = false;
+        ++implicitRollbacks;
+        execute("ROLLBACK TRANSACTION");
+    }
+}
+
 bool Connection::ping()
 {
     return db != 0;
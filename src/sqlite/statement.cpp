@@ -28,8 +28,9 @@
 
 #include <tntdb/sqlite/impl/statement.h>
 #include <tntdb/sqlite/impl/cursor.h>
+#include <tntdb/sqlite/impl/streamresult.h>
 #include <tntdb/sqlite/impl/connection.h>
-#include <tntdb/impl/result.h>
+#include <tntdb/impl/columnarresult.h>
 #include <tntdb/impl/row.h>
 #include <tntdb/impl/value.h>
 #include <tntdb/sqlite/error.h>
@@ -54,12 +55,30 @@ Statement::Statement(Connection& conn, const std::string& query)
 : _stmt(0),
   _conn(conn),
   _query(query),
-  _needReset(false)
+  _needReset(false),
+  _generation(0),
+  _streaming(false),
+  _maxNumDelay(0),
+  _numDelayed(0),
+  _delayedChanges(0),
+  _implicitRollbacks(0)
 {
 }
 
 Statement::~Statement()
 {
+    if (_numDelayed > 0)
+    {
+        try
+        {
+            flush();
+        }
+        catch (const std::exception& e)
+        {
+            log_error("failed to flush delayed statements: " << e.what());
+        }
+    }
+
     if (_stmt)
     {
         log_debug("sqlite3_finalize(" << _stmt << ')');
@@ -120,6 +139,8 @@ void Statement::reset()
             log_debug("sqlite3_reset(" << _stmt << ')');
             int ret = ::sqlite3_reset(_stmt);
 
+            ++_generation;
+
             if (ret != SQLITE_OK)
                 throw Execerror("sqlite3_reset", _stmt, ret);
 
@@ -144,130 +165,220 @@ void Statement::clear()
 
 void Statement::setNull(const std::string& col)
 {
-    int idx = getBindIndex(col);
-    getBindStmt();
-    if (idx != 0)
-    {
-        reset();
-
-        log_debug("sqlite3_bind_null(" << _stmt << ", " << idx << ')');
-        int ret = ::sqlite3_bind_null(_stmt, idx);
-
-        if (ret != SQLITE_OK)
-            throw Execerror("sqlite3_bind_null", _stmt, ret);
-    }
+    setNullAt(getBindIndex(col));
 }
 
 void Statement::setBool(const std::string& col, bool data)
 {
-    setInt(col, data ? 1 : 0);
+    setBoolAt(getBindIndex(col), data);
 }
 
 void Statement::setShort(const std::string& col, short data)
 {
-    setInt(col, data);
+    setShortAt(getBindIndex(col), data);
 }
 
 void Statement::setInt(const std::string& col, int data)
 {
-    int idx = getBindIndex(col);
-    getBindStmt();
-    if (idx != 0)
-    {
-        reset();
-
-        log_debug("sqlite3_bind_int(" << _stmt << ", " << idx << ')');
-        int ret = ::sqlite3_bind_int(_stmt, idx, data);
-
-        if (ret != SQLITE_OK)
-            throw Execerror("sqlite3_bind_int", _stmt, ret);
-    }
+    setIntAt(getBindIndex(col), data);
 }
 
 void Statement::setLong(const std::string& col, long data)
 {
-    int idx = getBindIndex(col);
-    getBindStmt();
-    if (idx != 0)
-    {
-        reset();
+    setLongAt(getBindIndex(col), data);
+}
 
-        log_debug("sqlite3_bind_int64(" << _stmt << ", " << idx << ')');
-        int ret = ::sqlite3_bind_int64(_stmt, idx, data);
+void Statement::setUnsignedShort(const std::string& col, unsigned short data)
+{
+    setUnsignedShortAt(getBindIndex(col), data);
+}
 
-        if (ret != SQLITE_OK)
-            throw Execerror("sqlite3_bind_int", _stmt, ret);
-    }
+void Statement::setUnsigned(const std::string& col, unsigned data)
+{
+    setUnsignedAt(getBindIndex(col), data);
+}
+
+void Statement::setUnsignedLong(const std::string& col, unsigned long data)
+{
+    setUnsignedLongAt(getBindIndex(col), data);
 }
 
 void Statement::setInt32(const std::string& col, int32_t data)
 {
-    setInt(col, data);
+    setInt32At(getBindIndex(col), data);
 }
 
-void Statement::setUnsignedShort(const std::string& col, unsigned short data)
+void Statement::setUnsigned32(const std::string& col, uint32_t data)
+{
+    setUnsigned32At(getBindIndex(col), data);
+}
+
+void Statement::setInt64(const std::string& col, int64_t data)
+{
+    setInt64At(getBindIndex(col), data);
+}
+
+void Statement::setUnsigned64(const std::string& col, uint64_t data)
+{
+    setUnsigned64At(getBindIndex(col), data);
+}
+
+void Statement::setDecimal(const std::string& col, const Decimal& data)
+{
+    setDecimalAt(getBindIndex(col), data);
+}
+
+void Statement::setFloat(const std::string& col, float data)
+{
+    setFloatAt(getBindIndex(col), data);
+}
+
+void Statement::setDouble(const std::string& col, double data)
+{
+    setDoubleAt(getBindIndex(col), data);
+}
+
+void Statement::setChar(const std::string& col, char data)
+{
+    setCharAt(getBindIndex(col), data);
+}
+
+void Statement::setString(const std::string& col, const std::string& data)
+{
+    setStringAt(getBindIndex(col), data);
+}
+
+void Statement::setBlob(const std::string& col, const Blob& data)
+{
+    setBlobAt(getBindIndex(col), data);
+}
+
+void Statement::setDate(const std::string& col, const Date& data)
+{
+    setDateAt(getBindIndex(col), data);
+}
+
+void Statement::setTime(const std::string& col, const Time& data)
+{
+    setTimeAt(getBindIndex(col), data);
+}
+
+void Statement::setDatetime(const std::string& col, const Datetime& data)
+{
+    setDatetimeAt(getBindIndex(col), data);
+}
+
+Statement::size_type Statement::paramIndex(const std::string& col)
+{
+    return getBindIndex(col);
+}
+
+void Statement::setNullAt(size_type idx)
+{
+    reset();
+
+    log_debug("sqlite3_bind_null(" << _stmt << ", " << idx << ')');
+    int ret = ::sqlite3_bind_null(_stmt, idx);
+
+    if (ret != SQLITE_OK)
+        throw Execerror("sqlite3_bind_null", _stmt, ret);
+}
+
+void Statement::setBoolAt(size_type idx, bool data)
+{
+    setIntAt(idx, data ? 1 : 0);
+}
+
+void Statement::setShortAt(size_type idx, short data)
+{
+    setIntAt(idx, data);
+}
+
+void Statement::setIntAt(size_type idx, int data)
+{
+    reset();
+
+    log_debug("sqlite3_bind_int(" << _stmt << ", " << idx << ')');
+    int ret = ::sqlite3_bind_int(_stmt, idx, data);
+
+    if (ret != SQLITE_OK)
+        throw Execerror("sqlite3_bind_int", _stmt, ret);
+}
+
+void Statement::setLongAt(size_type idx, long data)
+{
+    reset();
+
+    log_debug("sqlite3_bind_int64(" << _stmt << ", " << idx << ')');
+    int ret = ::sqlite3_bind_int64(_stmt, idx, data);
+
+    if (ret != SQLITE_OK)
+        throw Execerror("sqlite3_bind_int", _stmt, ret);
+}
+
+void Statement::setInt32At(size_type idx, int32_t data)
+{
+    setIntAt(idx, data);
+}
+
+void Statement::setUnsignedShortAt(size_type idx, unsigned short data)
 {
     if (data > static_cast<unsigned short>(std::numeric_limits<unsigned short>::max()))
     {
         log_warn("possible loss of precision while converting unsigned short " << data
           << " to double");
-        setDouble(col, static_cast<double>(data));
+        setDoubleAt(idx, static_cast<double>(data));
     }
     else
-        setInt(col, static_cast<int>(data));
+        setIntAt(idx, static_cast<int>(data));
 }
 
-void Statement::setUnsigned(const std::string& col, unsigned data)
+void Statement::setUnsignedAt(size_type idx, unsigned data)
 {
     if (data > static_cast<unsigned>(std::numeric_limits<int>::max()))
     {
         log_warn("possible loss of precision while converting unsigned " << data
           << " to double");
-        setDouble(col, static_cast<double>(data));
+        setDoubleAt(idx, static_cast<double>(data));
     }
     else
-        setInt(col, static_cast<int>(data));
+        setIntAt(idx, static_cast<int>(data));
 }
 
-void Statement::setUnsignedLong(const std::string& col, unsigned long data)
+void Statement::setUnsignedLongAt(size_type idx, unsigned long data)
 {
     if (data > static_cast<unsigned long>(std::numeric_limits<long>::max()))
     {
         log_warn("possible loss of precision while converting long unsigned " << data
           << " to double");
-        setDouble(col, static_cast<double>(data));
+        setDoubleAt(idx, static_cast<double>(data));
     }
     else
-        setLong(col, static_cast<long>(data));
+        setLongAt(idx, static_cast<long>(data));
 }
 
-void Statement::setUnsigned32(const std::string& col, uint32_t data)
+void Statement::setUnsigned32At(size_type idx, uint32_t data)
 {
-    setUnsigned(col, data);
+    setUnsignedAt(idx, data);
 }
 
-void Statement::setInt64(const std::string& col, int64_t data)
+void Statement::setInt64At(size_type idx, int64_t data)
 {
-    int idx = getBindIndex(col);
-    getBindStmt();
-    if (idx != 0)
-    {
-        reset();
+    reset();
 
-        log_debug("sqlite3_bind_int64(" << _stmt << ", " << idx << ')');
-        int ret = ::sqlite3_bind_int64(_stmt, idx, data);
+    log_debug("sqlite3_bind_int64(" << _stmt << ", " << idx << ')');
+    int ret = ::sqlite3_bind_int64(_stmt, idx, data);
 
-        if (ret != SQLITE_OK)
-            throw Execerror("sqlite3_bind_int64", _stmt, ret);
-    }
+    if (ret != SQLITE_OK)
+        throw Execerror("sqlite3_bind_int64", _stmt, ret);
 }
 
-void Statement::setUnsigned64(const std::string& col, uint64_t data)
+void Statement::setUnsigned64At(size_type idx, uint64_t data)
 {
-    setInt64(col, (int64_t)data);
+    setInt64At(idx, (int64_t)data);
 }
 
-void Statement::setDecimal(const std::string& col, const Decimal& data)
+void Statement::setDecimalAt(size_type idx, const Decimal& data)
 {
     // SQLite 3.4.1 does not support the SQL decimal or numeric types.
     // So double is used instead, but of course binary floating point can
@@ -279,98 +390,141 @@ void Statement::setDecimal(const std::string& col, const Decimal& data)
     // yet the API documentation talks about returning an int, double
     // or text string.
     double d = data.getDouble();
-    setDouble(col, d);
+    setDoubleAt(idx, d);
 }
 
-void Statement::setFloat(const std::string& col, float data)
+void Statement::setFloatAt(size_type idx, float data)
 {
-    setDouble(col, static_cast<double>(data));
+    setDoubleAt(idx, static_cast<double>(data));
 }
 
-void Statement::setDouble(const std::string& col, double data)
+void Statement::setDoubleAt(size_type idx, double data)
 {
-    int idx = getBindIndex(col);
-    getBindStmt();
-    if (idx != 0)
-    {
-        reset();
+    reset();
 
-        log_debug("sqlite3_bind_double(" << _stmt << ", " << idx << ')');
-        int ret = ::sqlite3_bind_double(_stmt, idx, data);
+    log_debug("sqlite3_bind_double(" << _stmt << ", " << idx << ')');
+    int ret = ::sqlite3_bind_double(_stmt, idx, data);
 
-        if (ret != SQLITE_OK)
-            throw Execerror("sqlite3_bind_double", _stmt, ret);
-    }
+    if (ret != SQLITE_OK)
+        throw Execerror("sqlite3_bind_double", _stmt, ret);
 }
 
-void Statement::setChar(const std::string& col, char data)
+void Statement::setCharAt(size_type idx, char data)
 {
-    int idx = getBindIndex(col);
-    getBindStmt();
-    if (idx != 0)
-    {
-        reset();
+    reset();
 
-        log_debug("sqlite3_bind_text(" << _stmt << ", " << idx << ", " << data
-          << ", 1, SQLITE_TRANSIENT)");
-        int ret = ::sqlite3_bind_text(_stmt, idx, &data, 1, SQLITE_TRANSIENT);
+    log_debug("sqlite3_bind_text(" << _stmt << ", " << idx << ", " << data
+      << ", 1, SQLITE_TRANSIENT)");
+    int ret = ::sqlite3_bind_text(_stmt, idx, &data, 1, SQLITE_TRANSIENT);
 
-        if (ret != SQLITE_OK)
-            throw Execerror("sqlite3_bind_text", _stmt, ret);
-    }
+    if (ret != SQLITE_OK)
+        throw Execerror("sqlite3_bind_text", _stmt, ret);
 }
 
-void Statement::setString(const std::string& col, const std::string& data)
+void Statement::setStringAt(size_type idx, const std::string& data)
 {
-    int idx = getBindIndex(col);
-    getBindStmt();
-    if (idx != 0)
-    {
-        reset();
+    reset();
 
-        log_debug("sqlite3_bind_text(" << _stmt << ", " << idx << ", " << data
-          << ", " << data.size() << ", SQLITE_TRANSIENT)");
-        int ret = ::sqlite3_bind_text(_stmt, idx, data.data(), data.size(), SQLITE_TRANSIENT);
+    log_debug("sqlite3_bind_text(" << _stmt << ", " << idx << ", " << data
+      << ", " << data.size() << ", SQLITE_TRANSIENT)");
+    int ret = ::sqlite3_bind_text(_stmt, idx, data.data(), data.size(), SQLITE_TRANSIENT);
 
-        if (ret != SQLITE_OK)
-            throw Execerror("sqlite3_bind_text", _stmt, ret);
-    }
+    if (ret != SQLITE_OK)
+        throw Execerror("sqlite3_bind_text", _stmt, ret);
 }
 
-void Statement::setBlob(const std::string& col, const Blob& data)
+void Statement::setBlobAt(size_type idx, const Blob& data)
 {
-    int idx = getBindIndex(col);
-    getBindStmt();
-    if (idx != 0)
-    {
-        reset();
+    reset();
 
-        log_debug("sqlite3_bind_blob(" << _stmt << ", " << idx << ", data, "
-            << data.size() << ", SQLITE_TRANSIENT)");
-        int ret = ::sqlite3_bind_blob(_stmt, idx, data.data(), data.size(), SQLITE_TRANSIENT);
+    log_debug("sqlite3_bind_blob(" << _stmt << ", " << idx << ", data, "
+        << data.size() << ", SQLITE_TRANSIENT)");
+    int ret = ::sqlite3_bind_blob(_stmt, idx, data.data(), data.size(), SQLITE_TRANSIENT);
 
-        if (ret != SQLITE_OK)
-            throw Execerror("sqlite3_bind_blob", _stmt, ret);
-    }
+    if (ret != SQLITE_OK)
+        throw Execerror("sqlite3_bind_blob", _stmt, ret);
 }
 
-void Statement::setDate(const std::string& col, const Date& data)
+void Statement::setStringRef(const std::string& col, const char* data, std::size_t length)
 {
-    setString(col, data.getIso());
+    setStringRefAt(getBindIndex(col), data, length);
 }
 
-void Statement::setTime(const std::string& col, const Time& data)
+void Statement::setBlobRef(const std::string& col, const char* data, std::size_t length)
 {
-    setString(col, data.getIso());
+    setBlobRefAt(getBindIndex(col), data, length);
 }
 
-void Statement::setDatetime(const std::string& col, const Datetime& data)
+void Statement::takeString(const std::string& col, std::string&& data)
+{
+    takeStringAt(getBindIndex(col), std::move(data));
+}
+
+void Statement::setStringRefAt(size_type idx, const char* data, std::size_t length)
+{
+    reset();
+
+    log_debug("sqlite3_bind_text(" << _stmt << ", " << idx << ", data, "
+        << length << ", SQLITE_STATIC)");
+    int ret = ::sqlite3_bind_text(_stmt, idx, data, length, SQLITE_STATIC);
+
+    if (ret != SQLITE_OK)
+        throw Execerror("sqlite3_bind_text", _stmt, ret);
+}
+
+void Statement::setBlobRefAt(size_type idx, const char* data, std::size_t length)
+{
+    reset();
+
+    log_debug("sqlite3_bind_blob(" << _stmt << ", " << idx << ", data, "
+        << length << ", SQLITE_STATIC)");
+    int ret = ::sqlite3_bind_blob(_stmt, idx, data, length, SQLITE_STATIC);
+
+    if (ret != SQLITE_OK)
+        throw Execerror("sqlite3_bind_blob", _stmt, ret);
+}
+
+void Statement::takeStringAt(size_type idx, std::string&& data)
+{
+    // the string is kept until the parameter is set to another taken string
+    // or the statement is destroyed, so sqlite may reference it; the vector
+    // is sized once, since short strings move with their element
+    if (_strings.empty())
+        _strings.resize(::sqlite3_bind_parameter_count(getBindStmt()));
+    _strings[idx - 1].swap(data);
+
+    const std::string& value = _strings[idx - 1];
+    setStringRefAt(idx, value.data(), value.size());
+}
+
+void Statement::setDateAt(size_type idx, const Date& data)
+{
+    setStringAt(idx, data.getIso());
+}
+
+void Statement::setTimeAt(size_type idx, const Time& data)
 {
-    setString(col, data.getIso());
+    setStringAt(idx, data.getIso());
+}
+
+void Statement::setDatetimeAt(size_type idx, const Datetime& data)
+{
+    setStringAt(idx, data.getIso());
 }
 
 Statement::size_type Statement::execute()
 {
+    // Sqlite has no round trips to save, but committing each statement
+    // costs a sync to disk. So delayed statements are stepped immediately
+    // and committed together.
+    if (_maxNumDelay > 0)
+    {
+        discardRolledBack();
+        _conn.beginImplicitTransaction();
+        if (_numDelayed == 0)
+            _implicitRollbacks = _conn.getImplicitRollbacks();
+    }
+
     reset();
     _needReset = true;
 
@@ -380,22 +534,131 @@ Statement::size_type Statement::execute()
     if (ret != SQLITE_DONE && ret != SQLITE_ROW)
     {
         log_debug("sqlite3_step failed with return code " << ret);
-        throw Execerror("sqlite3_step", _stmt, ret);
+        Execerror e("sqlite3_step", _stmt, ret);
+
+        // sqlite3_reset reports the error of the step again
+        ::sqlite3_reset(_stmt);
+        ++_generation;
+        _needReset = false;
+
+        // like the other drivers, discard the failed batch instead of
+        // committing the rows stepped before
+        if (_maxNumDelay > 0)
+        {
+            _numDelayed = 0;
+            _delayedChanges = 0;
+            try
+            {
+                _conn.rollbackImplicitTransaction();
+            }
+            catch (const std::exception& ex)
+            {
+                log_warn("failed to roll back delayed statements: " << ex.what());
+            }
+        }
+
+        throw e;
     }
 
     int n = ::sqlite3_changes(::sqlite3_db_handle(_stmt));
 
     reset();
 
+    if (_maxNumDelay > 0)
+    {
+        _delayedChanges += n;
+        if (++_numDelayed >= _maxNumDelay)
+            return flush();
+        return 0;
+    }
+
+    return n;
+}
+
+void Statement::maxNumDelay(size_type n)
+{
+    _maxNumDelay = n;
+    if (_numDelayed >= _maxNumDelay)
+        flush();
+}
+
+Statement::size_type Statement::numDelayed() const
+{
+    return _numDelayed;
+}
+
+// The rows are lost, when another statement has rolled back the implicit
+// transaction.
+void Statement::discardRolledBack()
+{
+    if (_numDelayed > 0 && _implicitRollbacks != _conn.getImplicitRollbacks())
+    {
+        log_warn(_numDelayed << " delayed statements were rolled back");
+        _numDelayed = 0;
+        _delayedChanges = 0;
+    }
+}
+
+Statement::size_type Statement::flush()
+{
+    discardRolledBack();
+
+    if (_numDelayed == 0)
+        return 0;
+
+    log_debug("flush " << _numDelayed << " delayed statements");
+
+    size_type n = _delayedChanges;
+    _numDelayed = 0;
+    _delayedChanges = 0;
+
+    _conn.commitImplicitTransaction();
+
     return n;
 }
 
+std::shared_ptr<const ResultSchema> Statement::readSchema()
+{
+    log_debug("sqlite3_column_count(" << _stmt << ')');
+    int count = ::sqlite3_column_count(_stmt);
+
+    std::shared_ptr<ResultSchema> schema = std::make_shared<ResultSchema>();
+    schema->reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        log_debug("sqlite3_column_name(" << _stmt << ", " << i << ')');
+        const char* name = sqlite3_column_name(_stmt, i);
+        if (name == 0)
+            throw std::bad_alloc();
+        schema->add(name);
+    }
+
+    return schema;
+}
+
+void Statement::setStreaming(bool sw)
+{
+    _streaming = sw;
+}
+
+bool Statement::isStreaming() const
+{
+    return _streaming;
+}
+
 Result Statement::select()
 {
     reset();
     _needReset = true;
 
-    std::shared_ptr<ResultImpl> result = std::make_shared<ResultImpl>();
+    if (_streaming)
+    {
+        log_debug("streaming result of statement " << _stmt);
+        return Result(std::make_shared<StreamResult>(shared_from_this()));
+    }
+
+    std::shared_ptr<ColumnarResult> result = std::make_shared<ColumnarResult>(readSchema());
+    int count = result->getFieldCount();
     int ret;
     do
     {
@@ -404,9 +667,6 @@ Result Statement::select()
 
         if (ret == SQLITE_ROW)
         {
-            log_debug("sqlite3_column_count(" << _stmt << ')');
-            int count = ::sqlite3_column_count(_stmt);
-            std::shared_ptr<RowImpl> row = std::make_shared<RowImpl>();
             for (int i = 0; i < count; ++i)
             {
                 log_debug("sqlite3_column_bytes(" << _stmt << ", " << i << ')');
@@ -420,20 +680,11 @@ Result Statement::select()
                     txt = sqlite3_column_blob(_stmt, i);
                 }
 
-                std::shared_ptr<ValueImpl> v;
                 if (txt)
-                    v = std::make_shared<ValueImpl>(
-                    std::string(static_cast<const char*>(txt), n));
-
-                log_debug("sqlite3_column_name(" << _stmt << ", " << i << ')');
-                const char* name = sqlite3_column_name(_stmt, i);
-                if (name == 0)
-                    throw std::bad_alloc();
-
-                row->add(name, Value(v));
+                    result->add(i, static_cast<const char*>(txt), n);
+                else
+                    result->addNull(i);
             }
-
-            result->add(Row(row));
         }
         else if (ret != SQLITE_DONE)
         {
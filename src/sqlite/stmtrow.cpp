@@ -46,6 +46,8 @@ Value StmtRow::getValueByNumber(size_type field_num) const
 
 Value StmtRow::getValueByName(const std::string& field_name) const
 {
+    if (schema)
+        return Value(std::make_shared<StmtValue>(stmt, schema->getFieldNumber(field_name)));
     return Value(std::make_shared<StmtValue>(stmt, field_name));
 }
 
@@ -57,5 +59,12 @@ std::string StmtRow::getColumnName(size_type field_num) const
     return name;
 }
 
+StmtRow::size_type StmtRow::getFieldNumber(const std::string& field_name) const
+{
+    if (schema)
+        return schema->getFieldNumber(field_name);
+    return IRow::getFieldNumber(field_name);
+}
+
 }
 }
@@ -200,6 +200,31 @@ namespace tntdb
       }
     }
 
+    const char* StmtValue::getStringData(std::size_t& length) const
+    {
+      if (isNull())
+        throw NullValue();
+
+      log_debug("sqlite3_column_blob(" << getStmt() << ", " << iCol << ')');
+      const void* data = ::sqlite3_column_blob(getStmt(), iCol);
+      log_debug("sqlite3_column_bytes(" << getStmt() << ", " << iCol << ')');
+      int bytes = ::sqlite3_column_bytes(getStmt(), iCol);
+
+      if (data == 0 || bytes <= 0)
+      {
+        length = 0;
+        return "";
+      }
+
+      length = bytes;
+      return static_cast<const char*>(data);
+    }
+
+    const char* StmtValue::getBlobData(std::size_t& length) const
+    {
+      return getStringData(length);
+    }
+
     Date StmtValue::getDate() const
     {
       std::string str = getString();
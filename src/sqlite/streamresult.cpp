@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/sqlite/impl/streamresult.h>
+#include <tntdb/sqlite/impl/statement.h>
+#include <tntdb/sqlite/error.h>
+#include <tntdb/impl/value.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/error.h>
+#include <stdexcept>
+#include <cxxtools/log.h>
+
+log_define("tntdb.sqlite.streamresult")
+
+namespace tntdb
+{
+namespace sqlite
+{
+StreamResult::StreamResult(const std::shared_ptr<Statement>& statement)
+  : _statement(statement),
+    _stmt(statement->_stmt),
+    _generation(statement->_generation),
+    _schema(statement->readSchema()),
+    _pos(0),
+    _eof(false),
+    _sizeKnown(false),
+    _size(0)
+{
+}
+
+StreamResult::~StreamResult()
+{
+    // release the statement, so that sqlite can release its locks
+    if (_statement->_generation == _generation)
+    {
+        try
+        {
+            _statement->reset();
+        }
+        catch (const std::exception& e)
+        {
+            log_warn("failed to reset statement: " << e.what());
+        }
+    }
+}
+
+void StreamResult::checkStatement() const
+{
+    if (_statement->_generation != _generation)
+        throw Error("streaming result is invalid since the statement was used again");
+}
+
+bool StreamResult::step() const
+{
+    checkStatement();
+
+    log_debug("sqlite3_step(" << _stmt << ')');
+    int ret = ::sqlite3_step(_stmt);
+
+    if (ret == SQLITE_ROW)
+    {
+        ++_pos;
+        return true;
+    }
+
+    if (ret != SQLITE_DONE)
+    {
+        log_debug("sqlite3_step failed with return code " << ret);
+        throw Execerror("sqlite3_step", _stmt, ret);
+    }
+
+    _eof = true;
+    _sizeKnown = true;
+    _size = _pos;
+    return false;
+}
+
+void StreamResult::rewind() const
+{
+    checkStatement();
+
+    log_debug("sqlite3_reset(" << _stmt << ')');
+    int ret = ::sqlite3_reset(_stmt);
+    if (ret != SQLITE_OK)
+        throw Execerror("sqlite3_reset", _stmt, ret);
+
+    _pos = 0;
+    _eof = false;
+}
+
+void StreamResult::moveTo(size_type tup_num) const
+{
+    if (_sizeKnown && tup_num >= _size)
+        throw std::out_of_range("row number out of range");
+
+    if (_eof || _pos > tup_num + 1)
+    {
+        log_debug("rewind streaming result to row " << tup_num);
+        rewind();
+    }
+
+    while (_pos <= tup_num)
+        if (!step())
+            throw std::out_of_range("row number out of range");
+}
+
+Row StreamResult::getRow(size_type tup_num) const
+{
+    if (_sizeKnown && tup_num >= _size)
+        throw std::out_of_range("row number out of range");
+
+    return Row(std::make_shared<StreamRow>(shared_from_this(), tup_num));
+}
+
+StreamResult::size_type StreamResult::size() const
+{
+    // the rows are counted by stepping to the end; they are stepped again
+    // when they are accessed later
+    while (!_sizeKnown)
+        step();
+
+    return _size;
+}
+
+StreamResult::size_type StreamResult::getFieldCount() const
+{
+    return _schema->size();
+}
+
+Value StreamResult::getValue(size_type tup_num, size_type field_num) const
+{
+    moveTo(tup_num);
+
+    log_debug("sqlite3_column_bytes(" << _stmt << ", " << field_num << ')');
+    int n = ::sqlite3_column_bytes(_stmt, field_num);
+
+    const void* txt = 0;
+
+    if (n > 0)
+    {
+        log_debug("sqlite3_column_blob(" << _stmt << ", " << field_num << ')');
+        txt = ::sqlite3_column_blob(_stmt, field_num);
+    }
+
+    std::shared_ptr<ValueImpl> v;
+    if (txt)
+        v = std::make_shared<ValueImpl>(
+            std::string(static_cast<const char*>(txt), n));
+
+    return Value(v);
+}
+
+StreamRow::size_type StreamRow::size() const
+{
+    return _result->getFieldCount();
+}
+
+Value StreamRow::getValueByNumber(size_type field_num) const
+{
+    return _result->getValue(_tupNum, field_num);
+}
+
+Value StreamRow::getValueByName(const std::string& field_name) const
+{
+    return _result->getValue(_tupNum, _result->getSchema().getFieldNumber(field_name));
+}
+
+std::string StreamRow::getColumnName(size_type field_num) const
+{
+    return _result->getSchema().getName(field_num);
+}
+
+StreamRow::size_type StreamRow::getFieldNumber(const std::string& field_name) const
+{
+    return _result->getSchema().getFieldNumber(field_name);
+}
+
+const ResultSchema* StreamRow::getSchema() const
+{
+    return &_result->getSchema();
+}
+
+}
+}
@@ -31,6 +31,8 @@
 #include <tntdb/result.h>
 #include <tntdb/row.h>
 #include <tntdb/value.h>
+#include <tntdb/error.h>
+#include <tntdb/blob.h>
 #include <cxxtools/utf8codec.h>
 #include <cxxtools/log.h>
 
@@ -83,11 +85,189 @@ Statement::size_type Statement::flush()
     return _stmt->flush();
 }
 
+void Statement::setStreaming(bool sw)
+{
+    _stmt->setStreaming(sw);
+}
+
+bool Statement::isStreaming() const
+{
+    return _stmt->isStreaming();
+}
+
+void Statement::setFetchSize(unsigned n)
+{
+    _stmt->setFetchSize(n);
+}
+
+unsigned Statement::getFetchSize() const
+{
+    return _stmt->getFetchSize();
+}
+
+Param Statement::param(const std::string& col) const
+{
+    return Param(col, _stmt->paramIndex(col));
+}
+
 void IStatement::setUString(const std::string& col, const cxxtools::String& data)
 {
     setString(col, cxxtools::Utf8Codec::encode(data));
 }
 
+Statement::size_type IStatement::paramIndex(const std::string& /*col*/)
+{
+    return noParam;
+}
+
+namespace
+{
+    void noParamIndex()
+    {
+        throw Error("host variables can't be set by number in this driver");
+    }
+}
+
+void IStatement::setNullAt(size_type /*idx*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setBoolAt(size_type /*idx*/, bool /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setShortAt(size_type /*idx*/, short /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setIntAt(size_type /*idx*/, int /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setLongAt(size_type /*idx*/, long /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setUnsignedShortAt(size_type /*idx*/, unsigned short /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setUnsignedAt(size_type /*idx*/, unsigned /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setUnsignedLongAt(size_type /*idx*/, unsigned long /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setInt32At(size_type /*idx*/, int32_t /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setUnsigned32At(size_type /*idx*/, uint32_t /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setInt64At(size_type /*idx*/, int64_t /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setUnsigned64At(size_type /*idx*/, uint64_t /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setDecimalAt(size_type /*idx*/, const Decimal& /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setFloatAt(size_type /*idx*/, float /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setDoubleAt(size_type /*idx*/, double /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setCharAt(size_type /*idx*/, char /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setStringAt(size_type /*idx*/, const std::string& /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setBlobAt(size_type /*idx*/, const Blob& /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setDateAt(size_type /*idx*/, const Date& /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setTimeAt(size_type /*idx*/, const Time& /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setDatetimeAt(size_type /*idx*/, const Datetime& /*data*/)
+{
+    noParamIndex();
+}
+
+void IStatement::setUStringAt(size_type idx, const cxxtools::String& data)
+{
+    setStringAt(idx, cxxtools::Utf8Codec::encode(data));
+}
+
+void IStatement::setStringRef(const std::string& col, const char* data, std::size_t length)
+{
+    setString(col, std::string(data, length));
+}
+
+void IStatement::setBlobRef(const std::string& col, const char* data, std::size_t length)
+{
+    setBlob(col, Blob(data, length));
+}
+
+void IStatement::setStringRefAt(size_type idx, const char* data, std::size_t length)
+{
+    setStringAt(idx, std::string(data, length));
+}
+
+void IStatement::setBlobRefAt(size_type idx, const char* data, std::size_t length)
+{
+    setBlobAt(idx, Blob(data, length));
+}
+
+void IStatement::takeString(const std::string& col, std::string&& data)
+{
+    setString(col, data);
+}
+
+void IStatement::takeStringAt(size_type idx, std::string&& data)
+{
+    setStringAt(idx, data);
+}
+
 void IStatement::maxNumDelay(unsigned /*n*/)
 {
 }
@@ -102,5 +282,23 @@ Statement::size_type IStatement::flush()
     return 0;
 }
 
+void IStatement::setStreaming(bool /*sw*/)
+{
+}
+
+bool IStatement::isStreaming() const
+{
+    return false;
+}
+
+void IStatement::setFetchSize(unsigned /*n*/)
+{
+}
+
+unsigned IStatement::getFetchSize() const
+{
+    return 0;
+}
+
 }
 
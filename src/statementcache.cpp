@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/statementcache.h>
+#include <cxxtools/log.h>
+#include <iterator>
+
+log_define("tntdb.statementcache")
+
+namespace tntdb
+{
+const unsigned StatementCache::defaultMaxSize;
+
+void StatementCache::evict(EntriesType::iterator it)
+{
+    log_debug("evict statement \"" << it->key << '"');
+    _index.erase(it->key);
+    _entries.erase(it);
+    ++_statistics.evictions;
+}
+
+void StatementCache::shrink(Clock::time_point now)
+{
+    while (!_entries.empty()
+        && ((_maxSize > 0 && _entries.size() > _maxSize)
+            || expired(_entries.back(), now)))
+        evict(std::prev(_entries.end()));
+}
+
+Statement StatementCache::get(const std::string& key)
+{
+    auto it = _index.find(key);
+    if (it == _index.end())
+    {
+        ++_statistics.misses;
+        return Statement();
+    }
+
+    auto now = Clock::now();
+    if (expired(*it->second, now))
+    {
+        evict(it->second);
+        ++_statistics.misses;
+        return Statement();
+    }
+
+    it->second->lastUsed = now;
+    _entries.splice(_entries.begin(), _entries, it->second);
+    ++_statistics.hits;
+    return it->second->stmt;
+}
+
+void StatementCache::put(const std::string& key, const Statement& stmt)
+{
+    auto now = Clock::now();
+
+    auto it = _index.find(key);
+    if (it != _index.end())
+    {
+        it->second->stmt = stmt;
+        it->second->lastUsed = now;
+        it->second->fetchSize = stmt.getFetchSize();
+        _entries.splice(_entries.begin(), _entries, it->second);
+    }
+    else
+    {
+        _entries.emplace_front(key, stmt, now);
+        _index.emplace(key, _entries.begin());
+    }
+
+    shrink(now);
+}
+
+bool StatementCache::erase(const std::string& key)
+{
+    auto it = _index.find(key);
+    if (it == _index.end())
+        return false;
+
+    _entries.erase(it->second);
+    _index.erase(it);
+    return true;
+}
+
+void StatementCache::clear()
+{
+    _index.clear();
+    _entries.clear();
+}
+
+void StatementCache::reset()
+{
+    for (auto& entry : _entries)
+    {
+        // maxNumDelay flushes the pending rows
+        entry.stmt.maxNumDelay(0);
+        entry.stmt.setStreaming(false);
+        entry.stmt.setFetchSize(entry.fetchSize);
+        entry.stmt.clear();
+    }
+}
+
+void StatementCache::setMaxSize(unsigned n)
+{
+    _maxSize = n;
+    shrink(Clock::now());
+}
+
+void StatementCache::setMaxAge(Duration d)
+{
+    _maxAge = d;
+    shrink(Clock::now());
+}
+
+}
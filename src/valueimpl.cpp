@@ -209,6 +209,19 @@ Datetime ValueImpl::getDatetime() const
     return Datetime::fromIso(data);
 }
 
+const char* ValueImpl::getStringData(std::size_t& length) const
+{
+    if (null)
+        throw NullValue();
+    length = data.size();
+    return data.data();
+}
+
+const char* ValueImpl::getBlobData(std::size_t& length) const
+{
+    return getStringData(length);
+}
+
 void IValue::getUString(cxxtools::String& ret) const
 {
     std::string r;
@@ -216,4 +229,14 @@ void IValue::getUString(cxxtools::String& ret) const
     ret = cxxtools::Utf8Codec::decode(r);
 }
 
+const char* IValue::getStringData(std::size_t& /*length*/) const
+{
+    throw TypeError("value can't be accessed without conversion");
+}
+
+const char* IValue::getBlobData(std::size_t& /*length*/) const
+{
+    throw TypeError("value can't be accessed without conversion");
+}
+
 }
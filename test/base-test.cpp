@@ -35,6 +35,7 @@
 #include <tntdb/statement.h>
 #include <tntdb/row.h>
 #include <tntdb/value.h>
+#include <vector>
 
 log_define("tntdb.unit.base")
 
@@ -60,6 +61,7 @@ public:
         registerMethod("testTransaction", *this, &TntdbBaseTest::testTransaction);
         registerMethod("testLimit", *this, &TntdbBaseTest::testLimit);
         registerMethod("testLimitOffset", *this, &TntdbBaseTest::testLimitOffset);
+        registerMethod("testCursorPages", *this, &TntdbBaseTest::testCursorPages);
     }
 
     void testSelectValue()
@@ -452,6 +454,35 @@ public:
 
     }
 
+    void testCursorPages()
+    {
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:intcol)");
+        for (int n = 0; n < 10; ++n)
+            ins.set("intcol", n).execute();
+
+        tntdb::Statement stmt = conn.prepareWithLimit("select intcol from tntdbtest order by 1", "l", "o");
+
+        // the statement is iterated once per page; the first page is left early
+        std::vector<int> values;
+        for (int offset = 0; offset < 10; offset += 3)
+        {
+            stmt.set("l", 3)
+                .set("o", offset);
+
+            for (tntdb::Statement::const_iterator cur = stmt.begin(); cur != stmt.end(); ++cur)
+            {
+                values.push_back((*cur)[0].getInt());
+                if (offset == 0)
+                    break;
+            }
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(values.size(), 8);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(values[0], 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(values[1], 3);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(values[7], 9);
+    }
+
 };
 
 cxxtools::unit::RegisterTest<TntdbBaseTest> register_TntdbBaseTest;
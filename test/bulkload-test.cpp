@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/statement.h>
+#include <tntdb/result.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/blob.h>
+#include <tntdb/error.h>
+
+log_define("tntdb.unit.bulkload")
+
+class TntdbBulkLoadTest : public TntdbTestBase
+{
+    unsigned count()
+    {
+        return conn.selectValue("select count(*) from tntdbtest").getUnsigned();
+    }
+
+    static std::vector<std::string> columns()
+    {
+        std::vector<std::string> ret;
+        ret.push_back("intcol");
+        ret.push_back("doublecol");
+        ret.push_back("stringcol");
+        ret.push_back("blobcol");
+        return ret;
+    }
+
+public:
+    TntdbBulkLoadTest()
+      : TntdbTestBase("bulkload")
+    {
+        registerMethod("testLoad", *this, &TntdbBulkLoadTest::testLoad);
+        registerMethod("testValues", *this, &TntdbBulkLoadTest::testValues);
+        registerMethod("testMaxNumDelay", *this, &TntdbBulkLoadTest::testMaxNumDelay);
+        registerMethod("testDestructor", *this, &TntdbBulkLoadTest::testDestructor);
+        registerMethod("testQuotedColumn", *this, &TntdbBulkLoadTest::testQuotedColumn);
+    }
+
+    void testLoad()
+    {
+        tntdb::Statement load = conn.prepareBulkLoad("tntdbtest", columns());
+
+        for (int n = 0; n < 100; ++n)
+            load.set("intcol", n)
+                .set("doublecol", n * 0.5)
+                .set("stringcol", "row")
+                .setNull("blobcol")
+                .execute();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(load.flush(), 100);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 100);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(conn.selectValue("select sum(intcol) from tntdbtest").getInt(), 4950);
+    }
+
+    void testValues()
+    {
+        static const char blobdata[] = "a\0b\\c\td\ne";
+        tntdb::Blob blob(blobdata, sizeof(blobdata) - 1);
+
+        tntdb::Statement load = conn.prepareBulkLoad("tntdbtest", columns());
+        load.set("intcol", -17)
+            .set("doublecol", 1.25)
+            .set("stringcol", "tab\tnewline\nbackslash\\")
+            .set("blobcol", blob)
+            .execute();
+        load.setNull("intcol")
+            .setNull("doublecol")
+            .setNull("stringcol")
+            .setNull("blobcol")
+            .execute();
+        load.flush();
+
+        tntdb::Result r = conn.select("select intcol, doublecol, stringcol, blobcol from tntdbtest order by id");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.size(), 2);
+
+        tntdb::Row row = r.getRow(0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row[0].getInt(), -17);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row[1].getDouble(), 1.25);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row[2].getString(), "tab\tnewline\nbackslash\\");
+        CXXTOOLS_UNIT_ASSERT(row[3].getBlob() == blob);
+
+        row = r.getRow(1);
+        CXXTOOLS_UNIT_ASSERT(row[0].isNull());
+        CXXTOOLS_UNIT_ASSERT(row[1].isNull());
+        CXXTOOLS_UNIT_ASSERT(row[2].isNull());
+        CXXTOOLS_UNIT_ASSERT(row[3].isNull());
+    }
+
+    void testMaxNumDelay()
+    {
+        tntdb::Statement load = conn.prepareBulkLoad("tntdbtest", columns());
+        load.maxNumDelay(10);
+
+        for (int n = 0; n < 25; ++n)
+            load.set("intcol", n).execute();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(load.numDelayed(), 5);
+
+        load.flush();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(load.numDelayed(), 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 25);
+    }
+
+    void testDestructor()
+    {
+        {
+            tntdb::Statement load = conn.prepareBulkLoad("tntdbtest", columns());
+            for (int n = 0; n < 3; ++n)
+                load.set("intcol", n).execute();
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 3);
+    }
+
+    void testQuotedColumn()
+    {
+        // column names are not necessarily valid host variable names
+        std::string col = dburl().compare(0, 6, "mysql:") == 0 ? "`intcol`" : "\"intcol\"";
+        std::vector<std::string> cols;
+        cols.push_back(col);
+
+        tntdb::Statement load = conn.prepareBulkLoad("tntdbtest", cols);
+        load.set(col, 1).execute();
+        load.set(col, 2).execute();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(load.flush(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(conn.selectValue("select sum(intcol) from tntdbtest").getInt(), 3);
+    }
+};
+
+cxxtools::unit::RegisterTest<TntdbBulkLoadTest> register_TntdbBulkLoadTest;
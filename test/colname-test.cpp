@@ -33,6 +33,10 @@
 #include <stdlib.h>
 #include <tntdb/statement.h>
 #include <tntdb/row.h>
+#include <tntdb/result.h>
+#include <tntdb/value.h>
+#include <tntdb/error.h>
+#include <tntdb/columnindex.h>
 #include <limits>
 
 log_define("tntdb.unit.colname")
@@ -44,6 +48,8 @@ public:
       : TntdbTestBase("colname")
     {
         registerMethod("testColname", *this, &TntdbColnameTest::testColname);
+        registerMethod("testGetByName", *this, &TntdbColnameTest::testGetByName);
+        registerMethod("testColumnIndex", *this, &TntdbColnameTest::testColumnIndex);
     }
 
     void testColname()
@@ -56,6 +62,40 @@ public:
         CXXTOOLS_UNIT_ASSERT_EQUALS(row.getName(1), "foo");
     }
 
+    void testGetByName()
+    {
+        conn.execute("insert into tntdbtest(intcol, stringcol) values(4718, 'bar')");
+
+        tntdb::Row row = conn.selectRow("select intcol, stringcol, intcol as foo from tntdbtest");
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row["foo"].getInt(), 4718);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row["stringcol"].getString(), "bar");
+        CXXTOOLS_UNIT_ASSERT_THROW(row["unknown"], tntdb::FieldNotFound);
+    }
+
+    void testColumnIndex()
+    {
+        conn.execute("insert into tntdbtest(intcol, stringcol) values(1, 'a')");
+        conn.execute("insert into tntdbtest(intcol, stringcol) values(2, 'b')");
+
+        tntdb::ColumnIndex intcol("intcol");
+        tntdb::ColumnIndex stringcol("stringcol");
+
+        tntdb::Result result = conn.select("select stringcol, intcol from tntdbtest order by intcol");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result.size(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result[0][intcol].getInt(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result[1][intcol].getInt(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result[1][stringcol].getString(), "b");
+
+        // the index is resolved again for a result with a different layout
+        tntdb::Row row = conn.selectRow("select intcol, stringcol from tntdbtest where intcol = 2");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row[intcol].getInt(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row[stringcol].getString(), "b");
+
+        tntdb::ColumnIndex unknown("unknown");
+        CXXTOOLS_UNIT_ASSERT_THROW(row[unknown], tntdb::FieldNotFound);
+    }
+
 };
 
 cxxtools::unit::RegisterTest<TntdbColnameTest> register_TntdbColnameTest;
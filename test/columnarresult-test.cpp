@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cxxtools/unit/testsuite.h>
+#include <cxxtools/unit/registertest.h>
+#include <tntdb/impl/columnarresult.h>
+#include <tntdb/result.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/error.h>
+
+class TntdbColumnarResultTest : public cxxtools::unit::TestSuite
+{
+    static tntdb::Result createResult()
+    {
+        std::shared_ptr<tntdb::ResultSchema> schema = std::make_shared<tntdb::ResultSchema>();
+        schema->add("id");
+        schema->add("name");
+
+        std::shared_ptr<tntdb::ColumnarResult> result = std::make_shared<tntdb::ColumnarResult>(schema);
+
+        result->add(0, "1", 1);
+        result->add(1, "foo", 3);
+
+        result->add(0, "2", 1);
+        result->addNull(1);
+
+        result->add(0, "3", 1);
+        result->add(1, "barbaz", 6);
+
+        return tntdb::Result(result);
+    }
+
+public:
+    TntdbColumnarResultTest()
+      : cxxtools::unit::TestSuite("columnarresult")
+    {
+        registerMethod("testValues", *this, &TntdbColumnarResultTest::testValues);
+        registerMethod("testNull", *this, &TntdbColumnarResultTest::testNull);
+        registerMethod("testNames", *this, &TntdbColumnarResultTest::testNames);
+        registerMethod("testLifetime", *this, &TntdbColumnarResultTest::testLifetime);
+    }
+
+    void testValues()
+    {
+        tntdb::Result result = createResult();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result.size(), 3);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result.getFieldCount(), 2);
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result[0][0].getInt(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result[0][1].getString(), "foo");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result[2][0].getUnsigned(), 3);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result[2][1].getString(), "barbaz");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result[2][1].getChar(), 'b');
+    }
+
+    void testNull()
+    {
+        tntdb::Result result = createResult();
+
+        CXXTOOLS_UNIT_ASSERT(!result[0][1].isNull());
+        CXXTOOLS_UNIT_ASSERT(result[1][1].isNull());
+        CXXTOOLS_UNIT_ASSERT_THROW(result[1][1].getString(), tntdb::NullValue);
+    }
+
+    void testNames()
+    {
+        tntdb::Result result = createResult();
+        tntdb::Row row = result[2];
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row.getName(1), "name");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row["id"].getInt(), 3);
+        CXXTOOLS_UNIT_ASSERT_THROW(row["unknown"], tntdb::FieldNotFound);
+    }
+
+    void testLifetime()
+    {
+        // rows and values keep the result alive
+        tntdb::Value value;
+
+        {
+            tntdb::Row row = createResult()[0];
+            value = row[1];
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(value.getString(), "foo");
+    }
+
+};
+
+cxxtools::unit::RegisterTest<TntdbColumnarResultTest> register_TntdbColumnarResultTest;
@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/connectionpool.h>
+#include <tntdb/connection.h>
+#include <tntdb/statement.h>
+#include <tntdb/value.h>
+#include <tntdb/error.h>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+log_define("tntdb.unit.connectionpool")
+
+class TntdbConnectionPoolTest : public TntdbTestBase
+{
+public:
+    TntdbConnectionPoolTest()
+      : TntdbTestBase("connectionpool")
+    {
+        registerMethod("testReuse", *this, &TntdbConnectionPoolTest::testReuse);
+        registerMethod("testMaxSpare", *this, &TntdbConnectionPoolTest::testMaxSpare);
+        registerMethod("testValidation", *this, &TntdbConnectionPoolTest::testValidation);
+        registerMethod("testValidateAfterError", *this, &TntdbConnectionPoolTest::testValidateAfterError);
+        registerMethod("testMinIdle", *this, &TntdbConnectionPoolTest::testMinIdle);
+        registerMethod("testRetire", *this, &TntdbConnectionPoolTest::testRetire);
+        registerMethod("testMaintenanceThread", *this, &TntdbConnectionPoolTest::testMaintenanceThread);
+        registerMethod("testMaxActive", *this, &TntdbConnectionPoolTest::testMaxActive);
+        registerMethod("testHandOff", *this, &TntdbConnectionPoolTest::testHandOff);
+    }
+
+    void testReuse()
+    {
+        tntdb::ConnectionPool pool(dburl(), dbuser(), dbpassword());
+
+        {
+            tntdb::Connection c = pool.connect();
+            CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 0);
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+
+        {
+            tntdb::Connection c = pool.connect();
+            CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 0);
+            c.selectValue("select count(*) from tntdbtest");
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+
+        pool.drop();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 0);
+    }
+
+    void testMaxSpare()
+    {
+        tntdb::ConnectionPool pool(dburl(), dbuser(), dbpassword(), 2);
+
+        {
+            tntdb::Connection c1 = pool.connect();
+            tntdb::Connection c2 = pool.connect();
+            tntdb::Connection c3 = pool.connect();
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 2);
+
+        pool.setMaxSpare(1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+    }
+
+    void testValidation()
+    {
+        tntdb::ConnectionPool pool(dburl(), dbuser(), dbpassword());
+        pool.setValidationPolicy(tntdb::ConnectionPool::validateIdle, 1000);
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getValidationPolicy(), tntdb::ConnectionPool::validateIdle);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getValidationInterval(), 1000);
+
+        {
+            tntdb::Connection c1 = pool.connect();
+            tntdb::Connection c2 = pool.connect();
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.validate(), 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getActiveCount(), 0);
+
+        pool.setValidationPolicy(tntdb::ConnectionPool::validateNever);
+
+        {
+            tntdb::Connection c = pool.connect();
+            CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 2);
+    }
+
+    void testValidateAfterError()
+    {
+        tntdb::ConnectionPool pool(dburl(), dbuser(), dbpassword());
+        pool.setValidationPolicy(tntdb::ConnectionPool::validateAfterError);
+
+        {
+            tntdb::Connection c = pool.connect();
+            c.prepare("select count(*) from tntdbtest").selectValue();
+        }
+
+        {
+            tntdb::Connection c = pool.connect();
+            tntdb::Statement stmt = c.prepare("select abs(:v)");
+            stmt.set("v", std::numeric_limits<int64_t>::min());
+            CXXTOOLS_UNIT_ASSERT_THROW(stmt.selectValue().getInt64(), tntdb::Error);
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCheckoutValidations(), 0);
+
+        {
+            tntdb::Connection c = pool.connect();
+            CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCheckoutValidations(), 1);
+        }
+
+        {
+            tntdb::Connection c = pool.connect();
+            CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCheckoutValidations(), 1);
+        }
+    }
+
+    void testMinIdle()
+    {
+        tntdb::ConnectionPool pool(dburl(), dbuser(), dbpassword(), 2);
+        pool.setMinIdle(3);
+
+        // limited by max spare
+        pool.maintain();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 2);
+
+        pool.setMaxSpare(0);
+        pool.maintain();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 3);
+
+        {
+            tntdb::Connection c = pool.connect();
+            CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 2);
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 3);
+    }
+
+    void testRetire()
+    {
+        tntdb::ConnectionPool pool(dburl(), dbuser(), dbpassword());
+
+        {
+            tntdb::Connection c1 = pool.connect();
+            tntdb::Connection c2 = pool.connect();
+            tntdb::Connection c3 = pool.connect();
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 3);
+
+        pool.setMinIdle(1);
+        pool.setIdleTimeout(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.maintain(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+
+        // the last connection is retired after max lifetime and replaced by a new one
+        pool.setIdleTimeout(0);
+        pool.setMaxLifetime(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.maintain(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+
+        // connections past max lifetime are not returned to the pool
+        {
+            tntdb::Connection c = pool.connect();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 0);
+    }
+
+    void testMaintenanceThread()
+    {
+        tntdb::ConnectionPools pools;
+        pools.setMinIdle(2);
+        pools.startMaintenance(1000);
+
+        tntdb::Connection conn = pools.connect(dburl(), dbuser(), dbpassword());
+
+        // the pool is refilled in the background
+        for (unsigned n = 0; n < 100 && pools.getCurrentSize() < 2; ++n)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pools.getCurrentSize(), 2);
+
+        pools.stopMaintenance();
+    }
+
+    void testMaxActive()
+    {
+        tntdb::ConnectionPool pool(dburl(), dbuser(), dbpassword());
+        pool.setMaxActive(2);
+        pool.setCheckoutTimeout(10);
+
+        tntdb::Connection c1 = pool.connect();
+        tntdb::Connection c2 = pool.connect();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getActiveCount(), 2);
+
+        CXXTOOLS_UNIT_ASSERT_THROW(pool.connect(), tntdb::PoolTimeout);
+
+        tntdb::ConnectionPool::WaitStatistics st = pool.getWaitStatistics();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(st.checkouts, 3);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(st.waits, 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(st.timeouts, 1);
+
+        // a dropped connection frees its slot
+        c1 = tntdb::Connection();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getActiveCount(), 1);
+        c1 = pool.connect();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getActiveCount(), 2);
+    }
+
+    void testHandOff()
+    {
+        tntdb::ConnectionPool pool(dburl(), dbuser(), dbpassword());
+        pool.setMaxActive(1);
+
+        tntdb::Connection c1 = pool.connect();
+        bool connected = false;
+
+        std::thread waiter([&pool, &connected] () {
+            tntdb::Connection c2 = pool.connect();
+            connected = true;
+        });
+
+        while (pool.getWaitStatistics().checkouts < 2)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        c1 = tntdb::Connection();
+        waiter.join();
+
+        // the connection was handed off and returned to the pool afterwards
+        CXXTOOLS_UNIT_ASSERT(connected);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getActiveCount(), 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getWaitStatistics().waits, 1);
+    }
+
+};
+
+cxxtools::unit::RegisterTest<TntdbConnectionPoolTest> register_TntdbConnectionPoolTest;
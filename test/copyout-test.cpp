@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/statement.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <sstream>
+#include <vector>
+#include <string>
+
+log_define("tntdb.unit.copyout")
+
+class TntdbCopyOutTest : public TntdbTestBase
+{
+    void insertRows()
+    {
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+        ins.set("intcol", 1).set("stringcol", "one").execute();
+        ins.set("intcol", 2).set("stringcol", "tab\tnewline\nbackslash\\").execute();
+        ins.set("intcol", 3).setNull("stringcol").execute();
+    }
+
+public:
+    TntdbCopyOutTest()
+      : TntdbTestBase("copyout")
+    {
+        registerMethod("testStream", *this, &TntdbCopyOutTest::testStream);
+        registerMethod("testRows", *this, &TntdbCopyOutTest::testRows);
+        registerMethod("testEmpty", *this, &TntdbCopyOutTest::testEmpty);
+    }
+
+    void testStream()
+    {
+        insertRows();
+
+        std::ostringstream out;
+        unsigned count = conn.copyOut("select intcol, stringcol from tntdbtest order by intcol", out);
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count, 3);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(out.str(),
+            "1\tone\n"
+            "2\ttab\\tnewline\\nbackslash\\\\\n"
+            "3\t\\N\n");
+    }
+
+    void testRows()
+    {
+        insertRows();
+
+        std::vector<int> ints;
+        std::vector<std::string> strings;
+        unsigned count = conn.copyOutRows("select intcol, stringcol from tntdbtest order by intcol",
+            [&ints, &strings] (const tntdb::Row& row) {
+                ints.push_back(row.getInt("intcol"));
+                strings.push_back(row.isNull("stringcol") ? "<null>" : row.getString("stringcol"));
+            });
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count, 3);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ints.size(), 3);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ints[0], 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(strings[0], "one");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(strings[1], "tab\tnewline\nbackslash\\");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ints[2], 3);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(strings[2], "<null>");
+    }
+
+    void testEmpty()
+    {
+        std::ostringstream out;
+        CXXTOOLS_UNIT_ASSERT_EQUALS(conn.copyOut("select intcol from tntdbtest", out), 0);
+        CXXTOOLS_UNIT_ASSERT(out.str().empty());
+    }
+};
+
+cxxtools::unit::RegisterTest<TntdbCopyOutTest> register_TntdbCopyOutTest;
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/statement.h>
+#include <tntdb/value.h>
+#include <tntdb/error.h>
+
+log_define("tntdb.unit.delay")
+
+class TntdbDelayTest : public TntdbTestBase
+{
+    unsigned count()
+    {
+        return conn.selectValue("select count(*) from tntdbtest").getUnsigned();
+    }
+
+public:
+    TntdbDelayTest()
+      : TntdbTestBase("delay")
+    {
+        registerMethod("testDelay", *this, &TntdbDelayTest::testDelay);
+        registerMethod("testAutoFlush", *this, &TntdbDelayTest::testAutoFlush);
+        registerMethod("testDestructor", *this, &TntdbDelayTest::testDestructor);
+        registerMethod("testSetMaxNumDelay", *this, &TntdbDelayTest::testSetMaxNumDelay);
+        registerMethod("testFailedBatch", *this, &TntdbDelayTest::testFailedBatch);
+    }
+
+    void testDelay()
+    {
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+        ins.maxNumDelay(3);
+
+        ins.set("intcol", 1).set("stringcol", "a").execute();
+        ins.set("intcol", 2).set("stringcol", "b").execute();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.numDelayed(), 2);
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.flush(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.numDelayed(), 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 2);
+
+        // the parameters are copied at execute
+        tntdb::Value v = conn.selectValue("select stringcol from tntdbtest where intcol = 2");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(v.getString(), "b");
+    }
+
+    void testAutoFlush()
+    {
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:intcol)");
+        ins.maxNumDelay(3);
+
+        for (int n = 0; n < 7; ++n)
+            ins.set("intcol", n).execute();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.numDelayed(), 1);
+        ins.flush();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 7);
+    }
+
+    void testDestructor()
+    {
+        {
+            tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:intcol)");
+            ins.maxNumDelay(10);
+            ins.set("intcol", 1).execute();
+            ins.set("intcol", 2).execute();
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 2);
+    }
+
+    void testSetMaxNumDelay()
+    {
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:intcol)");
+        ins.maxNumDelay(10);
+        ins.set("intcol", 1).execute();
+        ins.set("intcol", 2).execute();
+
+        // reducing the buffer below the number of pending rows flushes them
+        ins.maxNumDelay(1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.numDelayed(), 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 2);
+
+        // without delay rows are executed immediately
+        ins.maxNumDelay(0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.set("intcol", 3).execute(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 3);
+    }
+
+    void testFailedBatch()
+    {
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(id) values(:id)");
+        ins.maxNumDelay(10);
+
+        // the duplicate key is reported by execute or flush depending on
+        // the driver; the rows before it are discarded either way
+        try
+        {
+            ins.set("id", 1).execute();
+            ins.set("id", 2).execute();
+            ins.set("id", 1).execute();
+            ins.flush();
+            CXXTOOLS_UNIT_FAIL("duplicate key not detected");
+        }
+        catch (const tntdb::Error&)
+        {
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.numDelayed(), 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 0);
+
+        ins.set("id", 3).execute();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.flush(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 1);
+    }
+
+};
+
+cxxtools::unit::RegisterTest<TntdbDelayTest> register_TntdbDelayTest;
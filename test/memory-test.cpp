@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/statement.h>
+#include <tntdb/result.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/blob.h>
+#include <tntdb/transaction.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+log_define("tntdb.unit.memory")
+
+namespace
+{
+    // bytes currently allocated with operator new in this process
+    std::atomic<std::size_t> allocated(0);
+
+    // the size of each block is stored in front of it for operator delete
+    const std::size_t header = alignof(std::max_align_t);
+}
+
+// The array, nothrow and sized forms call these by default.
+void* operator new(std::size_t size)
+{
+    void* p = std::malloc(size + header);
+    if (p == 0)
+        throw std::bad_alloc();
+    *static_cast<std::size_t*>(p) = size;
+    allocated += size;
+    return static_cast<char*>(p) + header;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (ptr == 0)
+        return;
+    void* p = static_cast<char*>(ptr) - header;
+    allocated -= *static_cast<std::size_t*>(p);
+    std::free(p);
+}
+
+// Measures the memory, which a materialized result of many short values in
+// wide columns takes. A result, which allocates buffers by the declared
+// size of the columns (64k for blobcol) instead of the actual size of the
+// values, exceeds the limit. The memory held by the result is measured
+// instead of the peak memory of the process, which earlier tests may
+// have raised already.
+class TntdbMemoryTest : public TntdbTestBase
+{
+public:
+    TntdbMemoryTest()
+      : TntdbTestBase("memory")
+    {
+        registerMethod("testSelect", *this, &TntdbMemoryTest::testSelect);
+    }
+
+    void testSelect()
+    {
+        const unsigned rows = 2000;
+
+        {
+            tntdb::Transaction trans(conn);
+            tntdb::Statement ins = conn.prepare(
+                "insert into tntdbtest(intcol, stringcol, blobcol) values(:intcol, :stringcol, :blobcol)");
+            tntdb::Blob blob("blob", 4);
+            for (unsigned n = 0; n < rows; ++n)
+                ins.set("intcol", n)
+                   .set("stringcol", "value")
+                   .set("blobcol", blob)
+                   .execute();
+            trans.commit();
+        }
+
+        std::size_t before = allocated;
+
+        tntdb::Result result = conn.prepare(
+                "select intcol, stringcol, blobcol from tntdbtest where intcol >= :intcol order by intcol")
+            .set("intcol", 0)
+            .select();
+
+        std::size_t size = allocated - before;
+        log_info(rows << " rows take " << size << " bytes");
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result.size(), rows);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result.getRow(rows - 1)[0].getUnsigned(), rows - 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result.getRow(rows - 1)[1].getString(), "value");
+        CXXTOOLS_UNIT_ASSERT(size < rows * 256);
+    }
+};
+
+cxxtools::unit::RegisterTest<TntdbMemoryTest> register_TntdbMemoryTest;
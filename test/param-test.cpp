@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/statement.h>
+#include <tntdb/result.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/date.h>
+#include <tntdb/error.h>
+
+log_define("tntdb.unit.param")
+
+class TntdbParamTest : public TntdbTestBase
+{
+public:
+    TntdbParamTest()
+      : TntdbTestBase("param")
+    {
+        registerMethod("testInsert", *this, &TntdbParamTest::testInsert);
+        registerMethod("testTypes", *this, &TntdbParamTest::testTypes);
+        registerMethod("testRepeated", *this, &TntdbParamTest::testRepeated);
+        registerMethod("testNotFound", *this, &TntdbParamTest::testNotFound);
+        registerMethod("testMixed", *this, &TntdbParamTest::testMixed);
+    }
+
+    void testInsert()
+    {
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+        tntdb::Param intcol = ins.param("intcol");
+        tntdb::Param stringcol = ins.param("stringcol");
+
+        for (int n = 0; n < 10; ++n)
+            ins.set(intcol, n)
+               .set(stringcol, "row")
+               .execute();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(conn.selectValue("select count(*) from tntdbtest where stringcol = 'row'").getInt(), 10);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(conn.selectValue("select sum(intcol) from tntdbtest").getInt(), 45);
+    }
+
+    void testTypes()
+    {
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, doublecol, stringcol, datecol)"
+            " values(:intcol, :doublecol, :stringcol, :datecol)");
+        tntdb::Param intcol = ins.param("intcol");
+        tntdb::Param doublecol = ins.param("doublecol");
+        tntdb::Param stringcol = ins.param("stringcol");
+        tntdb::Param datecol = ins.param("datecol");
+
+        ins.setInt(intcol, 1)
+           .setDouble(doublecol, 1.5)
+           .setString(stringcol, "one")
+           .setDate(datecol, tntdb::Date(2020, 2, 29))
+           .execute();
+        ins.setInt(intcol, 2)
+           .setNull(doublecol)
+           .setString(stringcol, static_cast<const char*>(0))
+           .setDate(datecol, tntdb::Date())
+           .execute();
+
+        tntdb::Result r = conn.select("select intcol, doublecol, stringcol, datecol from tntdbtest order by intcol");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.size(), 2);
+
+        tntdb::Row row = r.getRow(0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row[0].getInt(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row[1].getDouble(), 1.5);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row[2].getString(), "one");
+        CXXTOOLS_UNIT_ASSERT(row[3].getDate() == tntdb::Date(2020, 2, 29));
+
+        row = r.getRow(1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row[0].getInt(), 2);
+        CXXTOOLS_UNIT_ASSERT(row[1].isNull());
+        CXXTOOLS_UNIT_ASSERT(row[2].isNull());
+        CXXTOOLS_UNIT_ASSERT(row[3].isNull());
+    }
+
+    void testRepeated()
+    {
+        conn.execute("insert into tntdbtest(intcol, longcol) values(1, 5)");
+        conn.execute("insert into tntdbtest(intcol, longcol) values(2, 2)");
+        conn.execute("insert into tntdbtest(intcol, longcol) values(3, 3)");
+
+        tntdb::Statement sel = conn.prepare(
+            "select count(*) from tntdbtest where intcol = :v and longcol = :v");
+        tntdb::Param v = sel.param("v");
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set(v, 1).selectValue().getInt(), 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set(v, 2).selectValue().getInt(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set(v, 3).selectValue().getInt(), 1);
+    }
+
+    void testNotFound()
+    {
+        tntdb::Statement sel = conn.prepare("select intcol from tntdbtest where intcol = :intcol");
+        CXXTOOLS_UNIT_ASSERT_THROW(sel.param("unknown"), tntdb::HostvarNotFound);
+    }
+
+    void testMixed()
+    {
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+        tntdb::Param intcol = ins.param("intcol");
+
+        ins.set(intcol, 7).set("stringcol", "seven").execute();
+        ins.set("intcol", 8).set(intcol, 9).set("stringcol", "nine").execute();
+
+        tntdb::Result r = conn.select("select intcol, stringcol from tntdbtest order by intcol");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.size(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.getRow(0)[0].getInt(), 7);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.getRow(0)[1].getString(), "seven");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.getRow(1)[0].getInt(), 9);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.getRow(1)[1].getString(), "nine");
+    }
+};
+
+cxxtools::unit::RegisterTest<TntdbParamTest> register_TntdbParamTest;
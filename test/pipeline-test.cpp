@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/statement.h>
+#include <tntdb/transaction.h>
+#include <tntdb/value.h>
+#include <tntdb/error.h>
+
+log_define("tntdb.unit.pipeline")
+
+class TntdbPipelineTest : public TntdbTestBase
+{
+    unsigned count()
+    {
+        return conn.selectValue("select count(*) from tntdbtest").getUnsigned();
+    }
+
+public:
+    TntdbPipelineTest()
+      : TntdbTestBase("pipeline")
+    {
+        registerMethod("testPipeline", *this, &TntdbPipelineTest::testPipeline);
+        registerMethod("testTransaction", *this, &TntdbPipelineTest::testTransaction);
+        registerMethod("testSelect", *this, &TntdbPipelineTest::testSelect);
+        registerMethod("testError", *this, &TntdbPipelineTest::testError);
+    }
+
+    void testPipeline()
+    {
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:intcol)");
+
+        conn.beginPipeline();
+        for (int n = 0; n < 5; ++n)
+            ins.set("intcol", n).execute();
+        conn.syncPipeline();
+        conn.endPipeline();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 5);
+    }
+
+    void testTransaction()
+    {
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:intcol)");
+
+        conn.beginPipeline();
+
+        tntdb::Transaction trans(conn);
+        ins.set("intcol", 1).execute();
+        ins.set("intcol", 2).execute();
+        trans.commit();
+
+        conn.endPipeline();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 2);
+    }
+
+    void testSelect()
+    {
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:intcol)");
+
+        conn.beginPipeline();
+        ins.set("intcol", 1).execute();
+        ins.set("intcol", 2).execute();
+
+        // a select syncs the pipeline and sees the queued statements
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 2);
+
+        conn.endPipeline();
+    }
+
+    void testError()
+    {
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:intcol)");
+
+        conn.beginPipeline();
+        ins.set("intcol", 1).execute();
+        conn.syncPipeline();
+
+        // the error surfaces either at execution or at the sync point
+        CXXTOOLS_UNIT_ASSERT_THROW(
+            {
+                conn.execute("insert into tntdbtest_nonexisting(intcol) values(1)");
+                conn.syncPipeline();
+            }, tntdb::Error);
+
+        conn.endPipeline();
+
+        // the statement synced before the failed one was executed
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count(), 1);
+    }
+
+};
+
+cxxtools::unit::RegisterTest<TntdbPipelineTest> register_TntdbPipelineTest;
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/pscconnection.h>
+#include <tntdb/connectionpool.h>
+#include <tntdb/result.h>
+#include <tntdb/value.h>
+
+log_define("tntdb.unit.pscconnection")
+
+class TntdbPscConnectionTest : public TntdbTestBase
+{
+public:
+    TntdbPscConnectionTest()
+      : TntdbTestBase("pscconnection")
+    {
+        registerMethod("testCacheHit", *this, &TntdbPscConnectionTest::testCacheHit);
+        registerMethod("testEviction", *this, &TntdbPscConnectionTest::testEviction);
+        registerMethod("testMaxSize", *this, &TntdbPscConnectionTest::testMaxSize);
+        registerMethod("testPooled", *this, &TntdbPscConnectionTest::testPooled);
+        registerMethod("testPooledReset", *this, &TntdbPscConnectionTest::testPooledReset);
+    }
+
+    void testCacheHit()
+    {
+        tntdb::PSCConnection pconn(conn);
+
+        tntdb::Statement s1 = pconn.prepare("select count(*) from tntdbtest");
+        tntdb::Statement s2 = pconn.prepare("select count(*) from tntdbtest");
+
+        CXXTOOLS_UNIT_ASSERT(s1.getImpl() == s2.getImpl());
+
+        const tntdb::StatementCache::Statistics& st = pconn.getStatementCache().getStatistics();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(st.hits, 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(st.misses, 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(st.evictions, 0);
+    }
+
+    void testEviction()
+    {
+        tntdb::PSCConnection pconn(conn, 2);
+
+        const tntdb::IStatement* s1 = pconn.prepare("select 1 from tntdbtest").getImpl();
+        pconn.prepare("select 2 from tntdbtest");
+        pconn.prepare("select 1 from tntdbtest");  // makes "select 1" most recently used
+        pconn.prepare("select 3 from tntdbtest");  // evicts "select 2"
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pconn.getStatementCache().size(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pconn.getStatementCache().getStatistics().evictions, 1);
+
+        CXXTOOLS_UNIT_ASSERT(pconn.prepare("select 1 from tntdbtest").getImpl() == s1);
+
+        // the evicted statement is prepared again and works
+        tntdb::Statement s2 = pconn.prepare("select 2 from tntdbtest");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pconn.getStatementCache().getStatistics().misses, 4);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(s2.select().size(), 0);
+    }
+
+    void testMaxSize()
+    {
+        tntdb::PSCConnection pconn(conn, 0);
+
+        for (unsigned n = 0; n < 10; ++n)
+            pconn.prepare("select " + std::string(n + 1, '1') + " from tntdbtest");
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pconn.getStatementCache().size(), 10);
+
+        pconn.getStatementCache().setMaxSize(3);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pconn.getStatementCache().size(), 3);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pconn.getStatementCache().getStatistics().evictions, 7);
+    }
+
+    void testPooled()
+    {
+        tntdb::ConnectionPool pool(dburl(), dbuser(), dbpassword(), 0, 1);
+        const tntdb::IStatement* s1;
+
+        {
+            tntdb::PSCConnection pconn(pool.connect());
+            s1 = pconn.prepare("select count(*) from tntdbtest").getImpl();
+        }
+
+        // the connection is returned to the pool together with its cache
+        tntdb::PSCConnection pconn(pool.connect());
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 0);
+
+        tntdb::Statement s2 = pconn.prepare("select count(*) from tntdbtest");
+        CXXTOOLS_UNIT_ASSERT(s2.getImpl() == s1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(s2.selectValue().getInt(), 0);
+
+        const tntdb::StatementCache::Statistics& st = pconn.getStatementCache().getStatistics();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(st.hits, 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(st.misses, 1);
+    }
+
+    void testPooledReset()
+    {
+        tntdb::ConnectionPool pool(dburl(), dbuser(), dbpassword(), 0, 1);
+        const std::string query = "insert into tntdbtest(intcol) values(:intcol)";
+
+        {
+            tntdb::PSCConnection pconn(pool.connect(), 5);
+            tntdb::Statement ins = pconn.prepare(query);
+            ins.maxNumDelay(10);
+            ins.setStreaming();
+            for (int n = 0; n < 3; ++n)
+                ins.set("intcol", n).execute();
+        }
+
+        // the delayed rows are flushed, when the connection is returned
+        CXXTOOLS_UNIT_ASSERT_EQUALS(conn.selectValue("select count(*) from tntdbtest").getInt(), 3);
+
+        // the next user gets the statement without the settings of the
+        // previous one and the limits of the cache are kept
+        tntdb::PSCConnection pconn(pool.connect(), 50);
+        tntdb::Statement ins = pconn.prepare(query);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pconn.getStatementCache().getStatistics().hits, 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pconn.getStatementCache().getMaxSize(), 5);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(ins.numDelayed(), 0);
+        CXXTOOLS_UNIT_ASSERT(!ins.isStreaming());
+
+        ins.set("intcol", 3).execute();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(conn.selectValue("select count(*) from tntdbtest").getInt(), 4);
+    }
+};
+
+cxxtools::unit::RegisterTest<TntdbPscConnectionTest> register_TntdbPscConnectionTest;
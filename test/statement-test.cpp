@@ -90,6 +90,7 @@ public:
         registerMethod("testSetValue", *this, &StatementTest::testSetValue);
         registerMethod("testClear", *this, &StatementTest::testClear);
         registerMethod("testSetTimespan", *this, &StatementTest::testSetTimespan);
+        registerMethod("testParamByName", *this, &StatementTest::testParamByName);
     }
 
     void testSetValue()
@@ -173,6 +174,30 @@ public:
         CXXTOOLS_UNIT_ASSERT_EQUALS(testStmt->value("d"), "22");
     }
 
+    void testParamByName()
+    {
+        // TestStmt does not resolve parameters, so the names are used
+        std::shared_ptr<TestStmt> testStmt = std::make_shared<TestStmt>();
+        tntdb::Statement stmt(testStmt);
+        tntdb::Param i = stmt.param("int");
+        tntdb::Param s = stmt.param("string");
+        tntdb::Param d = stmt.param("date");
+
+        CXXTOOLS_UNIT_ASSERT(!i.isResolved());
+
+        stmt.set(i, 42)
+            .set(s, "Hi there")
+            .set(d, tntdb::Date(2018, 5, 3));
+        CXXTOOLS_UNIT_ASSERT_EQUALS(testStmt->value("int"), "42");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(testStmt->value("string"), "Hi there");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(testStmt->value("date"), "2018-05-03");
+
+        stmt.setNull(i)
+            .set(d, tntdb::Date());
+        CXXTOOLS_UNIT_ASSERT(testStmt->isNull("int"));
+        CXXTOOLS_UNIT_ASSERT(testStmt->isNull("date"));
+    }
+
 };
 
 cxxtools::unit::RegisterTest<StatementTest> register_StatementTest;
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/statement.h>
+#include <tntdb/result.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/error.h>
+
+log_define("tntdb.unit.stream")
+
+class TntdbStreamTest : public TntdbTestBase
+{
+    void insertRows(unsigned count)
+    {
+        tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+        for (unsigned n = 0; n < count; ++n)
+            ins.set("intcol", n)
+               .set("stringcol", std::string(n + 1, 'a'))
+               .execute();
+    }
+
+public:
+    TntdbStreamTest()
+      : TntdbTestBase("stream")
+    {
+        registerMethod("testIterate", *this, &TntdbStreamTest::testIterate);
+        registerMethod("testRandomAccess", *this, &TntdbStreamTest::testRandomAccess);
+        registerMethod("testEmpty", *this, &TntdbStreamTest::testEmpty);
+        registerMethod("testReuse", *this, &TntdbStreamTest::testReuse);
+        registerMethod("testFetchSize", *this, &TntdbStreamTest::testFetchSize);
+        registerMethod("testCursor", *this, &TntdbStreamTest::testCursor);
+        registerMethod("testCursorBreak", *this, &TntdbStreamTest::testCursorBreak);
+        registerMethod("testCursorSingleRow", *this, &TntdbStreamTest::testCursorSingleRow);
+        registerMethod("testCursorChunks", *this, &TntdbStreamTest::testCursorChunks);
+    }
+
+    void testIterate()
+    {
+        insertRows(10);
+
+        tntdb::Statement sel = conn.prepare("select intcol, stringcol from tntdbtest order by intcol");
+        sel.setStreaming();
+
+        tntdb::Result result = sel.select();
+
+        int count = 0;
+        for (tntdb::Result::const_iterator it = result.begin(); it != result.end(); ++it)
+        {
+            tntdb::Row row = *it;
+            CXXTOOLS_UNIT_ASSERT_EQUALS(row[0].getInt(), count);
+            CXXTOOLS_UNIT_ASSERT_EQUALS(row["stringcol"].getString(), std::string(count + 1, 'a'));
+            ++count;
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count, 10);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result.size(), 10);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result.getFieldCount(), 2);
+    }
+
+    void testRandomAccess()
+    {
+        insertRows(10);
+
+        tntdb::Statement sel = conn.prepare("select intcol from tntdbtest order by intcol");
+        sel.setStreaming();
+
+        tntdb::Result result = sel.select();
+
+        tntdb::Row r7 = result.getRow(7);
+        tntdb::Row r2 = result.getRow(2);
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r7[0].getInt(), 7);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r2[0].getInt(), 2);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r7[0].getInt(), 7);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(result.getValue(9, 0).getInt(), 9);
+    }
+
+    void testEmpty()
+    {
+        tntdb::Statement sel = conn.prepare("select intcol from tntdbtest");
+        sel.setStreaming();
+
+        tntdb::Result result = sel.select();
+        CXXTOOLS_UNIT_ASSERT(result.empty());
+        CXXTOOLS_UNIT_ASSERT(result.begin() == result.end());
+    }
+
+    void testReuse()
+    {
+        insertRows(3);
+
+        tntdb::Statement sel = conn.prepare("select intcol from tntdbtest where intcol >= :intcol order by intcol");
+        sel.setStreaming();
+
+        // postgresql streams cursors only
+        if (!sel.isStreaming() || dburl().compare(0, 11, "postgresql:") == 0)
+            return;
+
+        tntdb::Result r1 = sel.set("intcol", 1).select();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r1.getValue(0, 0).getInt(), 1);
+
+        // executing the statement again invalidates the previous result
+        tntdb::Result r2 = sel.set("intcol", 2).select();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r2.getValue(0, 0).getInt(), 2);
+        CXXTOOLS_UNIT_ASSERT_THROW(r1.getValue(1, 0), tntdb::Error);
+    }
+
+    void testFetchSize()
+    {
+        insertRows(10);
+
+        tntdb::Statement sel = conn.prepare("select intcol from tntdbtest where intcol >= :intcol order by intcol");
+        sel.setStreaming();
+        sel.setFetchSize(3);
+
+        // drivers without fetch size ignore the setting
+        CXXTOOLS_UNIT_ASSERT(sel.getFetchSize() == 3 || sel.getFetchSize() == 0);
+
+        tntdb::Result result = sel.set("intcol", 2).select();
+
+        int count = 0;
+        for (tntdb::Result::const_iterator it = result.begin(); it != result.end(); ++it)
+        {
+            CXXTOOLS_UNIT_ASSERT_EQUALS((*it)[0].getInt(), count + 2);
+            ++count;
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count, 8);
+    }
+
+    void testCursor()
+    {
+        insertRows(250);
+
+        tntdb::Statement sel = conn.prepare("select intcol, stringcol from tntdbtest order by intcol");
+        sel.setStreaming();
+
+        int count = 0;
+        for (tntdb::Statement::const_iterator it = sel.begin(100); it != sel.end(); ++it)
+        {
+            CXXTOOLS_UNIT_ASSERT_EQUALS((*it)[0].getInt(), count);
+            ++count;
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count, 250);
+    }
+
+    void testCursorBreak()
+    {
+        insertRows(10);
+
+        tntdb::Statement sel = conn.prepare("select intcol from tntdbtest order by intcol");
+        sel.setStreaming();
+
+        {
+            tntdb::Statement::const_iterator it = sel.begin();
+            CXXTOOLS_UNIT_ASSERT_EQUALS((*it)[0].getInt(), 0);
+        }
+
+        // the connection is usable, after the cursor is released
+        CXXTOOLS_UNIT_ASSERT_EQUALS(conn.selectValue("select count(*) from tntdbtest").getInt(), 10);
+    }
+
+    // postgresql reads the rows in single row mode with fetch size 1 and
+    // in chunks of fetch size rows otherwise
+    void iterateCursor(unsigned fetchsize)
+    {
+        insertRows(10);
+
+        tntdb::Statement sel = conn.prepare("select intcol from tntdbtest order by intcol");
+        sel.setStreaming();
+
+        int count = 0;
+        for (tntdb::Statement::const_iterator it = sel.begin(fetchsize); it != sel.end(); ++it)
+        {
+            CXXTOOLS_UNIT_ASSERT_EQUALS((*it)[0].getInt(), count);
+            ++count;
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count, 10);
+    }
+
+    void testCursorSingleRow()
+    {
+        iterateCursor(1);
+    }
+
+    void testCursorChunks()
+    {
+        iterateCursor(4);
+    }
+};
+
+cxxtools::unit::RegisterTest<TntdbStreamTest> register_TntdbStreamTest;
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/statement.h>
+#include <tntdb/result.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/blob.h>
+
+log_define("tntdb.unit.stringref")
+
+class TntdbStringRefTest : public TntdbTestBase
+{
+    std::string selectString(int id)
+    {
+        return conn.prepare("select stringcol from tntdbtest where intcol = :id")
+                   .set("id", id)
+                   .selectValue()
+                   .getString();
+    }
+
+public:
+    TntdbStringRefTest()
+      : TntdbTestBase("stringref")
+    {
+        registerMethod("testStringRef", *this, &TntdbStringRefTest::testStringRef);
+        registerMethod("testBlobRef", *this, &TntdbStringRefTest::testBlobRef);
+        registerMethod("testTakeString", *this, &TntdbStringRefTest::testTakeString);
+        registerMethod("testTakeShortStrings", *this, &TntdbStringRefTest::testTakeShortStrings);
+        registerMethod("testParam", *this, &TntdbStringRefTest::testParam);
+        registerMethod("testDelayed", *this, &TntdbStringRefTest::testDelayed);
+    }
+
+    void testStringRef()
+    {
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+
+        std::string buffer = "first";
+        ins.set("intcol", 1).setStringRef("stringcol", buffer).execute();
+
+        buffer = "second";
+        ins.set("intcol", 2).setStringRef("stringcol", buffer).execute();
+
+        const char data[] = "third value";
+        ins.set("intcol", 3).setStringRef("stringcol", data, 5).execute();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selectString(1), "first");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selectString(2), "second");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selectString(3), "third");
+    }
+
+    void testBlobRef()
+    {
+        static const char blobdata[] = "a\0b\\c\td\ne";
+        tntdb::Blob blob(blobdata, sizeof(blobdata) - 1);
+
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, blobcol) values(:intcol, :blobcol)");
+        ins.set("intcol", 1).setBlobRef("blobcol", blob).execute();
+        ins.set("intcol", 2).setBlobRef("blobcol", blobdata, 3).execute();
+
+        tntdb::Result r = conn.select("select blobcol from tntdbtest order by intcol");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.size(), 2);
+        CXXTOOLS_UNIT_ASSERT(r.getRow(0)[0].getBlob() == blob);
+        CXXTOOLS_UNIT_ASSERT(r.getRow(1)[0].getBlob() == tntdb::Blob(blobdata, 3));
+    }
+
+    void testTakeString()
+    {
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+
+        std::string value(1000, 'x');
+        ins.set("intcol", 1).set("stringcol", std::move(value)).execute();
+        ins.set("intcol", 2).setString("stringcol", std::string("moved")).execute();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selectString(1), std::string(1000, 'x'));
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selectString(2), "moved");
+    }
+
+    void testTakeShortStrings()
+    {
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+        ins.set("intcol", 1).set("stringcol", "a").execute();
+        ins.set("intcol", 2).set("stringcol", "b").execute();
+
+        // short strings are stored inside the string object, so taking the
+        // second one must not move the first
+        tntdb::Statement sel = conn.prepare(
+            "select count(*) from tntdbtest where stringcol = :a or stringcol = :b");
+        std::string a = "a";
+        std::string b = "b";
+        sel.set("a", std::move(a)).set("b", std::move(b));
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(sel.selectValue().getInt(), 2);
+    }
+
+    void testParam()
+    {
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+        tntdb::Param intcol = ins.param("intcol");
+        tntdb::Param stringcol = ins.param("stringcol");
+
+        std::string buffer = "ref";
+        ins.set(intcol, 1).setStringRef(stringcol, buffer).execute();
+        ins.set(intcol, 2).set(stringcol, std::string("taken")).execute();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selectString(1), "ref");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selectString(2), "taken");
+    }
+
+    void testDelayed()
+    {
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+        ins.maxNumDelay(10);
+
+        // the delayed rows must not depend on the buffer after the
+        // host variable is set again
+        std::string buffer1 = "one";
+        std::string buffer2 = "two";
+        ins.set("intcol", 1).setStringRef("stringcol", buffer1).execute();
+        ins.set("intcol", 2).setStringRef("stringcol", buffer2).execute();
+        buffer1 = "changed";
+        ins.flush();
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selectString(1), "one");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(selectString(2), "two");
+    }
+};
+
+cxxtools::unit::RegisterTest<TntdbStringRefTest> register_TntdbStringRefTest;
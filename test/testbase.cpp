@@ -8,20 +8,11 @@ void TntdbTestBase::setUp()
 {
     if (!conn)
     {
-        const char* dburl = getenv("TNTDBURL");
-        if (!dburl)
-          dburl = "sqlite:test.db";
+        std::string url = dburl();
 
-        const char* user = getenv("TNTDBUSER");
-        const char* password = getenv("TNTDBPASSWORD");
-        if (!user)
-            user = "";
-        if (!password)
-            password = "";
+        log_info("testing with dburl=" << url);
 
-        log_info("testing with dburl=" << dburl);
-
-        conn = tntdb::connect(dburl, user, password);
+        conn = tntdb::connect(url, dbuser(), dbpassword());
 
         del = conn.prepare("delete from tntdbtest");
         del.execute();
@@ -32,3 +23,21 @@ void TntdbTestBase::tearDown()
 {
     del.execute();
 }
+
+std::string TntdbTestBase::dburl()
+{
+    const char* dburl = getenv("TNTDBURL");
+    return dburl ? dburl : "sqlite:test.db";
+}
+
+std::string TntdbTestBase::dbuser()
+{
+    const char* user = getenv("TNTDBUSER");
+    return user ? user : "";
+}
+
+std::string TntdbTestBase::dbpassword()
+{
+    const char* password = getenv("TNTDBPASSWORD");
+    return password ? password : "";
+}
@@ -19,6 +19,12 @@ public:
 
     void setUp();
     void tearDown();
+
+    /// Return the database url and credentials to test with
+    /// (environment variables TNTDBURL, TNTDBUSER and TNTDBPASSWORD)
+    static std::string dburl();
+    static std::string dbuser();
+    static std::string dbpassword();
 };
 
 #endif
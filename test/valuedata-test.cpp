@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Tommi Maekitalo
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "testbase.h"
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <tntdb/statement.h>
+#include <tntdb/result.h>
+#include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/blob.h>
+#include <tntdb/error.h>
+
+log_define("tntdb.unit.valuedata")
+
+class TntdbValueDataTest : public TntdbTestBase
+{
+    static std::string stringData(const tntdb::Value& value)
+    {
+        std::size_t length;
+        const char* data = value.getStringData(length);
+        return std::string(data, length);
+    }
+
+    void insertRows()
+    {
+        static const char blobdata[] = "a\0b\\c\td\ne";
+        tntdb::Blob blob(blobdata, sizeof(blobdata) - 1);
+
+        tntdb::Statement ins = conn.prepare(
+            "insert into tntdbtest(intcol, stringcol, blobcol) values(:intcol, :stringcol, :blobcol)");
+        ins.set("intcol", 1).set("stringcol", "first").set("blobcol", blob).execute();
+        ins.set("intcol", 2).set("stringcol", "").setNull("blobcol").execute();
+        ins.set("intcol", 3).setNull("stringcol").setNull("blobcol").execute();
+    }
+
+public:
+    TntdbValueDataTest()
+      : TntdbTestBase("valuedata")
+    {
+        registerMethod("testResult", *this, &TntdbValueDataTest::testResult);
+        registerMethod("testCursor", *this, &TntdbValueDataTest::testCursor);
+        registerMethod("testNull", *this, &TntdbValueDataTest::testNull);
+        registerMethod("testBlob", *this, &TntdbValueDataTest::testBlob);
+    }
+
+    void testResult()
+    {
+        insertRows();
+
+        tntdb::Result r = conn.select("select stringcol from tntdbtest order by intcol");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.size(), 3);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(stringData(r.getRow(0)[0]), "first");
+
+#if __cplusplus >= 201703L
+        CXXTOOLS_UNIT_ASSERT(r.getRow(0)[0].getStringView() == "first");
+#endif
+    }
+
+    void testCursor()
+    {
+        insertRows();
+
+        tntdb::Statement sel = conn.prepare("select intcol, stringcol from tntdbtest where intcol < 3 order by intcol");
+
+        unsigned count = 0;
+        for (tntdb::Statement::const_iterator cur = sel.begin(); cur != sel.end(); ++cur, ++count)
+        {
+            tntdb::Row row = *cur;
+            if (row[0].getInt() == 1)
+                CXXTOOLS_UNIT_ASSERT_EQUALS(stringData(row[1]), "first");
+            else
+                CXXTOOLS_UNIT_ASSERT_EQUALS(stringData(row[1]), "");
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(count, 2);
+    }
+
+    void testNull()
+    {
+        insertRows();
+
+        std::size_t length;
+        tntdb::Value v = conn.selectValue("select stringcol from tntdbtest where intcol = 3");
+        CXXTOOLS_UNIT_ASSERT_THROW(v.getStringData(length), tntdb::NullValue);
+        CXXTOOLS_UNIT_ASSERT_THROW(v.getBlobData(length), tntdb::NullValue);
+    }
+
+    void testBlob()
+    {
+        insertRows();
+
+        tntdb::Blob blob;
+        tntdb::Value v = conn.selectValue("select blobcol from tntdbtest where intcol = 1");
+        v.getBlob(blob);
+
+        std::size_t length;
+        const char* data = v.getBlobData(length);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(length, blob.size());
+        CXXTOOLS_UNIT_ASSERT(tntdb::Blob(data, length) == blob);
+    }
+};
+
+cxxtools::unit::RegisterTest<TntdbValueDataTest> register_TntdbValueDataTest;